@@ -40,6 +40,22 @@ function(Evie_setup_dependencies)
     cpmaddpackage("gh:doctest/doctest@2.4.11")
   endif()
 
+  if(Evie_BUILD_BENCHMARKS AND NOT TARGET benchmark::benchmark)
+    cpmaddpackage(
+      NAME
+      benchmark
+      GIT_TAG
+      v1.8.3
+      GITHUB_REPOSITORY
+      "google/benchmark"
+      OPTIONS
+      "BENCHMARK_ENABLE_TESTING OFF"
+      "BENCHMARK_ENABLE_GTEST_TESTS OFF"
+      "BENCHMARK_ENABLE_INSTALL OFF"
+      "BENCHMARK_ENABLE_WERROR OFF"
+      SYSTEM)
+  endif()
+
   if(NOT TARGET glfw)
     cpmaddpackage(
       NAME
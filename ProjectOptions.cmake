@@ -21,6 +21,7 @@ endmacro()
 macro(Evie_setup_options)
   option(Evie_ENABLE_HARDENING "Enable hardening" ON)
   option(Evie_ENABLE_COVERAGE "Enable coverage reporting" ON)
+  option(Evie_ENABLE_PROFILING "Compile in EV_PROFILE_SCOPE profiler zones" ON)
   cmake_dependent_option(
     Evie_ENABLE_GLOBAL_HARDENING
     "Attempt to push hardening options to built dependencies"
@@ -87,6 +88,7 @@ macro(Evie_setup_options)
   endif()
 
   option(Evie_BUILD_FUZZ_TESTS "Enable fuzz testing executable" ${DEFAULT_FUZZER})
+  option(Evie_BUILD_BENCHMARKS "Build the Google Benchmark microbenchmarks" OFF)
 
 endmacro()
 
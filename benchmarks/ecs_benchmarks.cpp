@@ -0,0 +1,222 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "evie/ecs/ecs_controller.hpp"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+namespace {
+struct Position
+{
+  float x{ 0.0F };
+  float y{ 0.0F };
+  float z{ 0.0F };
+};
+
+struct Velocity
+{
+  float x{ 1.0F };
+  float y{ 1.0F };
+  float z{ 1.0F };
+};
+
+struct BenchmarkSystem : public System
+{
+  void Update(const float& delta_time) override { std::ignore = delta_time; }
+};
+
+// An ECS with a moving system and count entities that it tracks.
+struct World
+{
+  explicit World(int64_t count)
+  {
+    position = ecs.RegisterComponent<Position>();
+    velocity = ecs.RegisterComponent<Velocity>();
+    SystemSignature signature;
+    signature.SetComponent(position);
+    signature.SetComponent(velocity);
+    system = &ecs.GetSystem(ecs.RegisterSystem<BenchmarkSystem>(signature));
+    for (int64_t i = 0; i < count; ++i) {
+      auto entity = ecs.CreateEntity();
+      if (entity.Bad() || entity->AddComponent(position).Bad() || entity->AddComponent(velocity).Bad()) {
+        valid = false;
+        return;
+      }
+    }
+  }
+
+  ECSController ecs;
+  ComponentID<Position> position{ 0 };
+  ComponentID<Velocity> velocity{ 0 };
+  BenchmarkSystem* system{ nullptr };
+  bool valid{ true };
+};
+
+// 1k, 10k and 100k entities. MAX_ENTITY_COUNT is the most the ECS can hold.
+void EntityCounts(benchmark::internal::Benchmark* benchmark)
+{
+  benchmark->RangeMultiplier(10)->Range(1'000, MAX_ENTITY_COUNT);
+}
+}// namespace
+
+static void BM_CreateDestroyEntity(benchmark::State& state)
+{
+  World world(0);
+  for (auto _ : state) {
+    auto entity = world.ecs.CreateEntity();
+    if (entity.Bad()) {
+      state.SkipWithError("Couldn't create an entity");
+      break;
+    }
+    entity->Destroy();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CreateDestroyEntity);
+
+// Filling the ECS up and emptying it again, entity ids come from the free list after the first iteration.
+static void BM_CreateDestroyEntities(benchmark::State& state)
+{
+  World world(0);
+  std::vector<Entity> entities;
+  entities.reserve(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      auto entity = world.ecs.CreateEntity();
+      if (entity.Bad()) {
+        state.SkipWithError("Couldn't create an entity");
+        return;
+      }
+      entities.push_back(*entity);
+    }
+    for (const Entity& entity : entities) {
+      entity.Destroy();
+    }
+    entities.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CreateDestroyEntities)->Apply(EntityCounts);
+
+// Each add and remove also updates the systems through EntitySignatureChanged.
+static void BM_AddRemoveComponent(benchmark::State& state)
+{
+  World world(0);
+  auto entity = world.ecs.CreateEntity();
+  if (entity.Bad() || entity->AddComponent(world.velocity).Bad()) {
+    state.SkipWithError("Couldn't create an entity");
+    return;
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(entity->AddComponent(world.position, Position{ 1.0F, 2.0F, 3.0F }));
+    benchmark::DoNotOptimize(entity->RemoveComponent(world.position));
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_AddRemoveComponent);
+
+// One signature change against state.range(0) systems. The entity flips between matching half of the systems and
+// matching all of them, so every call moves it in or out of some entity sets.
+static void BM_EntitySignatureChanged(benchmark::State& state)
+{
+  ComponentManager component_manager;
+  EntityManager entity_manager;
+  SystemManager system_manager(&component_manager, &entity_manager);
+  const auto position = component_manager.RegisterComponent<Position>();
+  const auto velocity = component_manager.RegisterComponent<Velocity>();
+
+  SystemSignature position_only;
+  position_only.SetComponent(position);
+  SystemSignature moving = position_only;
+  moving.SetComponent(velocity);
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    std::ignore = system_manager.RegisterSystem<BenchmarkSystem>(i % 2 == 0 ? position_only : moving);
+  }
+  auto entity = entity_manager.CreateEntity();
+  if (entity.Bad()) {
+    state.SkipWithError("Couldn't create an entity");
+    return;
+  }
+
+  bool all = false;
+  for (auto _ : state) {
+    system_manager.EntitySignatureChanged(*entity, all ? moving : position_only);
+    all = !all;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["systems"] = static_cast<double>(state.range(0));
+}
+BENCHMARK(BM_EntitySignatureChanged)->RangeMultiplier(4)->Range(1, 64);
+
+// Walking a system's entities and looking up each entity's components.
+static void BM_IterateSystemEntities(benchmark::State& state)
+{
+  World world(state.range(0));
+  if (!world.valid) {
+    state.SkipWithError("Couldn't create the entities");
+    return;
+  }
+  for (auto _ : state) {
+    for (const Entity& entity : world.system->entities) {
+      auto& position = entity.GetComponent(world.position);
+      const auto& velocity = entity.GetComponent(world.velocity);
+      position.x += velocity.x;
+      position.y += velocity.y;
+      position.z += velocity.z;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IterateSystemEntities)->Apply(EntityCounts);
+
+// Walking the packed component storage directly, the best case for cache use.
+static void BM_IterateComponentVector(benchmark::State& state)
+{
+  World world(state.range(0));
+  if (!world.valid) {
+    state.SkipWithError("Couldn't create the entities");
+    return;
+  }
+  auto& positions = world.system->GetComponentVector(world.position);
+  for (auto _ : state) {
+    // The first slot is reserved and not an entity's.
+    for (size_t i = 1; i < positions.size(); ++i) {
+      Position& position = positions[i].component;
+      position.x += 1.0F;
+      position.y += 1.0F;
+      position.z += 1.0F;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IterateComponentVector)->Apply(EntityCounts);
+
+// The signature check EntitySignatureChanged does for every system and entity set.
+static void BM_SignatureMatch(benchmark::State& state)
+{
+  ComponentManager component_manager;
+  const auto position = component_manager.RegisterComponent<Position>();
+  const auto velocity = component_manager.RegisterComponent<Velocity>();
+  SystemSignature system_signature;
+  system_signature.SetComponent(position);
+  SystemSignature entity_signature = system_signature;
+  entity_signature.SetComponent(velocity);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(system_signature);
+    benchmark::DoNotOptimize(entity_signature);
+    bool matches = (system_signature & entity_signature) == system_signature;
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SignatureMatch);
+
+// NOLINTEND
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "components.hpp"
+#include "textured_mesh.hpp"
 
 #include <evie/default_models.h>
 #include <evie/ecs/components/mesh_component.hpp>
@@ -17,6 +18,7 @@
 #include <evie/ecs/ecs_controller.hpp>
 #include <evie/ecs/system.hpp>
 #include <evie/ids.h>
+#include <evie/resource_manager.h>
 #include <evie/shader.h>
 #include <evie/shader_program.h>
 #include <evie/texture.h>
@@ -48,23 +50,21 @@ public:
 
   static constexpr int score_to_win{ 15 };
 
-  evie::Error Initialise()
+  evie::Error Initialise(evie::ResourceManager& resources)
   {
-    evie::Error err = evie::Error::OK();
-    if (err.Good()) {
-      err = vs_.Initialise(R"(C:\Users\willa\devel\Evie\shaders\vertex_shader.vs)");
-    }
-    if (err.Good()) {
-      err = fs_.Initialise(R"(C:\Users\willa\devel\Evie\shaders\fragment_shader.fs)");
-    }
-    // DanDan texture
-    if (err.Good()) {
-      err = tex_.Initialise(
-        R"(C:\Users\willa\devel\Evie\out\install\windows-msvc-debug-developer-mode\assets\textures\dandan.png)", true);
-    }
-    if (err.Good()) {
-      err = shader_program_.Initialise(&vs_, &fs_);
-    }
+    // Every DanDan shares the same cube so they can all be drawn with one instanced draw call. Spawning one only copies
+    // handles to these resources.
+    TexturedMeshDesc desc;
+    desc.mesh_key = "default_models::cube_texture_up_right";
+    desc.vertices = &evie::default_models::cube_texture_up_right;
+    desc.vertex_shader = R"(C:\Users\willa\devel\Evie\shaders\instanced_texture_array_vertex_shader.vs)";
+    desc.fragment_shader = R"(C:\Users\willa\devel\Evie\shaders\texture_array_fragment_shader.fs)";
+    desc.texture =
+      R"(C:\Users\willa\devel\Evie\out\install\windows-msvc-debug-developer-mode\assets\textures\dandan.png)";
+    desc.texture_array = true;
+    desc.flip_texture = true;
+    evie::Error err = LoadTexturedMesh(resources, desc, mesh_);
+    mesh_.instanced = true;
 
     evie::SystemSignature proj_signature;
     proj_signature.SetComponent(projectile_cid_);
@@ -194,29 +194,9 @@ private:
   evie::Error CreateDanDan(const evie::TransformComponent& transform, bool enemy = true, float speed = 0.0F)
   {
     evie::Error err = evie::Error::OK();
-    evie::MeshComponent mesh_component;
-    // We need to create the layout for our model/vertex data
-    evie::BufferLayout layout;
-    layout.stride = 5;// NOLINT
-    layout.type = evie::VertexDataType::Float;
-    layout.layout_sizes = { 3, 2 };
-    if (err.Good()) {
-      // Initialise the vertex buffer
-      err = mesh_component.model_data.Initialise(evie::default_models::cube_texture_up_right, layout);
-    }
-    if (err.Good()) {
-      // Associate the vertex buffer with the vertex array
-      mesh_component.vertex_array.Initialise();
-      err = mesh_component.vertex_array.AssociateVertexBuffer(mesh_component.model_data);
-    }
-    mesh_component.shader_program = shader_program_;
-    mesh_component.shader_program.Use();
-    mesh_component.shader_program.SetInt("Texture1", 0);
-    mesh_component.texture = tex_;
-
     auto dandan = ecs_->CreateEntity();
     if (dandan && err.Good()) {
-      err = dandan->AddComponent(mesh_cid_, mesh_component);
+      err = dandan->AddComponent(mesh_cid_, mesh_);
       if (err.Good()) {
         err = dandan->AddComponent(transform_cid_, transform);
         if (err.Good() && enemy) {
@@ -239,10 +219,7 @@ private:
     return err;
   }
 
-  evie::VertexShader vs_;
-  evie::FragmentShader fs_;
-  evie::Texture2D tex_;
-  evie::ShaderProgram shader_program_;
+  evie::MeshComponent mesh_;
   evie::ComponentID<EnemyComponent> enemy_cid_{ 0 };
   evie::ComponentID<evie::MeshComponent> mesh_cid_{ 0 };
   evie::ComponentID<evie::TransformComponent> transform_cid_{ 0 };
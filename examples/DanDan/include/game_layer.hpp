@@ -10,14 +10,18 @@
 #include "rendering/model.hpp"
 
 #include <evie/camera.h>
+#include <evie/command_list.h>
 #include <evie/ecs/components/mesh_component.hpp>
 #include <evie/ecs/components/velocity.hpp>
 #include <evie/ecs/ecs_controller.hpp>
 #include <evie/ecs/entity.hpp>
 #include <evie/error.h>
+#include <evie/fixed_timestep.h>
+#include <evie/gpu_profiler.h>
 #include <evie/ids.h>
 #include <evie/input_manager.h>
 #include <evie/layer.h>
+#include <evie/resource_manager.h>
 #include <evie/shader.h>
 #include <evie/shader_program.h>
 #include <evie/texture.h>
@@ -31,11 +35,19 @@ public:
   static constexpr float DefaultPlayerSpeed = 5.0F;
   static constexpr float SprintPlayerSpeed = 10.0F;
 
-  evie::Error
-    Initialise(evie::IInputManager* input_manager, evie::ECSController* ecs_controller, evie::IWindow* window);
+  evie::Error Initialise(evie::IInputManager* input_manager,
+    evie::ECSController* ecs_controller,
+    evie::ResourceManager* resource_manager,
+    evie::IWindow* window,
+    const evie::FrameTime* frame_time,
+    evie::GpuProfiler* gpu_profiler);
   void OnUpdate() override;
+  void OnFixedUpdate(float delta_time) override;
   void OnRender() override;
+  // Used instead of OnRender() when the render thread is enabled.
+  void OnRecord(evie::CommandList& commands) override;
   void OnEvent(evie::Event& event) override;
+  void Shutdown() override;
 
 private:
   void HandlePlayerCameraMovement(float delta_time);
@@ -53,8 +65,11 @@ private:
   // Player camera
   evie::FPSCamera player_camera_;
 
-  // Last frame time stamp
-  float last_frame_{ 0.0F };
+  // Timing of the current frame, owned by the application
+  const evie::FrameTime* frame_time_{ nullptr };
+
+  // Times the render system on the GPU, owned by the application
+  evie::GpuProfiler* gpu_profiler_{ nullptr };
 
   // Input manager
   evie::IInputManager* input_manager_{ nullptr };
@@ -65,8 +80,8 @@ private:
   // Window interface
   evie::IWindow* window_{ nullptr };
 
-  // Floor Texture
-  evie::Texture2D floor_texture_;
+  // Shared meshes, textures and shader programs
+  evie::ResourceManager* resources_{ nullptr };
 
   // MeshComponent ID
   evie::ComponentID<evie::MeshComponent> mesh_cid_{ 0 };
@@ -89,12 +104,6 @@ private:
   // EnemyComponent ID
   evie::ComponentID<EnemyComponent> enemy_cid_{0};
 
-  // Floor Vertex Shader
-  evie::VertexShader floor_vertex_shader_;
-
-  // Floor Fragment Shader
-  evie::FragmentShader floor_fragment_shader_;
-
   // Render System
   Renderer* renderer_{ nullptr };
 
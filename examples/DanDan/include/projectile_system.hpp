@@ -2,6 +2,7 @@
 #define INCLUDE_DANDAN_PROJECTILE_SYSTEM_HPP_
 
 #include "components.hpp"
+#include "textured_mesh.hpp"
 #include <evie/default_models.h>
 #include <evie/ecs/components/mesh_component.hpp>
 #include <evie/ecs/components/transform.hpp>
@@ -10,6 +11,7 @@
 #include <evie/error.h>
 #include <evie/events.h>
 #include <evie/ids.h>
+#include <evie/resource_manager.h>
 #include <evie/input.h>
 #include <evie/input_manager.h>
 #include <evie/shader_program.h>
@@ -50,23 +52,20 @@ public:
 
   static constexpr float ProjectileSpeed = 40.0F;
 
-  evie::Error Initialise()
+  evie::Error Initialise(evie::ResourceManager& resources)
   {
-    evie::Error err = evie::Error::OK();
-    if (err.Good()) {
-      err = vs_.Initialise(R"(C:\Users\willa\devel\Evie\shaders\vertex_shader.vs)");
-    }
-    if (err.Good()) {
-      err = fs_.Initialise(R"(C:\Users\willa\devel\Evie\shaders\fragment_shader.fs)");
-    }
-    // Floor texture
-    if (err.Good()) {
-      err = tex_.Initialise(
-        R"(C:\Users\willa\devel\Evie\out\install\windows-msvc-debug-developer-mode\assets\textures\grass.jpg)");
-    }
-    if (err.Good()) {
-      err = shader_program_.Initialise(&vs_, &fs_);
-    }
+    // Every projectile shares the same cube so they can all be drawn with one instanced draw call. Spawning one only
+    // copies handles to these resources.
+    TexturedMeshDesc desc;
+    desc.mesh_key = "default_models::cube";
+    desc.vertices = &evie::default_models::cube;
+    desc.vertex_shader = R"(C:\Users\willa\devel\Evie\shaders\instanced_texture_array_vertex_shader.vs)";
+    desc.fragment_shader = R"(C:\Users\willa\devel\Evie\shaders\texture_array_fragment_shader.fs)";
+    desc.texture =
+      R"(C:\Users\willa\devel\Evie\out\install\windows-msvc-debug-developer-mode\assets\textures\grass.jpg)";
+    desc.texture_array = true;
+    evie::Error err = LoadTexturedMesh(resources, desc, mesh_);
+    mesh_.instanced = true;
     return err;
   }
 
@@ -117,23 +116,7 @@ private:
       transform.rotation = player_transform.rotation;
       err = entity->AddComponent(transform_cid_, transform);
       if (err.Good()) {
-        evie::MeshComponent mesh_component;
-        evie::BufferLayout layout;
-        layout.stride = 5;// NOLINT
-        layout.type = evie::VertexDataType::Float;
-        layout.layout_sizes = { 3, 2 };
-        err = mesh_component.model_data.Initialise(evie::default_models::cube, layout);
-        if (err.Good()) {
-          mesh_component.vertex_array.Initialise();
-          err = mesh_component.vertex_array.AssociateVertexBuffer(mesh_component.model_data);
-        }
-        mesh_component.shader_program = shader_program_;
-        if (err.Good()) {
-          mesh_component.shader_program.Use();
-          mesh_component.shader_program.SetInt("Texture1", 0);
-          mesh_component.texture = tex_;
-          err = entity->AddComponent(mesh_cid_, mesh_component);
-        }
+        err = entity->AddComponent(mesh_cid_, mesh_);
         if (err.Good()) {
           err = entity->AddComponent(projectile_cid_);
         }
@@ -154,10 +137,7 @@ private:
   evie::ComponentID<ProjectileComponent> projectile_cid_{ 0 };
   evie::ComponentID<VelocityComponent> velocity_cid_{ 0 };
   evie::Entity* player_entity_{ nullptr };
-  evie::VertexShader vs_;
-  evie::FragmentShader fs_;
-  evie::Texture2D tex_;
-  evie::ShaderProgram shader_program_;
+  evie::MeshComponent mesh_;
   float map_boundary_;
 };
 
@@ -2,12 +2,19 @@
 #define INCLUDE_RENDER_HPP_
 
 #include <evie/camera.h>
+#include <evie/command_list.h>
 #include <evie/ecs/components/mesh_component.hpp>
 #include <evie/ecs/components/transform.hpp>
 #include <evie/ecs/system.hpp>
+#include <evie/frustum_culling.h>
+#include <evie/geometry_pool.h>
 #include <evie/ids.h>
+#include <evie/render_queue.h>
 #include <evie/window.h>
 
+#include <cstddef>
+#include <vector>
+
 class Renderer : public evie::System
 {
 public:
@@ -23,13 +30,92 @@ public:
     evie::FPSCamera* camera,
     evie::IWindow* window);
 
+  // Room for the walls and floor with plenty to spare.
+  static constexpr size_t StaticVertexCapacity = 4096;
+
+  // Create the pool that static meshes are drawn from. Must be called on the GL thread before AddStaticMesh().
+  evie::Error InitialiseStaticGeometry();
+
+  /**
+   * @brief Bake x,y,z,u,v vertices into world space and add them to the static geometry. Static meshes never move and
+   * are culled like entities, but everything visible that shares material's shader program and texture is drawn with
+   * one call.
+   *
+   * @param material Only the shader program and texture are used, the mesh can be empty. The shader program must take
+   * a "model" uniform, which is set to the identity.
+   */
+  evie::Error
+    AddStaticMesh(const std::vector<float>& vertices, const evie::mat4& model, const evie::MeshComponent& material);
+
+  // Remember where every entity is before a fixed update moves it. Call at the start of each fixed update.
+  void SavePreviousTransforms();
+
+  // How far between the previous and current transforms entities are drawn, see evie::FrameTime::alpha.
+  void SetInterpolationAlpha(float alpha) { alpha_ = alpha; }
+
+  // Cull and record the frame without calling GL, so it can run on the simulation thread. See GameLayer::OnRecord().
+  void Record(evie::CommandList& commands);
+
+  void Destroy();
+
+  static evie::mat4 GetModelMatrix(const evie::TransformComponent& transform);
+
 private:
+  struct RenderEntity
+  {
+    evie::Entity entity;
+    evie::mat4 model;
+    evie::BoundingSphere sphere;
+  };
+
+  // Static meshes sharing a shader program and texture, and those of them visible this frame.
+  struct StaticMaterial
+  {
+    evie::ShaderProgramHandle shader_program;
+    evie::TextureHandle texture;
+    evie::TextureLayer texture_layer;
+    evie::GeometryDrawList draws;
+  };
+
+  struct StaticMesh
+  {
+    evie::GeometryRange range;
+    evie::BoundingSphere sphere;
+    size_t material{ 0 };
+  };
+
+  // A visible static material, with raw pointers like evie::DrawCommand. static_materials_ holds the handles.
+  struct StaticDraw
+  {
+    evie::ShaderProgram* shader_program{ nullptr };
+    evie::Texture2D* texture{ nullptr };
+    evie::TextureLayer texture_layer;
+    evie::GeometryDrawList draws;
+  };
+
+  // Draws the frame straight away, used when the render thread isn't enabled.
   void Update(const float& delta_time) override;
+  void DrawStatic(const StaticDraw& draw) const;
+  // The entity's transform blended from its previous one by alpha_. Entities created since the last fixed update are
+  // drawn where they are.
+  [[nodiscard]] evie::TransformComponent InterpolatedTransform(const evie::Entity& entity) const;
 
   evie::ComponentID<evie::MeshComponent> mesh_cid_{ 0 };
   evie::ComponentID<evie::TransformComponent> transform_cid_{ 0 };
   evie::FPSCamera* camera_{ nullptr };
   evie::IWindow* window_{ nullptr };
+  // Kept between frames so that the per frame containers don't reallocate.
+  evie::FrustumCuller culler_;
+  std::vector<RenderEntity> render_entities_;
+  // Transforms before the last fixed update.
+  ankerl::unordered_dense::map<evie::Entity, evie::TransformComponent> previous_transforms_;
+  float alpha_{ 1.0F };
+  // Only used when the frame is drawn straight away.
+  evie::CommandList frame_;
+  evie::RenderQueue render_queue_;
+  evie::GeometryPool static_geometry_;
+  std::vector<StaticMaterial> static_materials_;
+  std::vector<StaticMesh> static_meshes_;
 };
 
 #endif// !INCLUDE_RENDER_HPP_
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef INCLUDE_DANDAN_TEXTURED_MESH_HPP_
+#define INCLUDE_DANDAN_TEXTURED_MESH_HPP_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <evie/ecs/components/mesh_component.hpp>
+#include <evie/error.h>
+#include <evie/resource_manager.h>
+#include <evie/texture.h>
+#include <evie/vertex_buffer.h>
+
+// Everything in DanDan is drawn with x,y,z,u,v vertices, a shader program and one texture.
+struct TexturedMeshDesc
+{
+  // Unique name for the vertices, the mesh is only created the first time it's loaded.
+  std::string_view mesh_key;
+  const std::vector<float>* vertices{ nullptr };
+  std::string vertex_shader;
+  std::string fragment_shader;
+  std::string texture;
+  bool flip_texture{ false };
+  evie::TextureWrapping wrapping{ evie::TextureWrapping::Repeat };
+  // Load the texture into a layer of a shared texture array so meshes with different textures can batch. The shaders
+  // must sample the "textures" array, see shaders/texture_array_fragment_shader.fs. Array layers always repeat.
+  bool texture_array{ false };
+};
+
+// x,y,z,u,v
+inline evie::BufferLayout TexturedMeshLayout()
+{
+  evie::BufferLayout layout;
+  layout.stride = 5;// NOLINT
+  layout.type = evie::VertexDataType::Float;
+  layout.layout_sizes = { 3, 2 };
+  return layout;
+}
+
+// Load desc's shader program and texture into mesh_component, leaving its mesh alone. Static geometry only needs these,
+// see Renderer::AddStaticMesh().
+inline evie::Error LoadTexturedMaterial(evie::ResourceManager& resources,
+  const TexturedMeshDesc& desc,
+  evie::MeshComponent& mesh_component)
+{
+  evie::Result<evie::ShaderProgramHandle> shader_program =
+    resources.LoadShaderProgram(desc.vertex_shader, desc.fragment_shader);
+  if (shader_program.Bad()) {
+    return shader_program.Error();
+  }
+
+  mesh_component.shader_program = *shader_program;
+  mesh_component.shader_program->Use();
+  if (desc.texture_array) {
+    // Arrays have no placeholder so this decodes on the calling thread.
+    evie::Result<evie::TextureLayer> layer = resources.GetTextureArrays().Load(desc.texture, desc.flip_texture);
+    if (layer.Bad()) {
+      return layer.Error();
+    }
+    mesh_component.texture_layer = *layer;
+    mesh_component.shader_program->SetInt("textures", 0);
+    return evie::Error::OK();
+  }
+
+  // Draws with a placeholder until the image has loaded.
+  evie::Result<evie::TextureHandle> texture =
+    resources.LoadTextureAsync(desc.texture, desc.flip_texture, desc.wrapping);
+  if (texture.Bad()) {
+    return texture.Error();
+  }
+  mesh_component.texture = *texture;
+  // Setup the texture slot in the shader program.
+  mesh_component.shader_program->SetInt("Texture1", 0);
+  return evie::Error::OK();
+}
+
+// Point mesh_component at shared resources, loading whatever isn't loaded already.
+inline evie::Error
+  LoadTexturedMesh(evie::ResourceManager& resources, const TexturedMeshDesc& desc, evie::MeshComponent& mesh_component)
+{
+  evie::Result<evie::MeshHandle> mesh = resources.LoadMesh(desc.mesh_key, *desc.vertices, TexturedMeshLayout());
+  if (mesh.Bad()) {
+    return mesh.Error();
+  }
+  mesh_component.mesh = *mesh;
+  return LoadTexturedMaterial(resources, desc, mesh_component);
+}
+
+#endif// !INCLUDE_DANDAN_TEXTURED_MESH_HPP_
@@ -3,8 +3,7 @@
 #include "follow_system.hpp"
 #include "physics_system.hpp"
 #include "projectile_system.hpp"
-
-#include <GLFW/glfw3.h>
+#include "textured_mesh.hpp"
 
 #include <dandan_system.hpp>
 #include <evie/default_models.h>
@@ -30,8 +29,12 @@
 #include <imgui.h>
 #include <numbers>
 
-evie::Error
-  GameLayer::Initialise(evie::IInputManager* input_manager, evie::ECSController* ecs_controller, evie::IWindow* window)
+evie::Error GameLayer::Initialise(evie::IInputManager* input_manager,
+  evie::ECSController* ecs_controller,
+  evie::ResourceManager* resource_manager,
+  evie::IWindow* window,
+  const evie::FrameTime* frame_time,
+  evie::GpuProfiler* gpu_profiler)
 {
   evie::Error err = evie::Error::OK();
   // Initialise our variables
@@ -45,11 +48,26 @@ evie::Error
     return evie::Error{ "Invalid ECS" };
   }
 
+  resources_ = resource_manager;
+  if (resources_ == nullptr) {
+    return evie::Error{ "Invalid resource manager" };
+  }
+
   window_ = window;
   if (window_ == nullptr) {
     return evie::Error{ "Invalid window" };
   }
 
+  frame_time_ = frame_time;
+  if (frame_time_ == nullptr) {
+    return evie::Error{ "Invalid frame time" };
+  }
+
+  gpu_profiler_ = gpu_profiler;
+  if (gpu_profiler_ == nullptr) {
+    return evie::Error{ "Invalid GPU profiler" };
+  }
+
   constexpr float map_scale = 50.0F;
 
   // Let's use ECS to add data to our models
@@ -69,6 +87,7 @@ evie::Error
   auto sys_id = ecs_->RegisterSystem<Renderer>(signature);
   renderer_ = &(ecs_->GetSystem(sys_id));
   renderer_->Initialise(mesh_cid_, transform_cid_, &player_camera_, window_);
+  err = renderer_->InitialiseStaticGeometry();
 
   // Register our follow system
   evie::SystemSignature follow_signature;
@@ -101,7 +120,7 @@ evie::Error
     map_scale);
   dandan_system_ = &(ecs_->GetSystem(enemy_sys_id));
   if (err.Good()) {
-    err = dandan_system_->Initialise();
+    err = dandan_system_->Initialise(*resources_);
   }
 
   if (err.Good()) {
@@ -115,7 +134,7 @@ evie::Error
     project_signature, ecs_, mesh_cid_, transform_cid_, projectile_cid_, velocity_cid_, player_entity_, map_scale);
   projectile_system_ = &(ecs_->GetSystem(projectile_sys_id));
   if (err.Good()) {
-    err = projectile_system_->Initialise();
+    err = projectile_system_->Initialise(*resources_);
   }
 
   if (err.Good()) {
@@ -141,13 +160,14 @@ evie::Error
 
 void GameLayer::OnUpdate()
 {
-  // Calculate some delta times between last OnUpdate call
-  // TODO - Would it be nice if we didn't have to handle delta_time ourselves?
-  auto current_frame = static_cast<float>(glfwGetTime());
-  float delta_time = current_frame - last_frame_;
-  last_frame_ = current_frame;
+  // The camera moves every frame so it stays responsive whatever the tick rate.
+  HandlePlayerCameraMovement(frame_time_->delta_time);
+}
 
-  HandlePlayerCameraMovement(delta_time);
+void GameLayer::OnFixedUpdate(float delta_time)
+{
+  // The renderer draws entities between where this update starts and ends them.
+  renderer_->SavePreviousTransforms();
 
   // Update follow system
   follower_system_->FollowOn(follow_on_);
@@ -163,7 +183,25 @@ void GameLayer::OnUpdate()
   physics_system_->UpdateSystem(delta_time);
 }
 
-void GameLayer::OnRender() { renderer_->UpdateSystem(0.0F); }
+void GameLayer::OnRender()
+{
+  EV_PROFILE_GPU_TYPE_SCOPE(*gpu_profiler_, *renderer_);
+  renderer_->SetInterpolationAlpha(frame_time_->alpha);
+  renderer_->UpdateSystem(0.0F);
+}
+
+void GameLayer::OnRecord(evie::CommandList& commands)
+{
+  renderer_->SetInterpolationAlpha(frame_time_->alpha);
+  renderer_->Record(commands);
+}
+
+void GameLayer::Shutdown()
+{
+  if (renderer_ != nullptr) {
+    renderer_->Destroy();
+  }
+}
 
 void GameLayer::OnEvent(evie::Event& event)
 {
@@ -271,57 +309,23 @@ evie::Error GameLayer::SetupFloor(float map_scale)
   player_camera_.ResetCameraPosition({ 0.0, 1.0, 0.0 });
   player_camera_.camera_speed = DefaultPlayerSpeed;
 
-  // Vertex Shader
-  if (err.Good()) {
-    err = floor_vertex_shader_.Initialise(R"(C:\Users\willa\devel\Evie\shaders\vertex_shader.vs)");
-  }
-
-  // Fragment Shader
-  if (err.Good()) {
-    err = floor_fragment_shader_.Initialise(R"(C:\Users\willa\devel\Evie\shaders\fragment_shader.fs)");
-  }
-
-  // Floor texture
+  // The floor never moves so it's static geometry rather than an entity.
+  evie::MeshComponent floor_material;
+  TexturedMeshDesc floor_desc;
+  floor_desc.vertex_shader = R"(C:\Users\willa\devel\Evie\shaders\vertex_shader.vs)";
+  floor_desc.fragment_shader = R"(C:\Users\willa\devel\Evie\shaders\fragment_shader.fs)";
+  floor_desc.texture =
+    R"(C:\Users\willa\devel\Evie\out\install\windows-msvc-debug-developer-mode\assets\textures\stone-wall.jpg)";
+  floor_desc.wrapping = evie::TextureWrapping::MirroredRepeat;
   if (err.Good()) {
-    err = floor_texture_.Initialise(
-      R"(C:\Users\willa\devel\Evie\out\install\windows-msvc-debug-developer-mode\assets\textures\stone-wall.jpg)",
-      false,
-      evie::TextureWrapping::MirroredRepeat);
-  }
-
-  evie::MeshComponent floor_mesh_component;
-  // We need to create the layout for our model/vertex data
-  evie::BufferLayout layout;
-  layout.stride = 5;// NOLINT
-  layout.type = evie::VertexDataType::Float;
-  layout.layout_sizes = { 3, 2 };
-  if (err.Good()) {
-    // Initialise the vertex buffer
-    err = floor_mesh_component.model_data.Initialise(floor_model, layout);
-  }
-  if (err.Good()) {
-    // Associate the vertex buffer with the vertex array
-    floor_mesh_component.vertex_array.Initialise();
-    err = floor_mesh_component.vertex_array.AssociateVertexBuffer(floor_mesh_component.model_data);
+    err = LoadTexturedMaterial(*resources_, floor_desc, floor_material);
   }
-  if (err.Good()) {
-    // Initialise the shader program with our vert/frag shaders
-    err = floor_mesh_component.shader_program.Initialise(&floor_vertex_shader_, &floor_fragment_shader_);
-  }
-  // Now setup the texture slots and bind them to our shader program.
-  floor_mesh_component.shader_program.Use();
-  floor_mesh_component.shader_program.SetInt("Texture1", 0);
-  floor_mesh_component.texture = floor_texture_;
 
   // Create floor
-  auto floor_entity = ecs_->CreateEntity();
   if (err.Good()) {
-    err = floor_entity->AddComponent(mesh_cid_, floor_mesh_component);
-    if (err.Good()) {
-      evie::TransformComponent transform;
-      transform.scale = { map_scale * 1.0F, 1.0F, map_scale * 1.0F };
-      err = floor_entity->AddComponent(transform_cid_, transform);
-    }
+    evie::TransformComponent transform;
+    transform.scale = { map_scale * 1.0F, 1.0F, map_scale * 1.0F };
+    err = renderer_->AddStaticMesh(floor_model, Renderer::GetModelMatrix(transform), floor_material);
   }
 
   return err;
@@ -331,25 +335,6 @@ evie::Error GameLayer::SetupSkybox(float map_scale)
 {
   evie::Error err = evie::Error::OK();
 
-  // Sky box texture
-  evie::Texture2D sky_texture;
-  if (err.Good()) {
-    err = sky_texture.Initialise(
-      R"(C:\Users\willa\devel\Evie\out\install\windows-msvc-debug-developer-mode\assets\textures\skybox.png)", true);
-  }
-
-  evie::VertexShader vert_shader;
-  evie::FragmentShader frag_shader;
-  // Vertex Shader
-  if (err.Good()) {
-    err = vert_shader.Initialise(R"(C:\Users\willa\devel\Evie\shaders\vertex_shader.vs)");
-  }
-
-  // Fragment Shader
-  if (err.Good()) {
-    err = frag_shader.Initialise(R"(C:\Users\willa\devel\Evie\shaders\fragment_shader.fs)");
-  }
-
   // Create skybox entity
   auto entity = ecs_->CreateEntity();
   if (err.Bad()) {
@@ -405,29 +390,19 @@ std::vector<float> sky_cube {
   // clang-format on
 
   evie::MeshComponent mesh_component;
-  evie::BufferLayout layout;
-  layout.stride = 5;// NOLINT
-  layout.type = evie::VertexDataType::Float;
-  layout.layout_sizes = { 3, 2 };
-
-  if (err.Good()) {
-    err = mesh_component.model_data.Initialise(sky_cube, layout);
-  }
-
-  if (err.Good()) {
-    mesh_component.vertex_array.Initialise();
-    err = mesh_component.vertex_array.AssociateVertexBuffer(mesh_component.model_data);
-  }
-
+  TexturedMeshDesc sky_desc;
+  sky_desc.mesh_key = "skybox";
+  sky_desc.vertices = &sky_cube;
+  sky_desc.vertex_shader = R"(C:\Users\willa\devel\Evie\shaders\vertex_shader.vs)";
+  sky_desc.fragment_shader = R"(C:\Users\willa\devel\Evie\shaders\fragment_shader.fs)";
+  sky_desc.texture =
+    R"(C:\Users\willa\devel\Evie\out\install\windows-msvc-debug-developer-mode\assets\textures\skybox.png)";
+  sky_desc.flip_texture = true;
   if (err.Good()) {
-    err = mesh_component.shader_program.Initialise(&vert_shader, &frag_shader);
+    err = LoadTexturedMesh(*resources_, sky_desc, mesh_component);
   }
 
   if (err.Good()) {
-    mesh_component.shader_program.Use();
-    mesh_component.shader_program.SetInt("Texture1", 0);
-    mesh_component.texture = sky_texture;
-
     err = entity->AddComponent(mesh_cid_, mesh_component);
     if (err.Good()) {
       evie::TransformComponent transform;
@@ -456,123 +431,77 @@ evie::Error GameLayer::SetupWalls(float map_scale)
   };
   // clang-format on
 
-  // Vertex Shader
-  evie::VertexShader vert_shader;
-  evie::FragmentShader frag_shader;
-  if (err.Good()) {
-    err = vert_shader.Initialise(R"(C:\Users\willa\devel\Evie\shaders\vertex_shader.vs)");
-  }
-
-  // Fragment Shader
-  if (err.Good()) {
-    err = frag_shader.Initialise(R"(C:\Users\willa\devel\Evie\shaders\fragment_shader.fs)");
-  }
-
-  evie::Texture2D tex;
-  // Floor texture
-  if (err.Good()) {
-    err = tex.Initialise(
-      R"(C:\Users\willa\devel\Evie\out\install\windows-msvc-debug-developer-mode\assets\textures\my-wall2.png)");
-  }
-
-  evie::MeshComponent wall_component;
-  // We need to create the layout for our model/vertex data
-  evie::BufferLayout layout;
-  layout.stride = 5;// NOLINT
-  layout.type = evie::VertexDataType::Float;
-  layout.layout_sizes = { 3, 2 };
-  if (err.Good()) {
-    // Initialise the vertex buffer
-    err = wall_component.model_data.Initialise(wall_model, layout);
-  }
-  if (err.Good()) {
-    // Associate the vertex buffer with the vertex array
-    wall_component.vertex_array.Initialise();
-    err = wall_component.vertex_array.AssociateVertexBuffer(wall_component.model_data);
-  }
+  // The walls never move so they're static geometry rather than entities. All four share the same shader program and
+  // texture, so they're drawn with one call.
+  evie::MeshComponent wall_material;
+  TexturedMeshDesc wall_desc;
+  wall_desc.vertex_shader = R"(C:\Users\willa\devel\Evie\shaders\texture_array_vertex_shader.vs)";
+  wall_desc.fragment_shader = R"(C:\Users\willa\devel\Evie\shaders\texture_array_fragment_shader.fs)";
+  wall_desc.texture =
+    R"(C:\Users\willa\devel\Evie\out\install\windows-msvc-debug-developer-mode\assets\textures\my-wall2.png)";
+  wall_desc.texture_array = true;
   if (err.Good()) {
-    // Initialise the shader program with our vert/frag shaders
-    err = wall_component.shader_program.Initialise(&vert_shader, &frag_shader);
+    err = LoadTexturedMaterial(*resources_, wall_desc, wall_material);
   }
-  // Now setup the texture slots and bind them to our shader program.
-  wall_component.shader_program.Use();
-  wall_component.shader_program.SetInt("Texture1", 0);
-  wall_component.texture = tex;
 
   constexpr float wall_height_offset = 0.5F;
   const float wall_offset = map_scale / 2.0F;
   constexpr float half_cover_quat = 2.0F;
 
   // Create wall infront
-  auto floor_entity_infront = ecs_->CreateEntity();
   if (err.Good()) {
-    err = floor_entity_infront->AddComponent(mesh_cid_, wall_component);
-    if (err.Good()) {
-      evie::TransformComponent transform;
-      transform.scale = { map_scale * 1.0F, 1.0F, map_scale * 1.0F };
-      // transform the wall up by half the height.
-      // NOLINTNEXTLINE(*-union-access)
-      transform.position.y = wall_height_offset;
-      // transform the wall to the front of the map.
-      // NOLINTNEXTLINE(*-union-access)
-      transform.position.z = -wall_offset;
-      err = floor_entity_infront->AddComponent(transform_cid_, transform);
-    }
+    evie::TransformComponent transform;
+    transform.scale = { map_scale * 1.0F, 1.0F, map_scale * 1.0F };
+    // transform the wall up by half the height.
+    // NOLINTNEXTLINE(*-union-access)
+    transform.position.y = wall_height_offset;
+    // transform the wall to the front of the map.
+    // NOLINTNEXTLINE(*-union-access)
+    transform.position.z = -wall_offset;
+    err = renderer_->AddStaticMesh(wall_model, Renderer::GetModelMatrix(transform), wall_material);
   }
 
   // Create wall on left side
-  auto floor_entity_left = ecs_->CreateEntity();
   if (err.Good()) {
-    err = floor_entity_left->AddComponent(mesh_cid_, wall_component);
-    if (err.Good()) {
-      evie::TransformComponent transform;
-      transform.scale = { map_scale * 1.0F, 1.0F, map_scale * 1.0F };
-      // transform the wall up by half the height.
-      // NOLINTNEXTLINE(*-union-access)
-      transform.position.y = wall_height_offset;
-      // transform the wall to the left of the map
-      // NOLINTNEXTLINE(*-union-access)
-      transform.position.x = -wall_offset;
-      transform.rotation = glm::angleAxis(
-        static_cast<float>(static_cast<float>(std::numbers::pi) / half_cover_quat), glm::vec3{ 0.0F, 1.0F, 0.0F });
-      err = floor_entity_left->AddComponent(transform_cid_, transform);
-    }
+    evie::TransformComponent transform;
+    transform.scale = { map_scale * 1.0F, 1.0F, map_scale * 1.0F };
+    // transform the wall up by half the height.
+    // NOLINTNEXTLINE(*-union-access)
+    transform.position.y = wall_height_offset;
+    // transform the wall to the left of the map
+    // NOLINTNEXTLINE(*-union-access)
+    transform.position.x = -wall_offset;
+    transform.rotation = glm::angleAxis(
+      static_cast<float>(static_cast<float>(std::numbers::pi) / half_cover_quat), glm::vec3{ 0.0F, 1.0F, 0.0F });
+    err = renderer_->AddStaticMesh(wall_model, Renderer::GetModelMatrix(transform), wall_material);
   }
 
   // Create wall on right side
-  auto floor_entity_right = ecs_->CreateEntity();
   if (err.Good()) {
-    err = floor_entity_right->AddComponent(mesh_cid_, wall_component);
-    if (err.Good()) {
-      evie::TransformComponent transform;
-      transform.scale = { map_scale * 1.0F, 1.0F, map_scale * 1.0F };
-      // transform the wall up by half the height.
-      // NOLINTNEXTLINE(*-union-access)
-      transform.position.y = wall_height_offset;
-      // transform the wall to the right of the map
-      // NOLINTNEXTLINE(*-union-access)
-      transform.position.x = wall_offset;
-      transform.rotation = glm::angleAxis(
-        static_cast<float>(static_cast<float>(std::numbers::pi) / half_cover_quat), glm::vec3{ 0.0F, 1.0F, 0.0F });
-      err = floor_entity_right->AddComponent(transform_cid_, transform);
-    }
+    evie::TransformComponent transform;
+    transform.scale = { map_scale * 1.0F, 1.0F, map_scale * 1.0F };
+    // transform the wall up by half the height.
+    // NOLINTNEXTLINE(*-union-access)
+    transform.position.y = wall_height_offset;
+    // transform the wall to the right of the map
+    // NOLINTNEXTLINE(*-union-access)
+    transform.position.x = wall_offset;
+    transform.rotation = glm::angleAxis(
+      static_cast<float>(static_cast<float>(std::numbers::pi) / half_cover_quat), glm::vec3{ 0.0F, 1.0F, 0.0F });
+    err = renderer_->AddStaticMesh(wall_model, Renderer::GetModelMatrix(transform), wall_material);
   }
 
   // Create wall behind
-  auto floor_entity_behind = ecs_->CreateEntity();
   if (err.Good()) {
-    err = floor_entity_behind->AddComponent(mesh_cid_, wall_component);
-    if (err.Good()) {
-      evie::TransformComponent transform;
-      transform.scale = { map_scale * 1.0F, 1.0F, map_scale * 1.0F };
-      // transform the wall up by half the height.
-      // NOLINTNEXTLINE(*-union-access)
-      transform.position.y = wall_height_offset;
-      // transform the wall to the front of the map.
-      // NOLINTNEXTLINE(*-union-access)
-      transform.position.z = wall_offset;
-      err = floor_entity_behind->AddComponent(transform_cid_, transform);
-    }
+    evie::TransformComponent transform;
+    transform.scale = { map_scale * 1.0F, 1.0F, map_scale * 1.0F };
+    // transform the wall up by half the height.
+    // NOLINTNEXTLINE(*-union-access)
+    transform.position.y = wall_height_offset;
+    // transform the wall to the front of the map.
+    // NOLINTNEXTLINE(*-union-access)
+    transform.position.z = wall_offset;
+    err = renderer_->AddStaticMesh(wall_model, Renderer::GetModelMatrix(transform), wall_material);
   }
 
   return err;
@@ -585,47 +514,17 @@ evie::Error GameLayer::SetupDanDan()
   constexpr float dandan_height_offset{ 1.5F };
 
   // Create DanDan box
-  // Vertex Shader
-  evie::VertexShader vert_shader;
-  evie::FragmentShader frag_shader;
-  if (err.Good()) {
-    err = vert_shader.Initialise(R"(C:\Users\willa\devel\Evie\shaders\vertex_shader.vs)");
-  }
-
-  // Fragment Shader
-  if (err.Good()) {
-    err = frag_shader.Initialise(R"(C:\Users\willa\devel\Evie\shaders\fragment_shader.fs)");
-  }
-
-  evie::Texture2D tex;
-  // Floor texture
-  if (err.Good()) {
-    err = tex.Initialise(
-      R"(C:\Users\willa\devel\Evie\out\install\windows-msvc-debug-developer-mode\assets\textures\dandan.png)");
-  }
-
   evie::MeshComponent wall_component;
-  // We need to create the layout for our model/vertex data
-  evie::BufferLayout layout;
-  layout.stride = 5;// NOLINT
-  layout.type = evie::VertexDataType::Float;
-  layout.layout_sizes = { 3, 2 };
-  if (err.Good()) {
-    // Initialise the vertex buffer
-    err = wall_component.model_data.Initialise(evie::default_models::cube_texture_up_right, layout);
-  }
-  if (err.Good()) {
-    // Associate the vertex buffer with the vertex array
-    wall_component.vertex_array.Initialise();
-    err = wall_component.vertex_array.AssociateVertexBuffer(wall_component.model_data);
-  }
+  TexturedMeshDesc dandan_desc;
+  dandan_desc.mesh_key = "default_models::cube_texture_up_right";
+  dandan_desc.vertices = &evie::default_models::cube_texture_up_right;
+  dandan_desc.vertex_shader = R"(C:\Users\willa\devel\Evie\shaders\vertex_shader.vs)";
+  dandan_desc.fragment_shader = R"(C:\Users\willa\devel\Evie\shaders\fragment_shader.fs)";
+  dandan_desc.texture =
+    R"(C:\Users\willa\devel\Evie\out\install\windows-msvc-debug-developer-mode\assets\textures\dandan.png)";
   if (err.Good()) {
-    // Initialise the shader program with our vert/frag shaders
-    err = wall_component.shader_program.Initialise(&vert_shader, &frag_shader);
+    err = LoadTexturedMesh(*resources_, dandan_desc, wall_component);
   }
-  wall_component.shader_program.Use();
-  wall_component.shader_program.SetInt("Texture1", 0);
-  wall_component.texture = tex;
 
   auto dandan = ecs_->CreateEntity();
   if (dandan && err.Good()) {
@@ -2,6 +2,8 @@
 #include "evie/entrypoint.h"
 #include "evie/logging.h"
 
+#include <cstdlib>
+
 
 #include "game_layer.hpp"
 
@@ -17,9 +19,20 @@ public:
     APP_INFO("Initialising engine");
     evie::Error err = Initialise(props);
     if (err.Good()) {
-      err = game_layer_.Initialise(GetInputManager(), GetECSController(), GetWindow());
+      EnableGpuProfiling();
+      err = game_layer_.Initialise(GetInputManager(),
+        GetECSController(),
+        GetResourceManager(),
+        GetWindow(),
+        &GetFrameTime(),
+        GetGpuProfiler());
       if (err.Good()) {
         PushLayerBack(game_layer_);
+        // Set DANDAN_RENDER_THREAD to draw on a thread of its own, GameLayer then records through OnRecord().
+        if (std::getenv("DANDAN_RENDER_THREAD") != nullptr) {// NOLINT(concurrency-mt-unsafe)
+          APP_INFO("Rendering on a separate thread");
+          EnableRenderThread();
+        }
       }
     }
     return err;
@@ -1,4 +1,8 @@
 #include "render.hpp"
+#include "textured_mesh.hpp"
+
+#include <algorithm>
+#include <cstdint>
 #include <evie/ids.h>
 #include <evie/window.h>
 #include <glm/ext/matrix_transform.hpp>
@@ -7,6 +11,7 @@
 #include <glm/gtx/euler_angles.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/string_cast.hpp>
+#include <numeric>
 
 void Renderer::Initialise(evie::ComponentID<evie::MeshComponent> mesh_cid,
   evie::ComponentID<evie::TransformComponent> transform_cid,
@@ -19,46 +24,183 @@ void Renderer::Initialise(evie::ComponentID<evie::MeshComponent> mesh_cid,
   window_ = window;
 }
 
+evie::Error Renderer::InitialiseStaticGeometry()
+{
+  const evie::BufferLayout layout = TexturedMeshLayout();
+  return static_geometry_.Initialise(
+    layout, layout.stride * sizeof(float), StaticVertexCapacity, StaticVertexCapacity);
+}
+
+evie::Error
+  Renderer::AddStaticMesh(const std::vector<float>& vertices, const evie::mat4& model, const evie::MeshComponent& material)
+{
+  const size_t stride = TexturedMeshLayout().stride;
+  std::vector<float> world(vertices);
+  for (size_t i = 0; i + stride <= world.size(); i += stride) {
+    const evie::vec4 position = model * evie::vec4(world[i], world[i + 1], world[i + 2], 1.0F);
+    world[i] = position.x;// NOLINT(*-union-access)
+    world[i + 1] = position.y;// NOLINT(*-union-access)
+    world[i + 2] = position.z;// NOLINT(*-union-access)
+  }
+  const size_t vertex_count = world.size() / stride;
+  // DanDan's meshes aren't indexed.
+  std::vector<uint32_t> indices(vertex_count);
+  std::iota(indices.begin(), indices.end(), 0U);
+  evie::Result<evie::GeometryRange> range = static_geometry_.Add(world.data(), vertex_count, indices);
+  if (range.Bad()) {
+    return range.Error();
+  }
+
+  auto found = std::find_if(static_materials_.begin(), static_materials_.end(), [&](const StaticMaterial& existing) {
+    return existing.shader_program == material.shader_program && existing.texture == material.texture
+           && existing.texture_layer.array == material.texture_layer.array
+           && existing.texture_layer.layer == material.texture_layer.layer;
+  });
+  if (found == static_materials_.end()) {
+    static_materials_.push_back({ material.shader_program, material.texture, material.texture_layer, {} });
+    found = std::prev(static_materials_.end());
+  }
+  static_meshes_.push_back({ *range,
+    evie::CalculateBoundingVolume(world.data(), world.size(), stride).sphere,
+    static_cast<size_t>(found - static_materials_.begin()) });
+  return evie::Error::OK();
+}
+
+void Renderer::Destroy()
+{
+  static_materials_.clear();
+  static_meshes_.clear();
+  static_geometry_.Destroy();
+  render_queue_.Destroy();
+}
+
+evie::mat4 Renderer::GetModelMatrix(const evie::TransformComponent& transform)
+{
+  // Handle transforming the object first
+  // This moves the object to where we want it in world space.
+  evie::mat4 model = glm::translate(evie::mat4(1.0F), transform.position);
+  // This rotates the object to where we want it in the world space.
+  model = model * glm::toMat4(transform.rotation);
+  return glm::scale(model, transform.scale);
+}
+
+void Renderer::SavePreviousTransforms()
+{
+  previous_transforms_.clear();
+  for (const auto& entity : entities) {
+    previous_transforms_.emplace(entity, entity.GetComponent(transform_cid_));
+  }
+}
+
+evie::TransformComponent Renderer::InterpolatedTransform(const evie::Entity& entity) const
+{
+  const auto& current = entity.GetComponent(transform_cid_);
+  const auto previous = previous_transforms_.find(entity);
+  if (previous == previous_transforms_.end()) {
+    return current;
+  }
+  evie::TransformComponent transform;
+  transform.position = glm::mix(previous->second.position, current.position, alpha_);
+  transform.rotation = glm::slerp(previous->second.rotation, current.rotation, alpha_);
+  transform.scale = glm::mix(previous->second.scale, current.scale, alpha_);
+  return transform;
+}
+
 void Renderer::Update(const float& delta_time)
 {
   std::ignore = delta_time;
+  // Without the render thread the frame is recorded and drawn straight away.
+  frame_.Clear();
+  Record(frame_);
+  render_queue_.Clear();
+  render_queue_.Reserve(frame_.draws.size());
+  for (const auto& command : frame_.draws) {
+    render_queue_.Submit(command);
+  }
+  render_queue_.Sort();
+  render_queue_.Execute(frame_.frame);
+  for (const auto& task : frame_.draw_tasks) {
+    task();
+  }
+}
+
+void Renderer::Record(evie::CommandList& commands)
+{
+  evie::mat4 view = camera_->GetViewMatrix();
+  // This sets up the projection. What's our FoV? What's our aspect ratio? Fix this to get from camera.
+  constexpr float near_cull = 0.1F;
+  constexpr float far_cull = 1000.0F;
+  evie::mat4 projection =
+    glm::perspective(glm::radians(camera_->field_of_view), window_->GetAspectRatio(), near_cull, far_cull);
+
+  // Cull stage. Work out the world space bounds of every mesh and only submit what the camera can see.
+  culler_.Clear();
+  render_entities_.clear();
   for (const auto& entity : entities) {
-    evie::mat4 model(1.0F);
-    const auto& translate = entity.GetComponent(transform_cid_);
+    const evie::mat4 model = GetModelMatrix(InterpolatedTransform(entity));
+    const auto& mesh = entity.GetComponent(mesh_cid_);
+
+    const evie::BoundingSphere sphere =
+      evie::TransformBoundingSphere(mesh.mesh->vertex_buffer.GetBoundingVolume().sphere, model);
+    culler_.Add(sphere);
+    render_entities_.push_back({ entity, model, sphere });
+  }
+  // Static meshes are culled after the entities, so their indices follow render_entities_.
+  for (const auto& static_mesh : static_meshes_) {
+    culler_.Add(static_mesh.sphere);
+  }
+  culler_.Cull(evie::Frustum::FromViewProjection(projection * view));
+
+  // Build a draw command for everything visible. The render queue sorts them so that draws sharing the same shader,
+  // texture and vertex array are issued together.
+  const evie::vec3 camera_position = camera_->GetPosition();
+  commands.frame = { view, projection, camera_position };
+  for (auto& material : static_materials_) {
+    material.draws.Clear();
+  }
+  for (const auto index : culler_.GetVisible()) {
+    if (index >= render_entities_.size()) {
+      const StaticMesh& static_mesh = static_meshes_[index - render_entities_.size()];
+      static_materials_[static_mesh.material].draws.Add(static_mesh.range);
+      continue;
+    }
+    auto& [entity, model, sphere] = render_entities_[index];
     auto& mesh = entity.GetComponent(mesh_cid_);
 
-    // Handle transforming the object first
-    // This moves the object to where we want it in world space.
-    model = glm::translate(model, translate.position);
-    // APP_INFO("Render entity {} with position {}", entity.GetID().Get(), glm::to_string(translate.position));
-    // This rotates the object to where we want it in the world space.
-    model = model * glm::toMat4(translate.rotation);
-    model = glm::scale(model, translate.scale);
-
-    // Bind VAO and Shader Program
-    auto& shader_program = mesh.shader_program;
-    shader_program.Use();
-    if (shader_program.HasVec3("viewPos")) {
-      shader_program.SetVec3("viewPos", camera_->GetPosition());
+    evie::DrawCommand command;
+    command.shader_program = mesh.shader_program.Get();
+    // Only one texture per mesh component atm.
+    command.texture = mesh.texture.Get();
+    command.texture_array = mesh.texture_layer.array;
+    command.texture_layer = mesh.texture_layer.layer;
+    command.vertex_array = mesh.mesh->vertex_array.GetID();
+    command.model = model;
+    command.vertex_count = mesh.GetModelIndices();
+    command.instanced = mesh.instanced;
+    command.depth = std::max(glm::distance(camera_position, sphere.centre) - sphere.radius, 0.0F) / far_cull;
+    commands.Submit(command);
+  }
+
+  for (const auto& material : static_materials_) {
+    if (material.draws.Empty() || !material.shader_program.Valid()) {
+      continue;
     }
-    mesh.vertex_array.Bind();
-
-    // Set texture. Only one texture per mesh component atm.
-    mesh.texture.SetSlot(0);
-
-    // Update uniforms in the shader program
-    shader_program.SetMat4("model", glm::value_ptr(model));
-    evie::mat4 view = camera_->GetViewMatrix();
-    shader_program.SetMat4("view", glm::value_ptr(view));
-    // view = glm::inverseTranspose(view);
-    // shader_program.SetMat4("inverse_transpose_view", glm::value_ptr(view));
-    // This sets up the projection. What's our FoV? What's our aspect ratio? Fix this to get from camera.
-    constexpr float near_cull = 0.1F;
-    constexpr float far_cull = 1000.0F;
-    evie::mat4 projection =
-      glm::perspective(glm::radians(camera_->field_of_view), window_->GetAspectRatio(), near_cull, far_cull);
-    shader_program.SetMat4("projection", glm::value_ptr(projection));
-
-    glDrawArrays(GL_TRIANGLES, 0, mesh.GetModelIndices());
+    // The draw list is copied, the render thread may still be drawing the previous frame while this one is recorded.
+    StaticDraw draw{ material.shader_program.Get(), material.texture.Get(), material.texture_layer, material.draws };
+    commands.EnqueueDraw([this, draw = std::move(draw)] { DrawStatic(draw); });
   }
-}
\ No newline at end of file
+}
+
+void Renderer::DrawStatic(const StaticDraw& draw) const
+{
+  const evie::mat4 identity(1.0F);
+  draw.shader_program->Use();
+  draw.shader_program->SetMat4("model", glm::value_ptr(identity));
+  if (draw.texture_layer.Valid()) {
+    draw.texture_layer.array->SetSlot(0);
+    draw.shader_program->SetInt("texture_layer", static_cast<int>(draw.texture_layer.layer));
+  } else if (draw.texture != nullptr) {
+    draw.texture->SetSlot(0);
+  }
+  static_geometry_.Draw(draw.draws);
+}
@@ -27,10 +27,13 @@
 #include "evie/logging.h"
 #include "evie/materials.h"
 #include "evie/mouse_events.h"
+#include "evie/resource_manager.h"
 #include "evie/shader.h"
 #include "evie/shader_program.h"
 #include "evie/texture.h"
 #include "evie/types.h"
+#include "evie/uniform_blocks.h"
+#include "evie/uniform_buffer.h"
 #include "evie/vertex_array.h"
 #include "evie/vertex_buffer.h"
 
@@ -107,22 +110,12 @@ private:
       model = glm::scale(model, translate.scale);
 
       // Bind VAO and Shader Program
-      auto& shader_program = mesh.shader_program;
+      auto& shader_program = *mesh.shader_program;
       shader_program.Use();
-      if (shader_program.HasVec3("viewPos")) {
-        shader_program.SetVec3("viewPos", camera_->GetPosition());
-      }
-      mesh.vertex_array.Bind();
+      mesh.mesh->vertex_array.Bind();
 
-      // Update uniforms in the shader program
+      // Update uniforms in the shader program. View and projection are in the Frame uniform block.
       shader_program.SetMat4("model", glm::value_ptr(model));
-      evie::mat4 view = camera_->GetViewMatrix();
-      shader_program.SetMat4("view", glm::value_ptr(view));
-      view = glm::inverseTranspose(view);
-      shader_program.SetMat4("inverse_transpose_view", glm::value_ptr(view));
-      // This sets up the projection. What's our FoV? What's our aspect ratio? Fix this to get from camera.
-      evie::mat4 projection = glm::perspective(glm::radians(camera_->field_of_view), 1920.0f / 1080.0f, 0.1f, 100.0f);
-      shader_program.SetMat4("projection", glm::value_ptr(projection));
 
       glDrawArrays(GL_TRIANGLES, 0, 36);
     }
@@ -138,8 +131,11 @@ private:
 class GameLayer : public evie::Layer
 {
 public:
-  explicit GameLayer(const evie::IInputManager* input_manager, evie::IWindow* window, evie::ECSController* ecs)
-    : input_manager_(input_manager), window_(window), ecs_(ecs)
+  GameLayer(const evie::IInputManager* input_manager,
+    evie::IWindow* window,
+    evie::ECSController* ecs,
+    evie::ResourceManager* resources)
+    : input_manager_(input_manager), window_(window), ecs_(ecs), resources_(resources)
   {}
 
   evie::Error Initialise()
@@ -160,56 +156,87 @@ public:
         R"(C:\Users\willa\devel\Evie\out\install\windows-msvc-debug-developer-mode\assets\textures\ty.png)", true);
     }
     // ----- Shaders -----
+    evie::MeshComponent mesh_component;
+    evie::MeshComponent light_source_mesh_component;
     if (err.Good()) {
-      err = lighting_vertex_shader_.Initialise(R"(C:\Users\willa\devel\Evie\shaders\light_vert_diffuse_shader.vs)");
-    }
-    if (err.Good()) {
-      err = lighting_fragment_shader_.Initialise(R"(C:\Users\willa\devel\Evie\shaders\light_frag_diffuse_shader.fs)");
-    }
-    evie::ShaderProgram shader_program;
-    if (err.Good()) {
-      err = shader_program.Initialise(&lighting_vertex_shader_, &lighting_fragment_shader_);
+      evie::Result<evie::ShaderProgramHandle> shader_program =
+        resources_->LoadShaderProgram(R"(C:\Users\willa\devel\Evie\shaders\light_vert_diffuse_shader.vs)",
+          R"(C:\Users\willa\devel\Evie\shaders\light_frag_diffuse_shader.fs)");
+      if (shader_program.Good()) {
+        mesh_component.shader_program = *shader_program;
+      } else {
+        err = shader_program.Error();
+      }
     }
     // Lightsource shader
-    evie::VertexShader lighting_source_vertex_shader;
-    if (err.Good()) {
-      err =
-        lighting_source_vertex_shader.Initialise(R"(C:\Users\willa\devel\Evie\shaders\light_source_vert_shader.vs)");
-    }
-    evie::FragmentShader lighting_source_fragment_shader;
     if (err.Good()) {
-      err =
-        lighting_source_fragment_shader.Initialise(R"(C:\Users\willa\devel\Evie\shaders\light_source_frag_shader.fs)");
-    }
-    evie::ShaderProgram light_source_shader_program;
-    if (err.Good()) {
-      err = light_source_shader_program.Initialise(&lighting_source_vertex_shader, &lighting_source_fragment_shader);
+      evie::Result<evie::ShaderProgramHandle> light_source_shader_program =
+        resources_->LoadShaderProgram(R"(C:\Users\willa\devel\Evie\shaders\light_source_vert_shader.vs)",
+          R"(C:\Users\willa\devel\Evie\shaders\light_source_frag_shader.fs)");
+      if (light_source_shader_program.Good()) {
+        light_source_mesh_component.shader_program = *light_source_shader_program;
+      } else {
+        err = light_source_shader_program.Error();
+      }
     }
 
     // ----- Initialise Vertex Objects -----
-    // Initialise cube first
-    evie::MeshComponent mesh_component;
-    mesh_component.shader_program = shader_program;
-    evie::VertexBuffer vbuffer;
+    // The cube and the light source share the same mesh.
     if (err.Good()) {
       evie::BufferLayout layout;
       layout.stride = 8;
       layout.type = evie::VertexDataType::Float;
       layout.layout_sizes = { 3, 3, 2 };
-      err = vbuffer.Initialise(evie::default_models::cube_with_normals_and_tex_coords, layout);
+      evie::Result<evie::MeshHandle> mesh =
+        resources_->LoadMesh("default_models::cube_with_normals_and_tex_coords",
+          evie::default_models::cube_with_normals_and_tex_coords,
+          layout);
+      if (mesh.Good()) {
+        mesh_component.mesh = *mesh;
+        light_source_mesh_component.mesh = *mesh;
+      } else {
+        err = mesh.Error();
+      }
     }
 
     if (err.Good()) {
-      mesh_component.vertex_array.Initialise();
-      err = mesh_component.vertex_array.AssociateVertexBuffer(vbuffer);
+      err = frame_buffer_.Initialise<evie::FrameBlock>(evie::FrameBlockBinding);
+    }
+    if (err.Good()) {
+      err = lights_buffer_.Initialise<evie::LightsBlock>(evie::LightsBlockBinding);
     }
 
-    // Initialise light source
-    evie::MeshComponent light_source_mesh_component;
-    light_source_mesh_component.shader_program = light_source_shader_program;
-    light_source_mesh_component.vertex_array.Initialise();
-    // light_source_mesh_component.model_data = mesh_component.model_data;
-    light_source_mesh_component.vertex_array.AssociateVertexBuffer(vbuffer);
+    // ----- Lights -----
+    // Shared by every program that declares the Lights block so they're uploaded once rather than per cube.
+    // Directional light (The Sun!)
+    lights_.directional_light.direction = { 0.0f, -1.0f, 0.0f };
+    lights_.directional_light.ambient = { 0.2f, 0.2f, 0.2f };
+    lights_.directional_light.diffuse = { 0.5f, 0.5f, 0.5f };
+    lights_.directional_light.specular = { 1.0f, 1.0f, 1.0f };
+    for (unsigned int j = 0; j < evie::MaxPointLights; ++j) {
+      auto& point_light = lights_.point_lights[j];
+      point_light.position = pointLightPositions[j];
+      point_light.linear = 0.09f;
+      point_light.quadratic = 0.032f;
+      point_light.constant = 1.0f;
+      point_light.ambient = { 0.1f, 0.1f, 0.1f };
+      point_light.diffuse = { 0.2f, 0.2f, 0.2f };
+      point_light.specular = { 1.0f, 1.0f, 1.0f };
+    }
+    // Spot_light is the flashlight from the camera
+    lights_.spot_light.position = camera_.GetPosition();
+    lights_.spot_light.direction = camera_.GetDirection();
+    lights_.spot_light.cut_off = glm::cos(glm::radians(12.5f));
+    lights_.spot_light.outer_cut_off = glm::cos(glm::radians(15.0f));
+    lights_.spot_light.ambient = { 0.2f, 0.2f, 0.2f };
+    lights_.spot_light.diffuse = { 0.8f, 0.8f, 0.8f };
+    lights_.spot_light.specular = { 1.0f, 1.0f, 1.0f };
+    lights_.spot_light.linear = 0.09f;
+    lights_.spot_light.quadratic = 0.032f;
+    lights_.spot_light.constant = 1.0f;
+    if (err.Good()) {
+      lights_buffer_.Update(lights_);
+    }
 
     // Disable cursor initially
     window_->DisableCursor();
@@ -246,45 +273,16 @@ public:
       }
       if (err.Good()) {
         // Update the color here
-        mesh_component.shader_program.Use();
-        mesh_component.shader_program.SetInt("material.diffuse", 0);
+        mesh_component.shader_program->Use();
+        mesh_component.shader_program->SetInt("material.diffuse", 0);
         diffuse_map_.SetSlot(0);
-        mesh_component.shader_program.SetInt("material.specular", 1);
+        mesh_component.shader_program->SetInt("material.specular", 1);
         specular_map_.SetSlot(1);
-        mesh_component.shader_program.SetInt("material.emission", 2);
+        mesh_component.shader_program->SetInt("material.emission", 2);
         emission_map_.SetSlot(2);
-        mesh_component.shader_program.SetInt("spot_light.image", 3);
+        mesh_component.shader_program->SetInt("spot_light_image", 3);
         nice_.SetSlot(3);
-        // Directional light (The Sun!)
-        mesh_component.shader_program.SetVec3("directional_light.direction", { 0.0f, -1.0f, 0.0f });
-        mesh_component.shader_program.SetVec3("directional_light.ambient", { 0.2f, 0.2f, 0.2f });
-        mesh_component.shader_program.SetVec3("directional_light.diffuse", { 0.5f, 0.5f, 0.5f });
-        mesh_component.shader_program.SetVec3("directional_light.specular", { 1.0f, 1.0f, 1.0f });
-        mesh_component.shader_program.SetFloat("material.shininess", 32.0f);
-        for (unsigned int j = 0; j < 4; ++j) {
-          mesh_component.shader_program.SetVec3(
-            "point_lights[" + std::to_string(j) + "].position", { pointLightPositions[j] });
-          mesh_component.shader_program.SetFloat("point_lights[" + std::to_string(j) + "].linear", 0.09f);
-          mesh_component.shader_program.SetFloat("point_lights[" + std::to_string(j) + "].quadratic", 0.032f);
-          mesh_component.shader_program.SetFloat("point_lights[" + std::to_string(j) + "].constant", 1.0f);
-          mesh_component.shader_program.SetVec3(
-            "point_lights[" + std::to_string(j) + "].ambient", { 0.1f, 0.1f, 0.1f });
-          mesh_component.shader_program.SetVec3(
-            "point_lights[" + std::to_string(j) + "].diffuse", { 0.2f, 0.2f, 0.2f });
-          mesh_component.shader_program.SetVec3(
-            "point_lights[" + std::to_string(j) + "].specular", { 1.0f, 1.0f, 1.0f });
-        }
-        // Spot_light is the flashlight from the camera
-        mesh_component.shader_program.SetVec3("spot_light.position", camera_.GetPosition());
-        mesh_component.shader_program.SetVec3("spot_light.direction", camera_.GetDirection());
-        mesh_component.shader_program.SetFloat("spot_light.cut_off", glm::cos(glm::radians(12.5f)));
-        mesh_component.shader_program.SetFloat("spot_light.outer_cut_off", glm::cos(glm::radians(15.0f)));
-        mesh_component.shader_program.SetVec3("spot_light.ambient", { 0.2f, 0.2f, 0.2f });
-        mesh_component.shader_program.SetVec3("spot_light.diffuse", { 0.8f, 0.8f, 0.8f });
-        mesh_component.shader_program.SetVec3("spot_light.specular", { 1.0f, 1.0f, 1.0f });
-        mesh_component.shader_program.SetFloat("spot_light.linear", 0.09f);
-        mesh_component.shader_program.SetFloat("spot_light.quadratic", 0.032f);
-        mesh_component.shader_program.SetFloat("spot_light.constant", 1.0f);
+        mesh_component.shader_program->SetFloat("material.shininess", 32.0f);
         err = entity->AddComponent(mesh_component_id_, mesh_component);
         cube_entities_.push_back(*entity);
       }
@@ -303,9 +301,9 @@ public:
       if (err.Good()) {
         err = light_entity->AddComponent(mesh_component_id_, light_source_mesh_component);
         auto& light_mesh = light_entity->GetComponent(mesh_component_id_);
-        light_mesh.shader_program.Use();
+        light_mesh.shader_program->Use();
         glm::vec3 lightColor{ 1.0 };
-        light_mesh.shader_program.SetVec3("lightColor", lightColor);
+        light_mesh.shader_program->SetVec3("lightColor", lightColor);
       }
       light_entities_.push_back(*light_entity);
     }
@@ -314,7 +312,19 @@ public:
     return err;
   }
 
-  void OnRender() override { cube_render_->UpdateSystem(0.0F); }
+  void OnRender() override
+  {
+    // Upload the camera once for every draw this frame.
+    evie::FrameBlock frame;
+    frame.view = camera_.GetViewMatrix();
+    frame.inverse_transpose_view = glm::inverseTranspose(frame.view);
+    // This sets up the projection. What's our FoV? What's our aspect ratio? Fix this to get from camera.
+    frame.projection = glm::perspective(glm::radians(camera_.field_of_view), 1920.0f / 1080.0f, 0.1f, 100.0f);
+    frame.view_position = camera_.GetPosition();
+    frame.time = static_cast<float>(glfwGetTime());
+    frame_buffer_.Update(frame);
+    cube_render_->UpdateSystem(0.0F);
+  }
 
   void OnUpdate() override
   {
@@ -340,12 +350,10 @@ public:
     if (input_manager_->IsKeyPressed(evie::KeyCode::D)) {
       camera_.MoveRight(delta_time);
     }
-    for (int i = 0; i < 10; ++i) {
-      auto& mesh_component = cube_entities_[i].GetComponent(mesh_component_id_);
-      mesh_component.shader_program.Use();
-      mesh_component.shader_program.SetVec3("spot_light.position", camera_.GetPosition());
-      mesh_component.shader_program.SetVec3("spot_light.direction", camera_.GetDirection());
-    }
+    // The flashlight follows the camera. One upload covers every cube.
+    lights_.spot_light.position = camera_.GetPosition();
+    lights_.spot_light.direction = camera_.GetDirection();
+    lights_buffer_.Update(lights_);
   }
 
   void OnEvent([[maybe_unused]] evie::Event& event) override
@@ -398,6 +406,8 @@ public:
 
   void Shutdown() override
   {
+    frame_buffer_.Destroy();
+    lights_buffer_.Destroy();
     // Destroy entities
     for (auto& entity : cube_entities_) {
       entity.Destroy();
@@ -410,14 +420,16 @@ public:
 
 private:
   evie::Camera camera_;
-  evie::VertexShader lighting_vertex_shader_;
-  evie::FragmentShader lighting_fragment_shader_;
   evie::VertexArray<> lighting_vertex_array_;
+  evie::UniformBuffer frame_buffer_;
+  evie::UniformBuffer lights_buffer_;
+  evie::LightsBlock lights_;
   float last_frame_ = 0.0f;
   bool cursor_enabled_{ false };
   const evie::IInputManager* input_manager_{ nullptr };
   evie::IWindow* window_{ nullptr };
   evie::ECSController* ecs_{ nullptr };
+  evie::ResourceManager* resources_{ nullptr };
   std::vector<evie::Entity> cube_entities_;
   std::vector<evie::Entity> light_entities_;
   evie::ComponentID<evie::TransformRotationComponent> transform_component_id_{ 0 };
@@ -453,7 +465,7 @@ public:
     ImGui::SetCurrentContext(GetImGuiContext());
     if (err.Good()) {
       APP_INFO("Creating GameLayer");
-      t_layer_ = std::make_unique<GameLayer>(GetInputManager(), GetWindow(), GetECSController());
+      t_layer_ = std::make_unique<GameLayer>(GetInputManager(), GetWindow(), GetECSController(), GetResourceManager());
       APP_INFO("Initialising layer");
       err = t_layer_->Initialise();
       if (err.Good()) {
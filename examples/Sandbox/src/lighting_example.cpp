@@ -24,10 +24,13 @@
 #include "evie/logging.h"
 #include "evie/materials.h"
 #include "evie/mouse_events.h"
+#include "evie/resource_manager.h"
 #include "evie/shader.h"
 #include "evie/shader_program.h"
 #include "evie/texture.h"
 #include "evie/types.h"
+#include "evie/uniform_blocks.h"
+#include "evie/uniform_buffer.h"
 #include "evie/vertex_array.h"
 #include "evie/vertex_buffer.h"
 
@@ -100,20 +103,12 @@ private:
       model = glm::scale(model, translate.scale);
 
       // Bind VAO and Shader Program
-      auto& shader_program = mesh.shader_program;
+      auto& shader_program = *mesh.shader_program;
       shader_program.Use();
-      if (shader_program.HasVec3("viewPos")) {
-        shader_program.SetVec3("viewPos", camera_->GetPosition());
-      }
-      mesh.vertex_array.Bind();
+      mesh.mesh->vertex_array.Bind();
 
-      // Update uniforms in the shader program
+      // Update uniforms in the shader program. View and projection are in the Frame uniform block.
       shader_program.SetMat4("model", glm::value_ptr(model));
-      evie::mat4 view = camera_->GetViewMatrix();
-      shader_program.SetMat4("view", glm::value_ptr(view));
-      // This sets up the projection. What's our FoV? What's our aspect ratio? Fix this to get from camera.
-      evie::mat4 projection = glm::perspective(glm::radians(camera_->field_of_view), 800.0f / 600.0f, 0.1f, 100.0f);
-      shader_program.SetMat4("projection", glm::value_ptr(projection));
 
       glDrawArrays(GL_TRIANGLES, 0, 36);
     }
@@ -128,8 +123,11 @@ private:
 class GameLayer : public evie::Layer
 {
 public:
-  GameLayer(const evie::IInputManager* input_manager, evie::IWindow* window, evie::ECSController* ecs)
-    : input_manager_(input_manager), window_(window), ecs_(ecs)
+  GameLayer(const evie::IInputManager* input_manager,
+    evie::IWindow* window,
+    evie::ECSController* ecs,
+    evie::ResourceManager* resources)
+    : input_manager_(input_manager), window_(window), ecs_(ecs), resources_(resources)
   {}
 
   evie::Error Initialise()
@@ -137,57 +135,51 @@ public:
     // ----- Textures -----
     evie::Error err = evie::Error::OK();
     // ----- Shaders -----
+    evie::MeshComponent mesh_component;
+    evie::MeshComponent light_source_mesh_component;
     if (err.Good()) {
-      err = lighting_vertex_shader_.Initialise("C:\\Users\\willa\\devel\\Evie\\shaders\\light_vert_shader.vs");
-    }
-    if (err.Good()) {
-      err = lighting_fragment_shader_.Initialise("C:\\Users\\willa\\devel\\Evie\\shaders\\light_frag_shader.fs");
-    }
-    evie::ShaderProgram shader_program;
-    if (err.Good()) {
-      err = shader_program.Initialise(&lighting_vertex_shader_, &lighting_fragment_shader_);
+      evie::Result<evie::ShaderProgramHandle> shader_program =
+        resources_->LoadShaderProgram("C:\\Users\\willa\\devel\\Evie\\shaders\\light_vert_shader.vs",
+          "C:\\Users\\willa\\devel\\Evie\\shaders\\light_frag_shader.fs");
+      if (shader_program.Good()) {
+        mesh_component.shader_program = *shader_program;
+      } else {
+        err = shader_program.Error();
+      }
     }
     // Lightsource shader
-    evie::VertexShader lighting_source_vertex_shader;
     if (err.Good()) {
-      err =
-        lighting_source_vertex_shader.Initialise("C:\\Users\\willa\\devel\\Evie\\shaders\\light_source_vert_shader.vs");
-    }
-    evie::FragmentShader lighting_source_fragment_shader;
-    if (err.Good()) {
-      err = lighting_source_fragment_shader.Initialise(
-        "C:\\Users\\willa\\devel\\Evie\\shaders\\light_source_frag_shader.fs");
-    }
-    evie::ShaderProgram light_source_shader_program;
-    if (err.Good()) {
-      err = light_source_shader_program.Initialise(&lighting_source_vertex_shader, &lighting_source_fragment_shader);
+      evie::Result<evie::ShaderProgramHandle> light_source_shader_program =
+        resources_->LoadShaderProgram("C:\\Users\\willa\\devel\\Evie\\shaders\\light_source_vert_shader.vs",
+          "C:\\Users\\willa\\devel\\Evie\\shaders\\light_source_frag_shader.fs");
+      if (light_source_shader_program.Good()) {
+        light_source_mesh_component.shader_program = *light_source_shader_program;
+      } else {
+        err = light_source_shader_program.Error();
+      }
     }
 
     // ----- Initialise Vertex Objects -----
-    // Initialise cube first
-    evie::MeshComponent mesh_component;
-    mesh_component.shader_program = shader_program;
-    evie::VertexBuffer vbuffer;
+    // The cube and the light source share the same mesh.
     if (err.Good()) {
       evie::BufferLayout layout;
       layout.stride = 6;
       layout.type = evie::VertexDataType::Float;
       layout.layout_sizes = { 3, 3 };
-      err = vbuffer.Initialise(evie::default_models::cube_with_normals, layout);
+      evie::Result<evie::MeshHandle> mesh =
+        resources_->LoadMesh("default_models::cube_with_normals", evie::default_models::cube_with_normals, layout);
+      if (mesh.Good()) {
+        mesh_component.mesh = *mesh;
+        light_source_mesh_component.mesh = *mesh;
+      } else {
+        err = mesh.Error();
+      }
     }
 
     if (err.Good()) {
-      mesh_component.vertex_array.Initialise();
-      err = mesh_component.vertex_array.AssociateVertexBuffer(vbuffer);
+      err = frame_buffer_.Initialise<evie::FrameBlock>(evie::FrameBlockBinding);
     }
 
-    // Initialise light source
-    evie::MeshComponent light_source_mesh_component;
-    light_source_mesh_component.shader_program = light_source_shader_program;
-    light_source_mesh_component.vertex_array.Initialise();
-    // light_source_mesh_component.model_data = mesh_component.model_data;
-    light_source_mesh_component.vertex_array.AssociateVertexBuffer(vbuffer);
-
     // Disable cursor initially
     window_->DisableCursor();
 
@@ -224,24 +216,24 @@ public:
     }
     if (err.Good()) {
       // Update the color here
-      mesh_component.shader_program.Use();
-      // mesh_component.shader_program.SetVec3("material.ambient", { 1.0f, 0.5f, 0.31f });
-      // mesh_component.shader_program.SetVec3("material.diffuse", { 1.0f, 0.5f, 0.31f });
-      // mesh_component.shader_program.SetVec3("material.specular", { 0.5f, 0.5f, 0.5f });
-      // mesh_component.shader_program.SetVec3("material.ambient", { 0.19225f, 0.19225f, 0.19225f });
-      // mesh_component.shader_program.SetVec3("material.diffuse", { 0.50754f, 0.50754f, 0.5074f });
-      // mesh_component.shader_program.SetVec3("material.specular", { 0.508723f, 0.508723f, 0.508723f });
-      // mesh_component.shader_program.SetFloat("material.shininess", 51.2f);
+      mesh_component.shader_program->Use();
+      // mesh_component.shader_program->SetVec3("material.ambient", { 1.0f, 0.5f, 0.31f });
+      // mesh_component.shader_program->SetVec3("material.diffuse", { 1.0f, 0.5f, 0.31f });
+      // mesh_component.shader_program->SetVec3("material.specular", { 0.5f, 0.5f, 0.5f });
+      // mesh_component.shader_program->SetVec3("material.ambient", { 0.19225f, 0.19225f, 0.19225f });
+      // mesh_component.shader_program->SetVec3("material.diffuse", { 0.50754f, 0.50754f, 0.5074f });
+      // mesh_component.shader_program->SetVec3("material.specular", { 0.508723f, 0.508723f, 0.508723f });
+      // mesh_component.shader_program->SetFloat("material.shininess", 51.2f);
       // gold	0.24725	0.1995	0.0745	0.75164	0.60648	0.22648	0.628281	0.555802	0.366065	0.4
-      mesh_component.shader_program.SetVec3("material.ambient", current_material_index_.second.ambient);
-      mesh_component.shader_program.SetVec3("material.diffuse", current_material_index_.second.diffuse);
-      mesh_component.shader_program.SetVec3("material.specular", current_material_index_.second.specular);
-      mesh_component.shader_program.SetFloat("material.shininess", current_material_index_.second.shininess);
-      mesh_component.shader_program.SetVec3("lightPos", light_pos);
-      mesh_component.shader_program.SetVec3("light.position", light_pos);
-      mesh_component.shader_program.SetVec3("light.ambient", { 0.5f, 0.5f, 0.5f });
-      mesh_component.shader_program.SetVec3("light.diffuse", { 0.5f, 0.5f, 0.5f });
-      mesh_component.shader_program.SetVec3("light.specular", { 1.0f, 1.0f, 1.0f });
+      mesh_component.shader_program->SetVec3("material.ambient", current_material_index_.second.ambient);
+      mesh_component.shader_program->SetVec3("material.diffuse", current_material_index_.second.diffuse);
+      mesh_component.shader_program->SetVec3("material.specular", current_material_index_.second.specular);
+      mesh_component.shader_program->SetFloat("material.shininess", current_material_index_.second.shininess);
+      mesh_component.shader_program->SetVec3("lightPos", light_pos);
+      mesh_component.shader_program->SetVec3("light.position", light_pos);
+      mesh_component.shader_program->SetVec3("light.ambient", { 0.5f, 0.5f, 0.5f });
+      mesh_component.shader_program->SetVec3("light.diffuse", { 0.5f, 0.5f, 0.5f });
+      mesh_component.shader_program->SetVec3("light.specular", { 1.0f, 1.0f, 1.0f });
 
       err = entity->AddComponent(mesh_component_id_, mesh_component);
     }
@@ -286,6 +278,14 @@ public:
       }
       ImGui::End();
     }
+    // Upload the camera once for every draw this frame.
+    evie::FrameBlock frame;
+    frame.view = camera_.GetViewMatrix();
+    // This sets up the projection. What's our FoV? What's our aspect ratio? Fix this to get from camera.
+    frame.projection = glm::perspective(glm::radians(camera_.field_of_view), 800.0f / 600.0f, 0.1f, 100.0f);
+    frame.view_position = camera_.GetPosition();
+    frame.time = static_cast<float>(glfwGetTime());
+    frame_buffer_.Update(frame);
     cube_render_->UpdateSystem(0.0F);
   }
 
@@ -305,12 +305,12 @@ public:
 
     // Update cube entity with new light position
     auto& mesh = cube_entity_->GetComponent(mesh_component_id_);
-    mesh.shader_program.Use();
-    mesh.shader_program.SetVec3("lightPos", light_transform.position);
-    mesh.shader_program.SetVec3("material.ambient", current_material_index_.second.ambient);
-    mesh.shader_program.SetVec3("material.diffuse", current_material_index_.second.diffuse);
-    mesh.shader_program.SetVec3("material.specular", current_material_index_.second.specular);
-    mesh.shader_program.SetFloat("material.shininess", current_material_index_.second.shininess);
+    mesh.shader_program->Use();
+    mesh.shader_program->SetVec3("lightPos", light_transform.position);
+    mesh.shader_program->SetVec3("material.ambient", current_material_index_.second.ambient);
+    mesh.shader_program->SetVec3("material.diffuse", current_material_index_.second.diffuse);
+    mesh.shader_program->SetVec3("material.specular", current_material_index_.second.specular);
+    mesh.shader_program->SetFloat("material.shininess", current_material_index_.second.shininess);
     glm::vec3 lightColor{ 1.0 };
     // lightColor.x = sin(glfwGetTime() * 2.0f);
     // lightColor.y = sin(glfwGetTime() * 0.7f);
@@ -319,12 +319,12 @@ public:
     glm::vec3 diffuseColor = lightColor * glm::vec3(1.0f);
     glm::vec3 ambientColor = diffuseColor * glm::vec3(1.0f);
 
-    mesh.shader_program.SetVec3("light.ambient", ambientColor);
-    mesh.shader_program.SetVec3("light.diffuse", diffuseColor);
+    mesh.shader_program->SetVec3("light.ambient", ambientColor);
+    mesh.shader_program->SetVec3("light.diffuse", diffuseColor);
 
     auto& light_mesh = light_entity_->GetComponent(mesh_component_id_);
-    light_mesh.shader_program.Use();
-    light_mesh.shader_program.SetVec3("lightColor", lightColor);
+    light_mesh.shader_program->Use();
+    light_mesh.shader_program->SetVec3("lightColor", lightColor);
 
     // Handle camera translation
     if (input_manager_->IsKeyPressed(evie::KeyCode::W)) {
@@ -391,6 +391,7 @@ public:
 
   void Shutdown() override
   {
+    frame_buffer_.Destroy();
     // Destroy entities
     for (auto& entity : cube_entities_) {
       entity.Destroy();
@@ -400,14 +401,14 @@ public:
 
 private:
   evie::Camera camera_;
-  evie::VertexShader lighting_vertex_shader_;
-  evie::FragmentShader lighting_fragment_shader_;
   evie::VertexArray<> lighting_vertex_array_;
+  evie::UniformBuffer frame_buffer_;
   float last_frame_ = 0.0f;
   bool cursor_enabled_{ false };
   const evie::IInputManager* input_manager_{ nullptr };
   evie::IWindow* window_{ nullptr };
   evie::ECSController* ecs_{ nullptr };
+  evie::ResourceManager* resources_{ nullptr };
   std::vector<evie::Entity> cube_entities_;
   evie::ComponentID<evie::TransformRotationComponent> transform_component_id_{ 0 };
   evie::ComponentID<evie::VelocityComponent> velocity_component_id_{ 0 };
@@ -438,7 +439,7 @@ public:
     ImGui::SetCurrentContext(GetImGuiContext());
     if (err.Good()) {
       APP_INFO("Creating GameLayer");
-      t_layer_ = std::make_unique<GameLayer>(GetInputManager(), GetWindow(), GetECSController());
+      t_layer_ = std::make_unique<GameLayer>(GetInputManager(), GetWindow(), GetECSController(), GetResourceManager());
       APP_INFO("Initialising layer");
       err = t_layer_->Initialise();
       if (err.Good()) {
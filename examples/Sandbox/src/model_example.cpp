@@ -17,9 +17,13 @@
 #include <evie/input_manager.h>
 #include <evie/key_events.h>
 #include <evie/mouse_events.h>
+#include <evie/resource_manager.h>
 #include <evie/shader.h>
 #include <evie/shader_program.h>
 #include <evie/texture.h>
+#include <evie/thread_pool.h>
+#include <evie/uniform_blocks.h>
+#include <evie/uniform_buffer.h>
 #include <evie/vertex_buffer.h>
 #include <evie/window.h>
 #include <glm/ext/quaternion_trigonometric.hpp>
@@ -34,8 +38,10 @@
 class ModelExample final : public evie::Layer
 {
 public:
-  evie::Error
-    Initialise(evie::IInputManager* input_manager, evie::ECSController* ecs_controller, evie::IWindow* window);
+  evie::Error Initialise(evie::IInputManager* input_manager,
+    evie::ECSController* ecs_controller,
+    evie::IWindow* window,
+    evie::ThreadPool* workers);
   void OnUpdate() override;
   void OnRender() override;
   void OnEvent(evie::Event& event) override;
@@ -61,6 +67,10 @@ private:
   // Show cursor
   bool enable_cursor_{ false };
 
+  // Per frame camera data and the scene's lights, shared by every program through their uniform blocks.
+  evie::UniformBuffer frame_buffer_;
+  evie::UniformBuffer lights_buffer_;
+
   // Testing - REMOVE
   evie::ShaderProgram model_prog;
   evie::Model backpack_model{
@@ -70,7 +80,8 @@ private:
 
 evie::Error ModelExample::Initialise(evie::IInputManager* input_manager,
   evie::ECSController* ecs_controller,
-  evie::IWindow* window)
+  evie::IWindow* window,
+  evie::ThreadPool* workers)
 {
   evie::Error err = evie::Error::OK();
   // Initialise our variables
@@ -111,7 +122,24 @@ evie::Error ModelExample::Initialise(evie::IInputManager* input_manager,
   }
 
   if (err.Good()) {
-    err = backpack_model.Initialise();
+    err = backpack_model.Initialise(workers);
+  }
+
+  if (err.Good()) {
+    err = frame_buffer_.Initialise<evie::FrameBlock>(evie::FrameBlockBinding);
+  }
+
+  // The lights don't move so they're uploaded once.
+  if (err.Good()) {
+    err = lights_buffer_.Initialise<evie::LightsBlock>(evie::LightsBlockBinding);
+  }
+  if (err.Good()) {
+    evie::LightsBlock lights;
+    lights.directional_light.direction = { 0.0f, -1.0f, 0.0f };
+    lights.directional_light.ambient = { 0.5f, 0.5f, 0.5f };
+    lights.directional_light.diffuse = { 0.5f, 0.5f, 0.5f };
+    lights.directional_light.specular = { 1.0f, 1.0f, 1.0f };
+    lights_buffer_.Update(lights);
   }
 
   return err;
@@ -143,31 +171,25 @@ void ModelExample::OnRender()
   // Bind VAO and Shader Program
   // auto& shader_program = mesh.shader_program;
   // shader_program.Use();
-  if (model_prog.HasVec3("viewPos")) {
-    model_prog.SetVec3("viewPos", camera_.GetPosition());
-  }
   // mesh.vertex_array.Bind();
 
   // Set texture. Only one texture per mesh component atm.
   // mesh.texture.SetSlot(0);
-  model_prog.SetVec3("directional_light.direction", { 0.0f, -1.0f, 0.0f });
-  model_prog.SetVec3("directional_light.ambient", { 0.5f, 0.5f, 0.5f });
-  model_prog.SetVec3("directional_light.diffuse", { 0.5f, 0.5f, 0.5f });
-  model_prog.SetVec3("directional_light.specular", { 1.0f, 1.0f, 1.0f });
   model_prog.SetFloat("material.shininess", 225.0F);
 
   // Update uniforms in the shader program
   model_prog.SetMat4("model", glm::value_ptr(model));
-  evie::mat4 view = camera_.GetViewMatrix();
-  model_prog.SetMat4("view", glm::value_ptr(view));
-  view = glm::inverseTranspose(view);
-  model_prog.SetMat4("inverse_transpose_view", glm::value_ptr(view));
+  evie::FrameBlock frame;
+  frame.view = camera_.GetViewMatrix();
+  frame.inverse_transpose_view = glm::inverseTranspose(frame.view);
   // This sets up the projection. What's our FoV? What's our aspect ratio? Fix this to get from camera.
   constexpr float near_cull = 0.1F;
   constexpr float far_cull = 1000.0F;
-  evie::mat4 projection =
+  frame.projection =
     glm::perspective(glm::radians(camera_.field_of_view), window_->GetAspectRatio(), near_cull, far_cull);
-  model_prog.SetMat4("projection", glm::value_ptr(projection));
+  frame.view_position = camera_.GetPosition();
+  frame.time = static_cast<float>(glfwGetTime());
+  frame_buffer_.Update(frame);
   backpack_model.Draw(model_prog);
 }
 
@@ -233,7 +255,8 @@ public:
       APP_INFO("Creating GameLayer");
       t_layer_ = std::make_unique<ModelExample>();
       APP_INFO("Initialising layer");
-      err = t_layer_->Initialise(GetInputManager(), GetECSController(), GetWindow());
+      err = t_layer_->Initialise(
+        GetInputManager(), GetECSController(), GetWindow(), GetResourceManager()->GetWorkers());
       if (err.Good()) {
         APP_INFO("Pushing layer");
         PushLayerFront(*t_layer_);
@@ -27,6 +27,8 @@
 #include "evie/shader_program.h"
 #include "evie/texture.h"
 #include "evie/types.h"
+#include "evie/uniform_blocks.h"
+#include "evie/uniform_buffer.h"
 #include "evie/vertex_array.h"
 #include "evie/vertex_buffer.h"
 
@@ -87,12 +89,8 @@ private:
           glm::rotate(model, static_cast<float>(glfwGetTime()) * glm::radians(50.0f), evie::vec3(1.0f, 0.3f, 0.5f));
       }
       i++;
+      // View and projection are in the Frame uniform block, uploaded once in GameLayer::OnRender.
       shader_program_->SetMat4("model", glm::value_ptr(model));
-      evie::mat4 view = camera_->GetViewMatrix();
-      shader_program_->SetMat4("view", glm::value_ptr(view));
-      // This sets up the projection. What's our FoV? What's our aspect ratio?
-      evie::mat4 projection = glm::perspective(glm::radians(camera_->field_of_view), 800.0f / 600.0f, 0.1f, 100.0f);
-      shader_program_->SetMat4("projection", glm::value_ptr(projection));
       glDrawArrays(GL_TRIANGLES, 0, 36);
     }
   }
@@ -152,6 +150,9 @@ public:
       vertex_array_.Initialise();
       err = vertex_array_.AssociateVertexBuffer(vertex_buffer_);
     }
+    if (err.Good()) {
+      err = frame_buffer_.Initialise<evie::FrameBlock>(evie::FrameBlockBinding);
+    }
 
     // Disable cursor initially
     window_->DisableCursor();
@@ -206,6 +207,15 @@ public:
 
   void OnRender() override
   {
+    // Upload the camera once for every draw this frame.
+    evie::FrameBlock frame;
+    frame.view = camera_.GetViewMatrix();
+    // This sets up the projection. What's our FoV? What's our aspect ratio?
+    frame.projection = glm::perspective(glm::radians(camera_.field_of_view), 800.0f / 600.0f, 0.1f, 100.0f);
+    frame.view_position = camera_.GetPosition();
+    frame.time = static_cast<float>(glfwGetTime());
+    frame_buffer_.Update(frame);
+    shader_program_.Use();
     // Update mixer for shader
     shader_program_.SetFloat("mixer", mixer_);
     // Bind the Vertex Array that associates our cube models
@@ -303,6 +313,7 @@ public:
     indices_array_.Destroy();
     vertex_buffer_.Destroy();
     shader_program_.Destroy();
+    frame_buffer_.Destroy();
     container_texture_.Destroy();
     face_texture_.Destroy();
     // Destroy entities
@@ -322,6 +333,7 @@ private:
   evie::VertexBuffer<> vertex_buffer_;
   evie::IndicesArray indices_array_;
   evie::VertexArray<> vertex_array_;
+  evie::UniformBuffer frame_buffer_;
   float last_frame_ = 0.0f;
   float mixer_{ 0.2f };
   bool cursor_enabled_{ false };
@@ -1,14 +1,20 @@
 #ifndef EVIE_APPLICATION_H_
 #define EVIE_APPLICATION_H_
 
+#include <cstdint>
 #include <imgui_internal.h>
 #include <memory>
+#include <string>
 
 #include "evie/core.h"
 #include "evie/ecs/ecs_controller.hpp"
 #include "evie/error.h"
+#include "evie/fixed_timestep.h"
+#include "evie/frame_pacer.h"
+#include "evie/gpu_profiler.h"
 #include "evie/input_manager.h"
 #include "evie/layer.h"
+#include "evie/resource_manager.h"
 #include "evie/types.h"
 #include "evie/window.h"
 
@@ -24,9 +30,55 @@ public:
   virtual ~Application();
 
   void Run();
+  /**
+   * @brief Replay rendering on a thread of its own so the next frame's update overlaps this frame's GL submission. Call
+   * between Initialise() and Run().
+   *
+   * Layers then record into OnRecord() instead of OnRender() and must not call GL from the simulation thread, GL work
+   * such as uploads goes through CommandList::Enqueue() and EnqueueDraw(). Released resources are collected between frames so don't drop
+   * the last handle to something in OnRecord(). ImGui isn't drawn in this mode.
+   */
+  void EnableRenderThread();
+  // How many times a second Layer::OnFixedUpdate() runs, independent of the frame rate. Defaults to 60.
+  void SetFixedTickRate(double ticks_per_second);
+  // Frames that would need more fixed updates than this drop the excess time instead, so a slow simulation can't
+  // keep falling further behind. Defaults to 5.
+  void SetMaxFixedStepsPerFrame(uint32_t max_steps);
+  // Timing of the frame being updated, including the interpolation alpha for rendering between fixed updates.
+  [[nodiscard]] const FrameTime& GetFrameTime() const;
+  // Cap the frame rate, sleeping away the rest of each frame rather than spinning. Zero, the default, is uncapped.
+  // Combines with vsync, whichever is slower wins.
+  void SetTargetFrameRate(double frames_per_second);
+  // Change the swap interval chosen in WindowProperties. With the render thread enabled only call this before Run().
+  void SetVSync(VSyncMode mode);
+  // Time between the end of each of the last few hundred frames, including any pacing.
+  [[nodiscard]] const FrameTimeHistory& GetFrameTimeHistory() const;
+  /**
+   * @brief Time each frame, each layer's rendering and the render queue on the GPU. Call between Initialise() and
+   * Run(). Layers can add zones of their own with EV_PROFILE_GPU_SCOPE(*GetGpuProfiler(), ...). Results arrive a few
+   * frames late, see GpuProfiler. With the render thread enabled only use it from the render thread, e.g. in a
+   * CommandList task. Does nothing if Evie was built without EVIE_PROFILING.
+   */
+  void EnableGpuProfiling();
+  [[nodiscard]] GpuProfiler* GetGpuProfiler() const;
+  // Where F4 and StartProfilerCapture() write the trace unless told otherwise.
+  static constexpr const char* DefaultTracePath = "evie_trace.json";
+  /**
+   * @brief Record profiler zones from every thread until StopProfilerCapture() or Shutdown(), then write them to path
+   * as a Chrome trace. F4 starts and stops a capture, and setting the EVIE_PROFILE_CAPTURE environment variable to a
+   * path captures from Initialise() to Shutdown(). Does nothing if Evie was built without EVIE_PROFILING.
+   */
+  void StartProfilerCapture(const std::string& path = DefaultTracePath);
+  // Stop the capture and write its trace. Does nothing if no capture is running.
+  void StopProfilerCapture();
+  [[nodiscard]] bool IsProfilerCapturing() const;
+  // Show or hide the ImGui performance overlay, which F3 also toggles. Hidden by default. Not drawn with the render
+  // thread enabled.
+  void SetPerformanceOverlayVisible(bool visible);
   [[nodiscard]] Error Initialise(const WindowProperties& props);
   [[nodiscard]] IInputManager* GetInputManager() const;
   [[nodiscard]] ECSController* GetECSController() const;
+  [[nodiscard]] ResourceManager* GetResourceManager() const;
   [[nodiscard]] IWindow* GetWindow() const;
   [[nodiscard]] ImGuiContext* GetImGuiContext() const;
   void PushLayerFront(Layer& layer);
@@ -43,8 +95,17 @@ private:
 
   // These are fine to expose
   void CloseWindow() { running_ = false; }
+  void RunRenderThread();
+  // Advance the frame clock, then run the fixed updates that are due followed by every layer's OnUpdate().
+  void UpdateLayers();
+  // Move profiler zones out of the per thread rings while a capture is running.
+  void FlushProfiler();
+  // On the thread that owns the context, if EnableGpuProfiling() was called.
+  void InitialiseGpuProfiler();
   bool running_{ true };
   bool initialised_{ false };
+  bool render_thread_enabled_{ false };
+  bool gpu_profiling_enabled_{ false };
 };
 }// namespace evie
 
@@ -0,0 +1,112 @@
+#ifndef EVIE_INCLUDE_ASYNC_TEXTURE_LOADER_H_
+#define EVIE_INCLUDE_ASYNC_TEXTURE_LOADER_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "evie/baked_texture.h"
+#include "evie/core.h"
+#include "evie/error.h"
+#include "evie/result.h"
+#include "evie/texture.h"
+#include "evie/thread_pool.h"
+
+namespace evie {
+
+/**
+ * @brief Loads textures without blocking the frame. Image files are read and decoded on worker threads, then
+ * Update() uploads the decoded images on the GL thread through pixel buffer objects, stopping once its time budget is
+ * spent so a burst of loads is spread over several frames.
+ *
+ * Baked textures skip decoding, the workers only map and check them and the levels are uploaded from the mapping.
+ *
+ * Until its upload happens a texture is a copy of the placeholder, so it can be bound and drawn straight away.
+ */
+class EVIE_API AsyncTextureLoader
+{
+public:
+  // Called on the GL thread once the texture has been uploaded, or with an error if it couldn't be loaded.
+  using OnLoaded = std::function<void(Result<Texture2D>)>;
+
+  // How long Update() spends uploading by default.
+  static constexpr std::chrono::microseconds DefaultBudget{ 2000 };
+
+  // Create the placeholder and start the workers. Must be called on the GL thread.
+  Error Initialise(size_t worker_count = ThreadPool::DefaultWorkerCount());
+
+  /**
+   * @brief Queue a file to be decoded on a worker thread. Without workers, i.e. before Initialise() or after
+   * Destroy(), the file is decoded straight away on the calling thread instead.
+   *
+   * @param on_loaded Called from a later Update() with the uploaded texture.
+   */
+  void Load(const std::string& path, bool flip, TextureWrapping wrapping, OnLoaded on_loaded);
+
+  /**
+   * @brief Upload decoded images until the budget is spent. At least one is uploaded per call so loading always
+   * makes progress. Call once per frame on the GL thread.
+   *
+   * @return size_t Number of textures finished.
+   */
+  size_t Update(std::chrono::microseconds budget = DefaultBudget);
+
+  // Stop the workers, dropping loads that haven't finished, and delete the placeholder and staging buffers.
+  void Destroy();
+
+  // A small checkerboard to bind while the real texture loads.
+  [[nodiscard]] const Texture2D& GetPlaceholder() const { return placeholder_; }
+  [[nodiscard]] bool IsPlaceholder(const Texture2D& texture) const
+  {
+    return texture.GetID().Get() != 0 && texture.GetID() == placeholder_.GetID();
+  }
+  // Loads that have been queued but not finished.
+  [[nodiscard]] size_t GetPendingCount() const { return pending_.size(); }
+  // Null before Initialise() and after Destroy().
+  [[nodiscard]] ThreadPool* GetWorkers() const { return workers_.get(); }
+
+private:
+  struct PendingLoad
+  {
+    uint64_t id{ 0 };
+    std::string path;
+    TextureWrapping wrapping{ TextureWrapping::Repeat };
+    OnLoaded on_loaded;
+  };
+
+  struct DecodedLoad
+  {
+    uint64_t id{ 0 };
+    Error error{ Error::OK() };
+    DecodedImage image;
+    // Set instead of image for baked textures, which only need mapping and checking.
+    std::optional<BakedTexture> baked;
+  };
+
+  Result<Texture2D> Upload(const PendingLoad& load, const DecodedImage& image);
+  static Result<Texture2D> UploadBaked(const PendingLoad& load, const BakedTexture& baked);
+
+  // Owned by the GL thread.
+  std::vector<PendingLoad> pending_;
+  uint64_t next_id_{ 1 };
+  // Filled by the workers.
+  std::mutex decoded_mutex_;
+  std::vector<DecodedLoad> decoded_;
+  // Alternated between uploads so a new upload doesn't have to wait for the driver to finish reading the last one.
+  std::array<unsigned int, 2> staging_buffers_{};
+  size_t next_staging_buffer_{ 0 };
+  Texture2D placeholder_;
+  // Declared last so it's destroyed first, joining the workers before anything they write to goes away.
+  std::unique_ptr<ThreadPool> workers_;
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_ASYNC_TEXTURE_LOADER_H_
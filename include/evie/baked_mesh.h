@@ -0,0 +1,166 @@
+#ifndef EVIE_INCLUDE_BAKED_MESH_H_
+#define EVIE_INCLUDE_BAKED_MESH_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "evie/core.h"
+#include "evie/error.h"
+#include "evie/mapped_file.h"
+#include "evie/result.h"
+#include "evie/texture.h"
+
+namespace evie {
+
+/**
+ * Baked meshes are produced offline by the mesh baker tool from anything Assimp can import. Loading one needs no
+ * Assimp, the file is mapped and the vertex and index streams uploaded straight from the mapping.
+ *
+ * Layout, all little endian, each section starting on a 16 byte boundary:
+ *   BakedMeshHeader
+ *   BakedVertex[vertex_count]
+ *   uint32_t[index_count], relative to their submesh's base_vertex
+ *   BakedSubmesh[submesh_count]
+ *   BakedMaterial[material_count]
+ *   BakedMaterialTexture[texture_count]
+ *   char[string_bytes], texture paths relative to the mesh file, not null terminated
+ */
+
+// Files with this extension are loaded as baked meshes by Model.
+inline constexpr std::string_view BakedMeshExtension = ".evmesh";
+inline constexpr std::array<char, 4> BakedMeshMagic = { 'E', 'V', 'M', 'S' };
+inline constexpr uint32_t BakedMeshVersion = 2;
+
+struct BakedMeshHeader
+{
+  std::array<char, 4> magic{ BakedMeshMagic };
+  uint32_t version{ BakedMeshVersion };
+  uint32_t vertex_count{ 0 };
+  uint32_t index_count{ 0 };
+  uint32_t submesh_count{ 0 };
+  uint32_t material_count{ 0 };
+  uint32_t texture_count{ 0 };
+  uint32_t string_bytes{ 0 };
+};
+
+// Matches the Vertex used by Mesh.
+struct BakedVertex
+{
+  std::array<float, 3> position{};
+  std::array<float, 3> normal{};
+  std::array<float, 2> tex_coords{};
+};
+
+struct BakedSubmesh
+{
+  uint32_t first_index{ 0 };
+  uint32_t index_count{ 0 };
+  uint32_t base_vertex{ 0 };
+  uint32_t vertex_count{ 0 };
+  uint32_t material{ 0 };
+};
+
+struct BakedMaterial
+{
+  uint32_t first_texture{ 0 };
+  uint32_t texture_count{ 0 };
+  float shininess{ 0.0F };
+};
+
+struct BakedMaterialTexture
+{
+  TextureType type{ TextureType::Diffuse };
+  uint32_t path_offset{ 0 };
+  uint32_t path_length{ 0 };
+};
+
+static_assert(sizeof(BakedMeshHeader) == 32);
+static_assert(sizeof(BakedVertex) == 32);
+static_assert(sizeof(BakedSubmesh) == 20);
+static_assert(sizeof(BakedMaterial) == 12);
+static_assert(sizeof(BakedMaterialTexture) == 12);
+
+[[nodiscard]] inline bool IsBakedMesh(std::string_view path) { return path.ends_with(BakedMeshExtension); }
+
+// A mesh as it comes out of the importer, before baking.
+struct MeshSource
+{
+  struct Submesh
+  {
+    std::vector<BakedVertex> vertices;
+    std::vector<uint32_t> indices;
+    uint32_t material{ 0 };
+  };
+
+  struct MaterialTexture
+  {
+    TextureType type{ TextureType::Diffuse };
+    std::string path;
+  };
+
+  struct Material
+  {
+    float shininess{ 0.0F };
+    std::vector<MaterialTexture> textures;
+  };
+
+  std::vector<Submesh> submeshes;
+  std::vector<Material> materials;
+};
+
+/**
+ * @brief Import a model with Assimp the same way Model does: triangulated, UVs flipped, submeshes in node order and
+ * diffuse then specular textures for each material.
+ */
+EVIE_API Result<MeshSource> ImportMesh(const std::string& path);
+
+// Lay the mesh out as a baked mesh file. Returns the bytes ready to be written out.
+EVIE_API Result<std::vector<unsigned char>> BakeMesh(const MeshSource& source);
+
+// A baked mesh file mapped into memory. The spans point into the mapping so keep this alive while using them.
+class EVIE_API BakedMesh
+{
+public:
+  // Map the file and check every table and index is in range. Doesn't touch GL so it's safe to call from any thread.
+  static Result<BakedMesh> Open(const std::string& path);
+
+  [[nodiscard]] const BakedMeshHeader& GetHeader() const { return header_; }
+  [[nodiscard]] std::span<const BakedVertex> GetVertices() const { return vertices_; }
+  [[nodiscard]] std::span<const uint32_t> GetIndices() const { return indices_; }
+  [[nodiscard]] std::span<const BakedSubmesh> GetSubmeshes() const { return submeshes_; }
+  [[nodiscard]] std::span<const BakedMaterial> GetMaterials() const { return materials_; }
+  [[nodiscard]] std::span<const BakedMaterialTexture> GetTextures() const { return textures_; }
+  [[nodiscard]] std::string_view GetTexturePath(const BakedMaterialTexture& texture) const
+  {
+    return strings_.substr(texture.path_offset, texture.path_length);
+  }
+
+  // The vertices and indices of one submesh, ready to upload.
+  [[nodiscard]] std::span<const BakedVertex> GetVertices(const BakedSubmesh& submesh) const
+  {
+    return vertices_.subspan(submesh.base_vertex, submesh.vertex_count);
+  }
+  [[nodiscard]] std::span<const uint32_t> GetIndices(const BakedSubmesh& submesh) const
+  {
+    return indices_.subspan(submesh.first_index, submesh.index_count);
+  }
+
+private:
+  MappedFile file_;
+  BakedMeshHeader header_;
+  std::span<const BakedVertex> vertices_;
+  std::span<const uint32_t> indices_;
+  std::span<const BakedSubmesh> submeshes_;
+  std::span<const BakedMaterial> materials_;
+  std::span<const BakedMaterialTexture> textures_;
+  std::string_view strings_;
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_BAKED_MESH_H_
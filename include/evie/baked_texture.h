@@ -0,0 +1,119 @@
+#ifndef EVIE_INCLUDE_BAKED_TEXTURE_H_
+#define EVIE_INCLUDE_BAKED_TEXTURE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "evie/core.h"
+#include "evie/error.h"
+#include "evie/mapped_file.h"
+#include "evie/result.h"
+#include "evie/texture.h"
+
+namespace evie {
+
+/**
+ * Baked textures are produced offline by the texture baker tool so loading one needs no image decoding or mipmap
+ * generation, the file is mapped and each level handed straight to GL.
+ *
+ * Layout, all little endian:
+ *   BakedTextureHeader
+ *   BakedMipLevel[mip_count], largest first
+ *   Level data at the offsets in the mip table
+ */
+
+// Files with this extension are loaded as baked textures by Texture2D::Initialise().
+inline constexpr std::string_view BakedTextureExtension = ".evtex";
+inline constexpr std::array<char, 4> BakedTextureMagic = { 'E', 'V', 'T', 'X' };
+inline constexpr uint32_t BakedTextureVersion = 2;
+
+enum class BakedTextureFormat : uint32_t {
+  RGB8,
+  RGBA8,
+  // 4x4 blocks of 8 bytes, 6:1 against RGB8. Alpha is dropped.
+  BC1,
+  // 4x4 blocks of 16 bytes, 4:1 against RGBA8.
+  BC3
+};
+
+struct BakedTextureHeader
+{
+  std::array<char, 4> magic{ BakedTextureMagic };
+  uint32_t version{ BakedTextureVersion };
+  BakedTextureFormat format{ BakedTextureFormat::RGBA8 };
+  uint32_t width{ 0 };
+  uint32_t height{ 0 };
+  uint32_t mip_count{ 0 };
+  // Non zero if the image was flipped vertically before baking. Loading can't undo or redo it.
+  uint32_t flipped{ 0 };
+};
+
+struct BakedMipLevel
+{
+  uint32_t width{ 0 };
+  uint32_t height{ 0 };
+  // From the start of the file.
+  uint64_t offset{ 0 };
+  uint64_t size{ 0 };
+};
+
+static_assert(sizeof(BakedTextureHeader) == 28);
+static_assert(sizeof(BakedMipLevel) == 24);
+
+[[nodiscard]] inline bool IsBakedTexture(std::string_view path) { return path.ends_with(BakedTextureExtension); }
+
+[[nodiscard]] constexpr bool IsCompressed(BakedTextureFormat format)
+{
+  return format == BakedTextureFormat::BC1 || format == BakedTextureFormat::BC3;
+}
+
+// Bytes needed for one level of the given size.
+[[nodiscard]] EVIE_API uint64_t BakedMipSize(BakedTextureFormat format, uint32_t width, uint32_t height);
+
+/**
+ * @brief Compress a 4x4 block of RGBA pixels, given row by row.
+ *
+ * BC1 writes 8 bytes and ignores alpha, BC3 writes 16.
+ */
+EVIE_API void CompressBC1Block(const unsigned char* rgba, unsigned char* block);
+EVIE_API void CompressBC3Block(const unsigned char* rgba, unsigned char* block);
+
+/**
+ * @brief Build the full mip chain for an image and encode it as a baked texture file.
+ *
+ * @param info Images with 1 to 4 channels are accepted, they're expanded to RGBA before filtering.
+ * @param flipped Whether the pixels were flipped vertically when decoded, only recorded in the header.
+ * @return The bytes of the file, ready to be written out.
+ */
+EVIE_API Result<std::vector<unsigned char>>
+  BakeTexture(const ImageInfo& info, const unsigned char* pixels, BakedTextureFormat format, bool flipped = false);
+
+// A baked texture file mapped into memory. The level data points into the mapping so keep this alive while using it.
+class EVIE_API BakedTexture
+{
+public:
+  // Map the file and check its header and mip table. Doesn't touch GL so it's safe to call from any thread.
+  static Result<BakedTexture> Open(const std::string& path);
+
+  [[nodiscard]] BakedTextureFormat GetFormat() const { return format_; }
+  [[nodiscard]] uint32_t GetWidth() const { return mips_.front().width; }
+  [[nodiscard]] uint32_t GetHeight() const { return mips_.front().height; }
+  [[nodiscard]] bool IsFlipped() const { return flipped_; }
+  [[nodiscard]] size_t GetMipCount() const { return mips_.size(); }
+  [[nodiscard]] const BakedMipLevel& GetMip(size_t level) const { return mips_[level]; }
+  [[nodiscard]] const unsigned char* GetMipData(size_t level) const { return file_.Data() + mips_[level].offset; }
+
+private:
+  MappedFile file_;
+  BakedTextureFormat format_{ BakedTextureFormat::RGBA8 };
+  bool flipped_{ false };
+  std::vector<BakedMipLevel> mips_;
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_BAKED_TEXTURE_H_
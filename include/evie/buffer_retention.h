@@ -0,0 +1,18 @@
+#ifndef EVIE_INCLUDE_BUFFER_RETENTION_H_
+#define EVIE_INCLUDE_BUFFER_RETENTION_H_
+
+#include <cstdint>
+
+namespace evie {
+
+// What a GPU buffer keeps on the CPU once its data has been uploaded.
+enum class BufferRetention : uint8_t {
+  // Free the CPU copy after upload. Only counts, layout and bounds are kept.
+  Release,
+  // Keep a CPU copy of the data, e.g. for picking or physics.
+  Retain
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_BUFFER_RETENTION_H_
@@ -0,0 +1,44 @@
+#ifndef EVIE_INCLUDE_COMMAND_LIST_H_
+#define EVIE_INCLUDE_COMMAND_LIST_H_
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "evie/render_queue.h"
+#include "evie/types.h"
+
+namespace evie {
+
+/**
+ * @brief A frame recorded on the simulation thread for the render thread to replay. Recording makes no GL calls, the
+ * draws only point at resources which must stay alive until the frame has been rendered. See RenderThread.
+ */
+struct CommandList
+{
+  FrameUniforms frame;
+  vec4 clear_colour{ 0.14F, 0.15F, 0.16F, 1.0F };
+  WindowDimensions viewport;
+  std::vector<DrawCommand> draws;
+  // GL work such as uploads, run on the render thread in order before any draws.
+  std::vector<std::function<void()>> tasks;
+  // Draws the render queue can't express, such as GeometryPool::Draw(). Run in order after the queued draws, so the
+  // frame uniforms are already set.
+  std::vector<std::function<void()>> draw_tasks;
+
+  void Submit(const DrawCommand& command) { draws.push_back(command); }
+  void Enqueue(std::function<void()> task) { tasks.push_back(std::move(task)); }
+  void EnqueueDraw(std::function<void()> task) { draw_tasks.push_back(std::move(task)); }
+
+  // Keeps the capacity so recording doesn't allocate once lists have grown to a typical frame.
+  void Clear()
+  {
+    draws.clear();
+    tasks.clear();
+    draw_tasks.clear();
+  }
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_COMMAND_LIST_H_
@@ -3,6 +3,7 @@
 
 #include <array>
 #include <stack>
+#include <typeinfo>
 #include <vector>
 
 #include "ecs_constants.hpp"
@@ -27,6 +28,8 @@ public:
   IComponentArray& operator=(const IComponentArray&) = delete;
   IComponentArray& operator=(IComponentArray&&) = delete;
   virtual void RemoveComponent(EntityID) = 0;
+  [[nodiscard]] virtual size_t Size() const = 0;
+  [[nodiscard]] virtual const std::type_info& GetType() const = 0;
   virtual ~IComponentArray() = default;
 };
 
@@ -78,6 +81,8 @@ public:
       entity_index_map_[back_component.id.Get()] = entity_index_map_[entity_id.Get()];// NOLINT(*-array-index)
       // Set the entity_index_map slot to 0 to prove the entity doesn't exist .
       entity_index_map_[entity_id.Get()] = 0;// NOLINT(*-array-index)
+      // Reset the freed slot so it doesn't keep anything the component owns, e.g. resource handles, alive.
+      back_component.component = T{};
     }
   }
 
@@ -86,7 +91,8 @@ public:
     return entity_index_map_[entity_id.Get()] != 0;// NOLINT (*-array-index)
   }
 
-  [[nodiscard]] size_t Size() const { return components_.size() - 1 - free_slots_.size(); }
+  [[nodiscard]] size_t Size() const override { return components_.size() - 1 - free_slots_.size(); }
+  [[nodiscard]] const std::type_info& GetType() const override { return typeid(T); }
 
   T& GetComponent(EntityID entity_id)
   {
@@ -81,6 +81,9 @@ public:
     return comp_array->HasComponent(identifier);
   }
 
+  // Every registered component array, indexed by ComponentID value. For tools that don't know the component types.
+  [[nodiscard]] size_t GetRegisteredComponentCount() const { return component_index_count_; }
+  [[nodiscard]] const IComponentArray& GetComponentArray(size_t index) const { return *components_[index]; }
 
 private:
   // The index for a specific component in this array maps to it's ComponentID
@@ -1,25 +1,24 @@
 #ifndef EVIE_INCLUDE_EVIE_ECS_COMPONENTS_MESH_COMPONENT_HPP_
 #define EVIE_INCLUDE_EVIE_ECS_COMPONENTS_MESH_COMPONENT_HPP_
 
-#include "evie/types.h"
-#include "evie/shader.h"
-#include "evie/texture.h"
-#include "evie/shader_program.h"
-#include "evie/vertex_buffer.h"
-#include "evie/vertex_array.h"
+#include "evie/resource_manager.h"
+#include "evie/texture_array.h"
 
 namespace evie {
+// Handles to shared resources, see ResourceManager. Copying a mesh component creates no GL objects.
 struct MeshComponent
 {
-  VertexBuffer<> model_data;
-  VertexArray<> vertex_array;
-  ShaderProgram shader_program;
-  Texture2D texture;
-  // How do we handle cleaning up these resources?
+  MeshHandle mesh;
+  ShaderProgramHandle shader_program;
+  TextureHandle texture;
+  // Drawn from a texture array layer instead of texture when set, so instanced meshes with different textures still
+  // batch. See shaders/texture_array_vertex_shader.vs and shaders/instanced_texture_array_vertex_shader.vs.
+  TextureLayer texture_layer;
+  // Draw with the instanced path. The shader program must take the model matrix as a per instance attribute, see
+  // shaders/instanced_vertex_shader.vs.
+  bool instanced{ false };
 
-  int GetModelIndices() const {
-    return model_data.GetBuffer().size() / model_data.GetBufferLayout().stride;
-  }
+  int GetModelIndices() const { return static_cast<int>(mesh->vertex_buffer.GetVertexCount()); }
 };
 
 }// namespace evie
@@ -52,6 +52,15 @@ public:
     return component_manager_->GetComponentCount(id);
   }
 
+  // For tools such as the performance overlay that walk every system and component type.
+  [[nodiscard]] size_t SystemCount() const { return system_manager_->GetSystemCount(); }
+  [[nodiscard]] const System& GetSystemAt(size_t index) const { return system_manager_->GetSystemAt(index); }
+  [[nodiscard]] size_t ComponentTypeCount() const { return component_manager_->GetRegisteredComponentCount(); }
+  [[nodiscard]] const IComponentArray& GetComponentArray(size_t index) const
+  {
+    return component_manager_->GetComponentArray(index);
+  }
+
 private:
   // Create these all on the heap because they could be quite large
   std::unique_ptr<ComponentManager> component_manager_;
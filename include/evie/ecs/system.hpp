@@ -55,6 +55,9 @@ public:
    */
   void UpdateSystem(const float& delta_time);
 
+  // How long the last UpdateSystem() took, including deleting marked entities, in nanoseconds.
+  [[nodiscard]] uint64_t GetLastUpdateTime() const { return last_update_ns_; }
+
   // Get a specific ComponentID vector.
   // You may want to access entities that don't reflect your system signature.
   // You must not use this function until after the system has been Registered with the system manager.
@@ -100,6 +103,8 @@ private:
   ankerl::unordered_dense::set<Entity> entities_to_delete_;
 
   uint8_t entity_set_count_{ 0 };
+
+  uint64_t last_update_ns_{ 0 };
 };
 }// namespace evie
 
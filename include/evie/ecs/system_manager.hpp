@@ -61,6 +61,10 @@ public:
     return *static_cast<SystemName*>(systems_[static_cast<size_t>(system_id.Get())].get());
   }
 
+  // Every registered system in registration order, for tools that don't know the system types.
+  [[nodiscard]] size_t GetSystemCount() const { return systems_.size(); }
+  [[nodiscard]] const System& GetSystemAt(size_t index) const { return *systems_[index]; }
+
   [[nodiscard]] SystemSignature& GetEntitySystemSignature(EntityID entity_id) override
   {
     return signature_map_[entity_id];
@@ -0,0 +1,63 @@
+#ifndef EVIE_INCLUDE_FIXED_TIMESTEP_H_
+#define EVIE_INCLUDE_FIXED_TIMESTEP_H_
+
+#include <cstdint>
+
+#include "evie/core.h"
+
+namespace evie {
+
+// Timing of the current frame, see Application::GetFrameTime().
+struct FrameTime
+{
+  // Seconds since the previous frame started.
+  float delta_time{ 0.0F };
+  // Seconds simulated by each Layer::OnFixedUpdate().
+  float fixed_delta_time{ 0.0F };
+  // How far this frame is between the last fixed update and the next, in [0, 1). Render the previous and current
+  // simulation states blended by it so motion stays smooth when the tick rate is below the frame rate.
+  float alpha{ 0.0F };
+  // Fixed updates run this frame, zero when rendering faster than the tick rate.
+  uint32_t fixed_steps{ 0 };
+};
+
+/**
+ * @brief Turns variable frame times into a whole number of fixed length simulation steps. Time left over carries into
+ * the next frame.
+ *
+ * A frame that takes longer than max_steps_per_frame steps would make the next one longer still, so anything beyond
+ * that is dropped and the simulation runs slow until it catches up rather than never catching up.
+ */
+class EVIE_API FixedTimestep
+{
+public:
+  static constexpr double DefaultTickRate = 60.0;
+  static constexpr uint32_t DefaultMaxStepsPerFrame = 5;
+
+  explicit FixedTimestep(double tick_rate = DefaultTickRate, uint32_t max_steps_per_frame = DefaultMaxStepsPerFrame);
+
+  // Add the time since the last frame and return how many steps to simulate now.
+  uint32_t Advance(double frame_seconds);
+
+  // Ticks per second. Takes effect from the next Advance(), time already accumulated is kept.
+  void SetTickRate(double tick_rate);
+  void SetMaxStepsPerFrame(uint32_t max_steps_per_frame);
+
+  [[nodiscard]] double GetStep() const { return step_; }
+  // The fraction of a step accumulated but not yet simulated.
+  [[nodiscard]] float GetAlpha() const;
+  [[nodiscard]] uint64_t GetTickCount() const { return ticks_; }
+  // Total seconds thrown away by the clamp on steps per frame.
+  [[nodiscard]] double GetDroppedTime() const { return dropped_; }
+
+private:
+  double step_;
+  uint32_t max_steps_per_frame_;
+  double accumulator_{ 0.0 };
+  uint64_t ticks_{ 0 };
+  double dropped_{ 0.0 };
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_FIXED_TIMESTEP_H_
@@ -0,0 +1,81 @@
+#ifndef EVIE_INCLUDE_FRAME_PACER_H_
+#define EVIE_INCLUDE_FRAME_PACER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "evie/core.h"
+
+namespace evie {
+
+// The last few hundred frame times, in seconds, for graphs and stats.
+class EVIE_API FrameTimeHistory
+{
+public:
+  // Four seconds at 60 frames a second.
+  static constexpr size_t DefaultCapacity = 240;
+
+  explicit FrameTimeHistory(size_t capacity = DefaultCapacity) : times_(capacity) {}
+
+  // Once full the oldest frame is overwritten.
+  void Push(float seconds);
+  void Clear();
+
+  [[nodiscard]] size_t Size() const { return size_; }
+  [[nodiscard]] size_t Capacity() const { return times_.size(); }
+  [[nodiscard]] bool Empty() const { return size_ == 0; }
+  // Oldest first. Zero if there's no frame at index.
+  [[nodiscard]] float operator[](size_t index) const;
+  // Zero before the first frame.
+  [[nodiscard]] float Latest() const { return size_ == 0 ? 0.0F : (*this)[size_ - 1]; }
+
+  [[nodiscard]] float Average() const;
+  [[nodiscard]] float Max() const;
+  // The time that the given fraction of frames were at or under, e.g. 0.99 for the 99th percentile.
+  [[nodiscard]] float Percentile(float fraction) const;
+
+private:
+  std::vector<float> times_;
+  // Where the next frame is written.
+  size_t next_{ 0 };
+  size_t size_{ 0 };
+};
+
+/**
+ * @brief Caps the frame rate without burning a core. Each frame sleeps until shortly before its deadline, then spins
+ * for the rest because sleeps routinely overshoot by a millisecond or more. How early to wake adapts to how late
+ * sleeps have been coming back.
+ *
+ * Deadlines are measured from the end of the previous frame so a slow frame is never followed by a rushed one.
+ */
+class EVIE_API FramePacer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // Zero or less removes the cap.
+  void SetTargetFrameRate(double frames_per_second);
+  [[nodiscard]] double GetTargetFrameRate() const { return target_frame_rate_; }
+
+  // Call once a frame after presenting. Waits out the rest of the frame if there's a cap, then records the frame time.
+  void EndFrame();
+
+  [[nodiscard]] const FrameTimeHistory& GetHistory() const { return history_; }
+  // How long before a deadline the pacer currently stops sleeping and starts spinning.
+  [[nodiscard]] Clock::duration GetSpinMargin() const { return spin_margin_; }
+
+private:
+  void WaitUntil(Clock::time_point deadline);
+
+  double target_frame_rate_{ 0.0 };
+  Clock::duration period_{ 0 };
+  Clock::duration spin_margin_{ std::chrono::milliseconds(1) };
+  std::optional<Clock::time_point> last_frame_;
+  FrameTimeHistory history_;
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_FRAME_PACER_H_
@@ -0,0 +1,107 @@
+#ifndef EVIE_INCLUDE_FRUSTUM_CULLING_H_
+#define EVIE_INCLUDE_FRUSTUM_CULLING_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "evie/core.h"
+#include "evie/types.h"
+
+namespace evie {
+
+struct AxisAlignedBoundingBox
+{
+  vec3 min{ 0.0F };
+  vec3 max{ 0.0F };
+};
+
+struct BoundingSphere
+{
+  vec3 centre{ 0.0F };
+  float radius{ 0.0F };
+};
+
+// Model space bounds of a mesh. These are calculated once when the vertex data is uploaded.
+struct BoundingVolume
+{
+  AxisAlignedBoundingBox aabb;
+  BoundingSphere sphere;
+};
+
+/**
+ * @brief Calculate the bounds of a set of interleaved float vertices. The position is expected to be the first three
+ * floats of every vertex.
+ *
+ * @param data Pointer to the first float of the vertex data.
+ * @param float_count The total number of floats in data.
+ * @param stride The number of floats per vertex. Must be at least 3.
+ * @return BoundingVolume The AABB and bounding sphere of the positions. Empty data gives a zero sized volume.
+ */
+EVIE_API BoundingVolume CalculateBoundingVolume(const float* data, size_t float_count, size_t stride);
+
+/**
+ * @brief Transform a model space bounding sphere into world space. The radius is scaled by the largest axis scale of
+ * the model matrix so the sphere stays conservative under non-uniform scaling.
+ */
+EVIE_API BoundingSphere TransformBoundingSphere(const BoundingSphere& sphere, const mat4& model);
+
+// Six planes stored as (normal.xyz, distance) in world space. A point p is inside a plane when
+// dot(normal, p) + distance >= 0.
+struct Frustum
+{
+  enum Side : uint8_t { Left, Right, Bottom, Top, Near, Far, Count };
+  std::array<vec4, Side::Count> planes{};
+
+  /**
+   * @brief Extract the normalised frustum planes from a combined projection * view matrix.
+   */
+  static EVIE_API Frustum FromViewProjection(const mat4& view_projection);
+
+  [[nodiscard]] EVIE_API bool Intersects(const BoundingSphere& sphere) const;
+};
+
+// Culls world space bounding spheres against a Frustum. Spheres are stored as structure of arrays so that they can be
+// tested four at a time with SSE where it's available. Nothing here touches the graphics API so it can be used and
+// tested headless.
+class EVIE_API FrustumCuller
+{
+public:
+  static constexpr size_t BatchSize = 4;
+
+  void Clear();
+  void Reserve(size_t count);
+
+  /**
+   * @brief Add a world space sphere to be tested on the next Cull().
+   *
+   * @return uint32_t The index of the sphere. This index is what is written to the visible list.
+   */
+  uint32_t Add(const BoundingSphere& sphere);
+
+  /**
+   * @brief Test every added sphere against the frustum. The result is available from GetVisible().
+   */
+  void Cull(const Frustum& frustum);
+
+  // Indices of the spheres that passed the last Cull() in the order they were added.
+  [[nodiscard]] const std::vector<uint32_t>& GetVisible() const { return visible_; }
+
+  [[nodiscard]] size_t Size() const { return count_; }
+
+private:
+  void CullScalar(const Frustum& frustum, size_t first);
+
+  // Full batches are tested with SIMD, any remainder falls back to CullScalar().
+  std::vector<float> x_;
+  std::vector<float> y_;
+  std::vector<float> z_;
+  std::vector<float> radius_;
+  std::vector<uint32_t> visible_;
+  size_t count_{ 0 };
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_FRUSTUM_CULLING_H_
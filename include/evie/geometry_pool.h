@@ -0,0 +1,134 @@
+#ifndef EVIE_INCLUDE_GEOMETRY_POOL_H_
+#define EVIE_INCLUDE_GEOMETRY_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "evie/core.h"
+#include "evie/error.h"
+#include "evie/ids.h"
+#include "evie/result.h"
+#include "evie/vertex_buffer.h"
+
+namespace evie {
+
+/**
+ * @brief First fit sub-allocation of a fixed number of elements. Freed ranges are merged with their neighbours so the
+ * space can be reused by larger allocations. Kept separate from GeometryPool so it can be tested without a context.
+ */
+class EVIE_API RangeAllocator
+{
+public:
+  RangeAllocator() = default;
+  explicit RangeAllocator(size_t capacity) : capacity_(capacity), free_{ { 0, capacity } } {}
+
+  // The offset of count contiguous elements, or empty if no free range is large enough.
+  [[nodiscard]] std::optional<size_t> Allocate(size_t count);
+  void Free(size_t offset, size_t count);
+
+  [[nodiscard]] size_t Capacity() const { return capacity_; }
+  [[nodiscard]] size_t FreeCount() const;
+  // The largest allocation that would currently succeed.
+  [[nodiscard]] size_t LargestFree() const;
+
+private:
+  struct Range
+  {
+    size_t offset;
+    size_t count;
+  };
+
+  size_t capacity_{ 0 };
+  // Sorted by offset and never touching, touching ranges are merged.
+  std::vector<Range> free_;
+};
+
+// Where a mesh lives in a GeometryPool. Indices are relative to base_vertex.
+struct GeometryRange
+{
+  uint32_t first_index{ 0 };
+  uint32_t index_count{ 0 };
+  uint32_t base_vertex{ 0 };
+  uint32_t vertex_count{ 0 };
+};
+
+/**
+ * @brief The draws for one GeometryPool::Draw(), built on the CPU each frame, e.g. from what survives culling. Every
+ * draw in a list shares the shader program, uniforms and textures bound when it's drawn.
+ */
+class EVIE_API GeometryDrawList
+{
+public:
+  void Add(const GeometryRange& range);
+  void Clear();
+  void Reserve(size_t count);
+
+  [[nodiscard]] size_t Size() const { return counts_.size(); }
+  [[nodiscard]] bool Empty() const { return counts_.empty(); }
+  [[nodiscard]] std::span<const int32_t> GetCounts() const { return counts_; }
+  // Byte offsets into the index buffer, as pointers because that's what GL takes.
+  [[nodiscard]] std::span<const void* const> GetOffsets() const { return offsets_; }
+  [[nodiscard]] std::span<const int32_t> GetBaseVertices() const { return base_vertices_; }
+
+private:
+  std::vector<int32_t> counts_;
+  std::vector<const void*> offsets_;
+  std::vector<int32_t> base_vertices_;
+};
+
+/**
+ * @brief One vertex buffer and one index buffer shared by many static meshes, all under one vertex array. However many
+ * meshes are in a GeometryDrawList they're drawn with one glMultiDrawElementsBaseVertex, so a static scene costs a
+ * constant number of API calls.
+ *
+ * There's no per draw model matrix, GL 3.3 has no gl_DrawID, so add meshes already in world space or draw them with
+ * one shared "model" uniform.
+ */
+class EVIE_API GeometryPool
+{
+public:
+  /**
+   * @brief Create the buffers with room for vertex_capacity vertices and index_capacity indices.
+   *
+   * @param vertex_size Bytes per vertex, which must match layout.
+   */
+  Error Initialise(const BufferLayout& layout, size_t vertex_size, size_t vertex_capacity, size_t index_capacity);
+
+  // Copy a mesh into free space in the buffers. Indices are relative to the first of vertices. Meshes without vertices
+  // or indices are an error.
+  template<typename T> Result<GeometryRange> Add(std::span<const T> vertices, std::span<const uint32_t> indices)
+  {
+    if (sizeof(T) != vertex_size_) {
+      return Error{ "Vertex type doesn't match the geometry pool's vertex size" };
+    }
+    return Add(static_cast<const void*>(vertices.data()), vertices.size(), indices);
+  }
+  Result<GeometryRange> Add(const void* vertices, size_t vertex_count, std::span<const uint32_t> indices);
+
+  // Give the range's space back. Don't draw it afterwards.
+  void Remove(const GeometryRange& range);
+
+  // Issue every draw in the list as one call. The shader program and its uniforms must already be set.
+  void Draw(const GeometryDrawList& draws) const;
+
+  void Destroy();
+
+  [[nodiscard]] VertexArrayID GetVertexArray() const { return vertex_array_; }
+  [[nodiscard]] const RangeAllocator& GetVertexAllocator() const { return vertex_allocator_; }
+  [[nodiscard]] const RangeAllocator& GetIndexAllocator() const { return index_allocator_; }
+
+private:
+  VertexArrayID vertex_array_{ 0 };
+  VertexBufferID vertex_buffer_{ 0 };
+  IndicesArrayID index_buffer_{ 0 };
+  size_t vertex_size_{ 0 };
+  RangeAllocator vertex_allocator_;
+  RangeAllocator index_allocator_;
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_GEOMETRY_POOL_H_
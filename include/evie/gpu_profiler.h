@@ -0,0 +1,139 @@
+#ifndef EVIE_INCLUDE_GPU_PROFILER_H_
+#define EVIE_INCLUDE_GPU_PROFILER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <typeinfo>
+#include <vector>
+
+#include "evie/core.h"
+#include "evie/error.h"
+#include "evie/profiler.h"
+
+namespace evie {
+
+// How long one GPU zone took in a resolved frame.
+struct GpuZoneTiming
+{
+  const char* name{ nullptr };
+  // name is a std::type_info name, see ProfileEvent.
+  bool type_name{ false };
+  uint16_t depth{ 0 };
+  // From the start of the frame's first zone.
+  double start_ms{ 0.0 };
+  double milliseconds{ 0.0 };
+};
+
+/**
+ * @brief Times render passes on the GPU with GL_TIMESTAMP queries. Each frame's queries are read back a few frames
+ * later, once the GPU has got to them, so reading results never stalls. A frame whose queries still aren't done when
+ * its slot comes round again is dropped rather than waited for.
+ *
+ * Resolved zones go to GetLastFrame() and, while the Profiler is capturing, onto a "GPU" track alongside the CPU zones.
+ * Only use it from the thread that owns the context.
+ */
+class EVIE_API GpuProfiler
+{
+public:
+  static constexpr size_t DefaultFramesInFlight = 4;
+  static constexpr size_t DefaultMaxZonesPerFrame = 256;
+
+  // Create the query pool. Zones past max_zones_per_frame in a frame aren't timed.
+  Error Initialise(size_t frames_in_flight = DefaultFramesInFlight,
+    size_t max_zones_per_frame = DefaultMaxZonesPerFrame);
+  void Destroy();
+  [[nodiscard]] bool IsInitialised() const { return !frames_.empty(); }
+
+  // Read back any frames the GPU has finished, then start timing a new one.
+  void BeginFrame();
+  void EndFrame();
+
+  // Zones nest. Names must outlive the capture, as with EV_PROFILE_SCOPE. Ignored outside BeginFrame()/EndFrame().
+  void BeginZone(const char* name, bool type_name = false);
+  void EndZone();
+
+  // Re-measure the offset between the GPU and CPU clocks used to line zones up in traces. Done by Initialise().
+  void Calibrate();
+
+  // The most recently resolved frame, in the order zones began.
+  [[nodiscard]] std::span<const GpuZoneTiming> GetLastFrame() const { return last_frame_; }
+  [[nodiscard]] uint64_t GetResolvedFrameCount() const { return resolved_frames_; }
+  // Frames whose results weren't ready in time.
+  [[nodiscard]] uint64_t GetDroppedFrameCount() const { return dropped_frames_; }
+  // Zones past the per frame limit.
+  [[nodiscard]] uint64_t GetDroppedZoneCount() const { return dropped_zones_; }
+
+private:
+  struct Zone
+  {
+    const char* name;
+    bool type_name;
+    uint16_t depth;
+  };
+
+  struct Frame
+  {
+    // Zone i's queries are begin and end at 2 * i and 2 * i + 1 into the frame's share of queries_.
+    std::vector<Zone> zones;
+    // Written and waiting to be read back.
+    bool pending{ false };
+    // The last query issued in the frame. Queries finish in order, so once it has the rest have too.
+    uint32_t last_query{ 0 };
+  };
+
+  [[nodiscard]] uint32_t Query(size_t frame, size_t index) const { return queries_[frame * max_zones_ * 2 + index]; }
+  [[nodiscard]] bool IsAvailable(const Frame& frame) const;
+  void Resolve(size_t frame);
+
+  std::vector<uint32_t> queries_;
+  std::vector<Frame> frames_;
+  size_t max_zones_{ 0 };
+  // The slot being recorded into, which between frames holds the oldest frame.
+  size_t current_{ 0 };
+  bool recording_{ false };
+  // Index of each open zone, or NotTimed for zones over the limit.
+  static constexpr uint32_t NotTimed = UINT32_MAX;
+  std::vector<uint32_t> open_;
+  std::vector<GpuZoneTiming> last_frame_;
+  // CPU Profiler::Now() minus the GPU timestamp at the same moment.
+  int64_t clock_offset_ns_{ 0 };
+  uint32_t track_{ 0 };
+  bool has_track_{ false };
+  uint64_t resolved_frames_{ 0 };
+  uint64_t dropped_frames_{ 0 };
+  uint64_t dropped_zones_{ 0 };
+};
+
+// Times the rest of the enclosing scope on the GPU. Use through EV_PROFILE_GPU_SCOPE.
+class EVIE_API GpuProfileScope
+{
+public:
+  GpuProfileScope(GpuProfiler& profiler, const char* name, bool type_name = false) : profiler_(profiler)
+  {
+    profiler_.BeginZone(name, type_name);
+  }
+  GpuProfileScope(GpuProfiler& profiler, const std::type_info& type) : GpuProfileScope(profiler, type.name(), true) {}
+  ~GpuProfileScope() { profiler_.EndZone(); }
+  GpuProfileScope(const GpuProfileScope&) = delete;
+  GpuProfileScope(GpuProfileScope&&) = delete;
+  GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+  GpuProfileScope& operator=(GpuProfileScope&&) = delete;
+
+private:
+  GpuProfiler& profiler_;
+};
+
+}// namespace evie
+
+#if EVIE_PROFILING
+#define EV_PROFILE_GPU_SCOPE(profiler, name) \
+  const ::evie::GpuProfileScope EV_PROFILE_CONCAT(ev_profile_gpu_scope_, __LINE__)(profiler, name)// NOLINT
+#define EV_PROFILE_GPU_TYPE_SCOPE(profiler, object) \
+  const ::evie::GpuProfileScope EV_PROFILE_CONCAT(ev_profile_gpu_scope_, __LINE__)(profiler, typeid(object))// NOLINT
+#else
+#define EV_PROFILE_GPU_SCOPE(profiler, name)
+#define EV_PROFILE_GPU_TYPE_SCOPE(profiler, object)
+#endif
+
+#endif// !EVIE_INCLUDE_GPU_PROFILER_H_
@@ -1,8 +1,11 @@
 #ifndef EVIE_INCLUDE_INDICES_ARRAY_H_
 #define EVIE_INCLUDE_INDICES_ARRAY_H_
 
+#include <cstddef>
+#include <span>
 #include <vector>
 
+#include "evie/buffer_retention.h"
 #include "evie/core.h"
 #include "evie/ids.h"
 
@@ -11,12 +14,18 @@ namespace evie {
 class EVIE_API IndicesArray
 {
 public:
-  void Initialise(const std::vector<unsigned int>& indices);
+  // By default the CPU copy isn't kept once it's on the GPU. Use BufferRetention::Retain to keep it for GetIndices().
+  void Initialise(std::span<const unsigned int> indices, BufferRetention retention = BufferRetention::Release);
   void Bind();
   void Destroy();
 
+  [[nodiscard]] size_t GetCount() const { return count_; }
+  // The CPU copy of the indices. Empty unless the array was initialised with BufferRetention::Retain.
+  [[nodiscard]] const std::vector<unsigned int>& GetIndices() const { return indices_; }
+
 private:
   std::vector<unsigned int> indices_{};
+  size_t count_{ 0 };
   IndicesArrayID id_{ 0 };
 };
 
@@ -43,7 +43,7 @@ public:
 
   [[nodiscard]] constexpr EventType GetEventType() const override { return KeyPressedEvent::type; }
 
-  [[nodiscard]] int GetRepeatCount() { return repeat_count_; };
+  [[nodiscard]] int GetRepeatCount() const { return repeat_count_; };
 
   [[nodiscard]] std::string ToString() const override
   {
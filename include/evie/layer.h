@@ -5,13 +5,21 @@
 #include "evie/events.h"
 
 namespace evie {
+struct CommandList;
+
 class EVIE_API Layer
 {
 public:
   virtual ~Layer() = default;
   virtual void OnUpdate() = 0;
+  // Called zero or more times a frame before OnUpdate(), each advancing the simulation by exactly fixed_delta_time. Put
+  // physics and anything else that needs to be deterministic here, see Application::SetFixedTickRate().
+  virtual void OnFixedUpdate([[maybe_unused]] float fixed_delta_time) {}
   virtual void OnEvent(Event& event) = 0;
   virtual void OnRender() = 0;
+  // Called instead of OnRender() once Application::EnableRenderThread() has been called. Runs on the simulation thread
+  // so record draws into commands rather than calling GL.
+  virtual void OnRecord([[maybe_unused]] CommandList& commands) {}
   virtual void Shutdown() {}
 };
 }// namespace evie
@@ -0,0 +1,43 @@
+#ifndef EVIE_INCLUDE_MAPPED_FILE_H_
+#define EVIE_INCLUDE_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+#include "evie/core.h"
+#include "evie/error.h"
+#include "evie/result.h"
+
+namespace evie {
+
+/**
+ * @brief A read only view of a whole file mapped into memory. Pages are read in by the OS as they're touched, so
+ * nothing is copied into the process until it's used.
+ */
+class EVIE_API MappedFile
+{
+public:
+  MappedFile() = default;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  ~MappedFile();
+
+  // Empty files can't be mapped and are reported as an error.
+  static Result<MappedFile> Open(const std::string& path);
+
+  [[nodiscard]] const unsigned char* Data() const { return data_; }
+  [[nodiscard]] size_t Size() const { return size_; }
+  [[nodiscard]] bool IsOpen() const { return data_ != nullptr; }
+
+  void Close();
+
+private:
+  const unsigned char* data_{ nullptr };
+  size_t size_{ 0 };
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_MAPPED_FILE_H_
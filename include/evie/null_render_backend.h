@@ -0,0 +1,68 @@
+#ifndef EVIE_INCLUDE_NULL_RENDER_BACKEND_H_
+#define EVIE_INCLUDE_NULL_RENDER_BACKEND_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "evie/core.h"
+#include "evie/error.h"
+
+namespace evie {
+
+// What reached the null backend since it was loaded or the stats were last reset.
+struct NullRenderStats
+{
+  // Every GL call, including queries.
+  size_t gl_calls{ 0 };
+  // glDraw* calls. A multi draw is one call.
+  size_t draw_calls{ 0 };
+  // Meshes drawn, counting each draw in a multi draw and each instance.
+  size_t draws{ 0 };
+  // Binds plus context wide state such as glEnable and glViewport. Binds skipped by the GLStateCache aren't counted.
+  size_t state_changes{ 0 };
+  size_t uniform_updates{ 0 };
+  // Buffer and texture data copied from the CPU, including writes through mapped buffers.
+  size_t bytes_uploaded{ 0 };
+  size_t objects_created{ 0 };
+  size_t objects_deleted{ 0 };
+};
+
+// One draw call as issued, with the state it was drawn with.
+struct RecordedDraw
+{
+  uint32_t mode{ 0 };
+  // Vertices or indices per draw, summed over a multi draw.
+  int32_t count{ 0 };
+  int32_t instances{ 1 };
+  // Draws in a multi draw, otherwise 1.
+  int32_t sub_draws{ 1 };
+  uint32_t program{ 0 };
+  uint32_t vertex_array{ 0 };
+  // Texture bound to unit 0, for any target.
+  uint32_t texture{ 0 };
+};
+
+/**
+ * @brief Point every GL function at a backend that does nothing but count, so the render path can run without a
+ * context or a GPU, e.g. in tests and benchmarks on CI. Use it instead of creating a window: ShaderProgram,
+ * VertexArray, RenderQueue, GeometryPool and the rest work unchanged. Objects get names, shaders always compile and
+ * programs always link with no active uniforms. Timer queries read the CPU clock.
+ *
+ * Replaces whatever glad had loaded, so don't mix it with a real context. Resets the stats and the GLStateCache.
+ *
+ * @param record_draws Keep a RecordedDraw for each draw call, see GetRecordedDraws().
+ */
+EVIE_API Error LoadNullRenderBackend(bool record_draws = false);
+
+[[nodiscard]] EVIE_API const NullRenderStats& GetNullRenderStats();
+// Draws since the last reset, empty unless recording was asked for when loading.
+[[nodiscard]] EVIE_API std::span<const RecordedDraw> GetRecordedDraws();
+// Zero the stats and drop recorded draws, e.g. between the setup and the frame being measured.
+EVIE_API void ResetNullRenderStats();
+// Whether query results report themselves as ready, false acts like a GPU that's fallen behind. Defaults to true.
+EVIE_API void SetNullQueryResultsAvailable(bool available);
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_NULL_RENDER_BACKEND_H_
@@ -0,0 +1,183 @@
+#ifndef EVIE_INCLUDE_PROFILER_H_
+#define EVIE_INCLUDE_PROFILER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "evie/core.h"
+#include "evie/error.h"
+
+// Compile time switch for the profiler zones. When 0 the EV_PROFILE macros expand to nothing. Set by the
+// Evie_ENABLE_PROFILING CMake option.
+#ifndef EVIE_PROFILING
+#define EVIE_PROFILING 1
+#endif
+
+namespace evie {
+
+// One timed zone. Names aren't copied so they must outlive the capture, string literals and __func__ do.
+struct ProfileEvent
+{
+  const char* name{ nullptr };
+  uint64_t start_ns{ 0 };
+  uint64_t duration_ns{ 0 };
+  uint32_t thread{ 0 };
+  // How many zones this one is nested in on its thread.
+  uint16_t depth{ 0 };
+  // name is a std::type_info name and is demangled on export.
+  bool type_name{ false };
+};
+
+/**
+ * @brief A fixed size queue of events written by one thread and read by another without locks. When full new events
+ * are dropped rather than overwriting ones that haven't been read yet.
+ */
+class EVIE_API ProfileEventRing
+{
+public:
+  // Rounded up to a power of two.
+  explicit ProfileEventRing(size_t capacity);
+
+  // Only called by the owning thread. False if the ring was full.
+  bool Push(const ProfileEvent& event);
+  // Only called by one reader at a time. Appends every unread event to events.
+  void Drain(std::vector<ProfileEvent>& events);
+
+  [[nodiscard]] size_t Capacity() const { return events_.size(); }
+
+private:
+  std::vector<ProfileEvent> events_;
+  size_t mask_;
+  // Both only ever increase, the slot is the index & mask_.
+  std::atomic<uint64_t> write_{ 0 };
+  std::atomic<uint64_t> read_{ 0 };
+};
+
+/**
+ * @brief Collects EV_PROFILE_SCOPE zones from every thread and exports them as a Chrome trace, which opens in
+ * chrome://tracing and https://ui.perfetto.dev.
+ *
+ * Nothing is recorded until BeginCapture(). While capturing each zone costs two clock reads and a write into its
+ * thread's ring. Rings are emptied into the capture by Flush(), which Application calls every frame.
+ */
+class EVIE_API Profiler
+{
+public:
+  static constexpr size_t DefaultRingCapacity = size_t{ 1 } << 14U;
+
+  static Profiler& Get();
+
+  void BeginCapture();
+  void EndCapture();
+  [[nodiscard]] bool IsCapturing() const { return capturing_.load(std::memory_order_relaxed); }
+
+  // Move events out of every thread's ring into the capture. Call often enough that rings don't fill up.
+  void Flush();
+  // Drop everything captured so far.
+  void Clear();
+  // Flushes and returns a copy of every captured event.
+  [[nodiscard]] std::vector<ProfileEvent> GetEvents();
+  // Events lost because a ring was full.
+  [[nodiscard]] size_t GetDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+  // Name the calling thread in exported traces.
+  void SetThreadName(const std::string& name);
+  // A named timeline for zones that weren't timed by a CPU thread, e.g. the GPU. Returns the id for RecordOnTrack().
+  [[nodiscard]] uint32_t AddTrack(const std::string& name);
+  // Only ever call this from one thread per track. The event's thread is set to the track.
+  void RecordOnTrack(uint32_t track, const ProfileEvent& event);
+
+  // Flushes then writes everything captured as Chrome trace JSON.
+  void WriteChromeTrace(std::ostream& stream);
+  [[nodiscard]] Error WriteChromeTrace(const std::string& path);
+
+  // Nanoseconds since the profiler was first used.
+  [[nodiscard]] static uint64_t Now();
+
+  // Used by ProfileScope.
+  void Record(const ProfileEvent& event);
+  [[nodiscard]] uint16_t& ThreadDepth();
+
+private:
+  struct ThreadProfile
+  {
+    explicit ThreadProfile(uint32_t thread_id) : ring(DefaultRingCapacity), id(thread_id) {}
+    ProfileEventRing ring;
+    uint32_t id;
+    uint16_t depth{ 0 };
+    std::string name;
+  };
+
+  Profiler() = default;
+  ThreadProfile& GetThreadProfile();
+  void FlushLocked();
+
+  std::atomic<bool> capturing_{ false };
+  std::atomic<size_t> dropped_{ 0 };
+  std::mutex mutex_;
+  // Kept after their thread exits so that what it recorded can still be flushed.
+  std::vector<std::unique_ptr<ThreadProfile>> threads_;
+  std::vector<ProfileEvent> events_;
+};
+
+// A std::type_info name as it would be written in code, e.g. for ProfileEvent::type_name zones.
+[[nodiscard]] EVIE_API std::string DemangleTypeName(const char* name);
+
+// Records the time between construction and destruction as a zone. Use through EV_PROFILE_SCOPE.
+class EVIE_API ProfileScope
+{
+public:
+  explicit ProfileScope(const char* name, bool type_name = false)
+  {
+    if (Profiler::Get().IsCapturing()) {
+      Begin(name, type_name);
+    }
+  }
+  // Named after the type, e.g. a System's or Layer's dynamic type.
+  explicit ProfileScope(const std::type_info& type) : ProfileScope(type.name(), true) {}
+  ~ProfileScope()
+  {
+    if (event_.name != nullptr) {
+      End();
+    }
+  }
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope(ProfileScope&&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+  ProfileScope& operator=(ProfileScope&&) = delete;
+
+private:
+  void Begin(const char* name, bool type_name);
+  void End();
+
+  ProfileEvent event_;
+};
+
+}// namespace evie
+
+#define EV_PROFILE_CONCAT_INNER(a, b) a##b// NOLINT(*-macro-usage)
+#define EV_PROFILE_CONCAT(a, b) EV_PROFILE_CONCAT_INNER(a, b)// NOLINT(*-macro-usage)
+
+#if EVIE_PROFILING
+// Time the rest of the enclosing scope. name must be a string literal or otherwise outlive the capture.
+#define EV_PROFILE_SCOPE(name) const ::evie::ProfileScope EV_PROFILE_CONCAT(ev_profile_scope_, __LINE__)(name)// NOLINT
+#define EV_PROFILE_FUNCTION() EV_PROFILE_SCOPE(__func__)// NOLINT(*-macro-usage)
+// Time the rest of the enclosing scope under the dynamic type of object, e.g. EV_PROFILE_TYPE_SCOPE(*this).
+#define EV_PROFILE_TYPE_SCOPE(object) \
+  const ::evie::ProfileScope EV_PROFILE_CONCAT(ev_profile_scope_, __LINE__)(typeid(object))// NOLINT
+#define EV_PROFILE_THREAD(name) ::evie::Profiler::Get().SetThreadName(name)// NOLINT(*-macro-usage)
+#else
+#define EV_PROFILE_SCOPE(name)
+#define EV_PROFILE_FUNCTION()
+#define EV_PROFILE_TYPE_SCOPE(object)
+#define EV_PROFILE_THREAD(name)
+#endif
+
+#endif// !EVIE_INCLUDE_PROFILER_H_
@@ -0,0 +1,179 @@
+#ifndef EVIE_INCLUDE_RENDER_QUEUE_H_
+#define EVIE_INCLUDE_RENDER_QUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "evie/core.h"
+#include "evie/ids.h"
+#include "evie/shader_program.h"
+#include "evie/stream_buffer.h"
+#include "evie/texture.h"
+#include "evie/texture_array.h"
+#include "evie/types.h"
+#include "evie/uniform_buffer.h"
+
+namespace evie {
+
+// Data that is the same for every draw in a frame. It's uploaded once per Execute() into the Frame uniform block.
+struct FrameUniforms
+{
+  mat4 view{ 1.0F };
+  mat4 projection{ 1.0F };
+  vec3 view_position{ 0.0F };
+  // Seconds since the application started.
+  float time{ 0.0F };
+};
+
+// A single draw submitted to the RenderQueue. The queue doesn't take ownership of anything pointed to, it must stay
+// alive until Execute() has been called.
+struct DrawCommand
+{
+  ShaderProgram* shader_program{ nullptr };
+  Texture2D* texture{ nullptr };
+  VertexArrayID vertex_array{ 0 };
+  mat4 model{ 1.0F };
+  int vertex_count{ 0 };
+  // Normalised [0, 1] distance from the camera. Used to sort front to back within the same state.
+  float depth{ 0.0F };
+  // Instanced commands that share a shader program, texture and vertex array are drawn with a single
+  // glDrawArraysInstanced. The model matrix is passed as a per instance attribute at
+  // RenderQueue::InstanceModelAttribute instead of the "model" uniform.
+  bool instanced{ false };
+  // Used instead of texture when set. Commands sharing an array but not a layer keep the same state, so instanced
+  // ones still batch. The layer is passed per instance at RenderQueue::InstanceLayerAttribute, or otherwise through
+  // the "texture_layer" uniform, see shaders/texture_array_vertex_shader.vs.
+  TextureArray* texture_array{ nullptr };
+  uint32_t texture_layer{ 0 };
+};
+
+// Counts of the binds that were (or would be) issued when walking the queue.
+struct RenderStateChanges
+{
+  size_t shader_programs{ 0 };
+  size_t textures{ 0 };
+  size_t vertex_arrays{ 0 };
+  size_t draw_calls{ 0 };
+
+  // Total number of binds. Doesn't include draw calls.
+  [[nodiscard]] size_t Total() const { return shader_programs + textures + vertex_arrays; }
+};
+
+// Collects draw commands for a frame, sorts them by a packed 64 bit key and then executes them skipping any binds that
+// are already current. The key is laid out most significant first so that the most expensive state changes are the
+// ones grouped together:
+// | shader program (16) | texture (16) | vertex array (16) | instanced (1) | depth (15) |
+// Instanced commands sort after the others with the same state, so depth can't interleave them and split a batch.
+class EVIE_API RenderQueue
+{
+public:
+  static constexpr int DepthBits = 15;
+  static constexpr int InstancedBits = 1;
+  static constexpr int VertexArrayBits = 16;
+  static constexpr int TextureBits = 16;
+  static constexpr int ShaderProgramBits = 16;
+  // First of the four vec4 attribute locations used for the per instance model matrix.
+  static constexpr GLuint InstanceModelAttribute = 8;
+  // A float holding the texture array layer of each instance.
+  static constexpr GLuint InstanceLayerAttribute = 12;
+
+  /**
+   * @brief Pack the state of a draw into a sort key. IDs wider than their field are truncated which only affects how
+   * well draws are grouped, redundant binds are detected on the real IDs.
+   */
+  [[nodiscard]] static uint64_t
+    MakeSortKey(uint32_t shader_program, uint32_t texture, uint32_t vertex_array, bool instanced, float depth);
+
+  void Reserve(size_t count);
+
+  /**
+   * @brief Submit a draw for this frame. The sort key is built from the command's state. Commands without a shader
+   * program are dropped with a warning.
+   */
+  void Submit(const DrawCommand& command);
+
+  /**
+   * @brief Radix sort the submitted commands by their sort key. Commands with equal keys keep their submission order.
+   */
+  void Sort();
+
+  /**
+   * @brief Issue every command in sorted order. Shader programs, textures and vertex arrays are only bound when they
+   * differ from the previous command. The frame uniforms are uploaded once to the Frame uniform block at
+   * FrameBlockBinding.
+   */
+  void Execute(const FrameUniforms& frame_uniforms);
+
+  // Remove all commands, ready for the next frame.
+  void Clear();
+
+  // Release the instance stream and frame uniform buffers.
+  void Destroy();
+
+  /**
+   * @brief Count the binds that Execute() would issue for the current order of the queue. This doesn't touch the
+   * graphics API.
+   */
+  [[nodiscard]] RenderStateChanges CountStateChanges() const;
+
+  // The state changes issued by the last Execute().
+  [[nodiscard]] const RenderStateChanges& GetLastStateChanges() const { return last_state_changes_; }
+
+  [[nodiscard]] size_t Size() const { return entries_.size(); }
+
+  // Access commands in their current (sorted after Sort()) order.
+  [[nodiscard]] const DrawCommand& GetCommand(size_t index) const { return commands_[entries_[index].index]; }
+  [[nodiscard]] uint64_t GetSortKey(size_t index) const { return entries_[index].key; }
+
+private:
+  struct SortEntry
+  {
+    uint64_t key;
+    uint32_t index;
+  };
+
+  // The state IDs of a command that are compared to detect redundant binds.
+  struct BoundState
+  {
+    uint32_t shader_program{ 0 };
+    uint32_t texture{ 0 };
+    uint32_t vertex_array{ 0 };
+  };
+
+  // A run of sorted entries that is issued as one draw call.
+  struct Batch
+  {
+    size_t first_entry;
+    size_t count;
+    // Index of the first instance in instance_data_ for instanced batches.
+    size_t first_instance;
+  };
+
+  // Streamed as per instance attributes, the model matrix then the texture layer.
+  struct InstanceData
+  {
+    mat4 model;
+    float texture_layer;
+  };
+
+  static BoundState GetState(const DrawCommand& command);
+  static bool SameState(const BoundState& lhs, const BoundState& rhs);
+
+  // Split the sorted entries into batches and gather the model matrices of instanced batches.
+  void BuildBatches();
+
+  std::vector<DrawCommand> commands_;
+  std::vector<SortEntry> entries_;
+  // Ping pong buffer for the radix sort.
+  std::vector<SortEntry> scratch_;
+  RenderStateChanges last_state_changes_;
+  std::vector<Batch> batches_;
+  std::vector<InstanceData> instance_data_;
+  StreamBuffer instance_stream_;
+  UniformBuffer frame_buffer_;
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_RENDER_QUEUE_H_
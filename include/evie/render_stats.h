@@ -0,0 +1,30 @@
+#ifndef EVIE_INCLUDE_RENDER_STATS_H_
+#define EVIE_INCLUDE_RENDER_STATS_H_
+
+#include <cstddef>
+
+#include "evie/core.h"
+
+namespace evie {
+
+// Rendering work issued since the last ResetRenderStats(), e.g. over one frame.
+struct RenderStats
+{
+  // glDraw* calls. A multi draw or an instanced draw is one call.
+  size_t draw_calls{ 0 };
+  // Meshes drawn, counting each draw in a multi draw and each instance.
+  size_t draws{ 0 };
+  // Binds that went through the GLStateCache to GL, and those it skipped because nothing would have changed.
+  size_t binds_issued{ 0 };
+  size_t binds_elided{ 0 };
+};
+
+// Count a draw call made outside RenderQueue, GeometryPool and Mesh, which count their own. Only call it from the
+// thread rendering.
+EVIE_API void CountDrawCall(size_t draws = 1);
+[[nodiscard]] EVIE_API RenderStats GetRenderStats();
+EVIE_API void ResetRenderStats();
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_RENDER_STATS_H_
@@ -0,0 +1,83 @@
+#ifndef EVIE_INCLUDE_RENDER_THREAD_H_
+#define EVIE_INCLUDE_RENDER_THREAD_H_
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "evie/command_list.h"
+#include "evie/core.h"
+
+namespace evie {
+
+/**
+ * @brief Replays command lists on a thread of its own so recording frame N + 1 overlaps rendering frame N.
+ *
+ * Two lists are double buffered. The simulation thread records into one while the render thread replays the other,
+ * and Submit() swaps them once the render thread is done with its frame. So the simulation is never more than one
+ * frame ahead, and anything a submitted list points at must live until the next Submit() returns.
+ *
+ * Nothing here touches GL, what a frame does is up to the render function, see Application::EnableRenderThread().
+ */
+class EVIE_API RenderThread
+{
+public:
+  using RenderFunction = std::function<void(CommandList&)>;
+
+  RenderThread() = default;
+  RenderThread(const RenderThread&) = delete;
+  RenderThread(RenderThread&&) = delete;
+  RenderThread& operator=(const RenderThread&) = delete;
+  RenderThread& operator=(RenderThread&&) = delete;
+  ~RenderThread() { Stop(); }
+
+  /**
+   * @brief Start the thread.
+   *
+   * @param on_start Run first on the render thread, e.g. to make the context current there.
+   * @param render Replays one frame.
+   * @param on_stop Run last on the render thread, e.g. to release the context.
+   */
+  void Start(std::function<void()> on_start, RenderFunction render, std::function<void()> on_stop);
+
+  // Finish the frame in flight, then join the thread.
+  void Stop();
+
+  // The list to record this frame into. Only touch it from the thread calling Submit().
+  [[nodiscard]] CommandList& GetRecordingList() { return lists_[recording_]; }// NOLINT(*-constant-array-index)
+
+  /**
+   * @brief Hand the recorded list to the render thread and return straight away, without waiting for it to be
+   * rendered. Blocks first until the render thread has finished the previous list, then while synchronised runs.
+   *
+   * @param synchronised Run on the render thread between frames while the caller is blocked, so it can safely touch
+   * state shared by both threads, e.g. to collect resources released by the simulation.
+   */
+  void Submit(const std::function<void()>& synchronised = {});
+
+  [[nodiscard]] bool IsRunning() const { return thread_.joinable(); }
+  [[nodiscard]] size_t GetFramesRendered() const;
+
+private:
+  void Run();
+
+  std::array<CommandList, 2> lists_;
+  size_t recording_{ 0 };
+  std::thread thread_;
+  mutable std::mutex mutex_;
+  std::condition_variable changed_;
+  std::function<void()> on_start_;
+  RenderFunction render_;
+  std::function<void()> on_stop_;
+  const std::function<void()>* synchronised_{ nullptr };
+  bool frame_pending_{ false };
+  bool stopping_{ false };
+  size_t frames_rendered_{ 0 };
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_RENDER_THREAD_H_
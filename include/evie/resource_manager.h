@@ -0,0 +1,368 @@
+#ifndef EVIE_INCLUDE_RESOURCE_MANAGER_H_
+#define EVIE_INCLUDE_RESOURCE_MANAGER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ankerl/unordered_dense.h"
+
+#include "evie/async_texture_loader.h"
+#include "evie/core.h"
+#include "evie/error.h"
+#include "evie/result.h"
+#include "evie/shader_program.h"
+#include "evie/texture.h"
+#include "evie/texture_array.h"
+#include "evie/vertex_array.h"
+#include "evie/vertex_buffer.h"
+
+namespace evie {
+
+template<typename T> class ResourcePool;
+
+/**
+ * @brief A counted reference to a resource owned by a ResourcePool. Copying a handle only bumps the count, so
+ * components holding handles can be copied around freely without creating or copying GL objects.
+ *
+ * Handles point back at their pool, which must outlive them.
+ */
+template<typename T> class ResourceHandle
+{
+public:
+  ResourceHandle() = default;
+  ResourceHandle(const ResourceHandle& other)
+    : pool_(other.pool_), index_(other.index_), generation_(other.generation_)
+  {
+    AddRef();
+  }
+  ResourceHandle(ResourceHandle&& other) noexcept
+    : pool_(other.pool_), index_(other.index_), generation_(other.generation_)
+  {
+    other.pool_ = nullptr;
+  }
+  ResourceHandle& operator=(const ResourceHandle& other)
+  {
+    if (this != &other) {
+      Release();
+      pool_ = other.pool_;
+      index_ = other.index_;
+      generation_ = other.generation_;
+      AddRef();
+    }
+    return *this;
+  }
+  ResourceHandle& operator=(ResourceHandle&& other) noexcept
+  {
+    if (this != &other) {
+      Release();
+      pool_ = other.pool_;
+      index_ = other.index_;
+      generation_ = other.generation_;
+      other.pool_ = nullptr;
+    }
+    return *this;
+  }
+  ~ResourceHandle() { Release(); }
+
+  // Null if the handle is empty or the resource has been destroyed. Don't hold on to the pointer across frames.
+  [[nodiscard]] T* Get() const { return pool_ != nullptr ? pool_->Get(index_, generation_) : nullptr; }
+  T* operator->() const { return Get(); }
+  T& operator*() const { return *Get(); }
+  [[nodiscard]] bool Valid() const { return Get() != nullptr; }
+
+  bool operator==(const ResourceHandle& other) const
+  {
+    return pool_ == other.pool_ && index_ == other.index_ && generation_ == other.generation_;
+  }
+
+  // Drop this reference and leave the handle empty.
+  void Reset()
+  {
+    Release();
+    pool_ = nullptr;
+  }
+
+private:
+  friend class ResourcePool<T>;
+  ResourceHandle(ResourcePool<T>* pool, uint32_t index, uint32_t generation)
+    : pool_(pool), index_(index), generation_(generation)
+  {
+    AddRef();
+  }
+
+  void AddRef() const
+  {
+    if (pool_ != nullptr) {
+      pool_->AddRef(index_, generation_);
+    }
+  }
+  void Release() const
+  {
+    if (pool_ != nullptr) {
+      pool_->Release(index_, generation_);
+    }
+  }
+
+  ResourcePool<T>* pool_{ nullptr };
+  uint32_t index_{ 0 };
+  uint32_t generation_{ 0 };
+};
+
+/**
+ * @brief Owns resources of one type, deduplicated by a key such as a file path.
+ *
+ * Resources are reference counted through ResourceHandle. When the last handle goes the resource is only queued;
+ * it's destroyed by the next Collect() so a handle dropped mid-frame never deletes something a queued draw still
+ * uses. If the key is acquired again before then the resource is simply reused.
+ *
+ * The pool knows nothing about GL, destruction is done by the callable passed to Collect() and Clear().
+ */
+template<typename T> class ResourcePool
+{
+public:
+  ResourcePool() = default;
+  // Handles point at the pool so it can't be copied or moved.
+  ResourcePool(const ResourcePool&) = delete;
+  ResourcePool(ResourcePool&&) = delete;
+  ResourcePool& operator=(const ResourcePool&) = delete;
+  ResourcePool& operator=(ResourcePool&&) = delete;
+  ~ResourcePool() = default;
+
+  /**
+   * @brief Get a handle to the resource for key, creating it if it isn't loaded.
+   *
+   * @param create Called as Error(T&) to initialise a new resource in place. Not called if key is already loaded. It
+   * must clean up anything it created if it fails.
+   */
+  template<typename Create> Result<ResourceHandle<T>> Acquire(std::string_view key, Create&& create)
+  {
+    if (auto found = keys_.find(key); found != keys_.end()) {
+      return ResourceHandle<T>(this, found->second, slots_[found->second].generation);
+    }
+    const uint32_t index = AllocateSlot();
+    Slot& slot = slots_[index];
+    if (Error err = std::invoke(std::forward<Create>(create), slot.resource); err.Bad()) {
+      slot.resource = T{};
+      free_slots_.push_back(index);
+      return err;
+    }
+    slot.live = true;
+    slot.key = std::string(key);
+    keys_.emplace(slot.key, index);
+    ++live_count_;
+    return ResourceHandle<T>(this, index, slot.generation);
+  }
+
+  // A handle to the resource for key, or an empty handle if it isn't loaded.
+  [[nodiscard]] ResourceHandle<T> Find(std::string_view key)
+  {
+    if (auto found = keys_.find(key); found != keys_.end()) {
+      return ResourceHandle<T>(this, found->second, slots_[found->second].generation);
+    }
+    return {};
+  }
+
+  /**
+   * @brief Destroy resources that have no handles left.
+   *
+   * @param destroy Called as void(T&) for each resource before its slot is reused.
+   * @return size_t Number of resources destroyed.
+   */
+  template<typename Destroy> size_t Collect(Destroy&& destroy)
+  {
+    size_t destroyed = 0;
+    for (const uint32_t index : pending_) {
+      Slot& slot = slots_[index];
+      // Skip anything acquired again since it was queued, or queued twice.
+      if (!slot.live || slot.ref_count != 0) {
+        continue;
+      }
+      std::invoke(destroy, slot.resource);
+      Free(index);
+      ++destroyed;
+    }
+    pending_.clear();
+    return destroyed;
+  }
+
+  // Destroy every resource whether or not it's still referenced. Outstanding handles become invalid.
+  template<typename Destroy> void Clear(Destroy&& destroy)
+  {
+    for (uint32_t index = 0; index < slots_.size(); ++index) {
+      if (slots_[index].live) {
+        std::invoke(destroy, slots_[index].resource);
+        Free(index);
+      }
+    }
+    pending_.clear();
+  }
+
+  // Number of live resources, including those waiting for Collect().
+  [[nodiscard]] size_t Size() const { return live_count_; }
+  [[nodiscard]] uint32_t RefCount(const ResourceHandle<T>& handle) const
+  {
+    return handle.Valid() ? slots_[handle.index_].ref_count : 0;
+  }
+
+private:
+  friend class ResourceHandle<T>;
+
+  struct Slot
+  {
+    T resource{};
+    std::string key;
+    uint32_t generation{ 0 };
+    uint32_t ref_count{ 0 };
+    bool live{ false };
+  };
+
+  struct KeyHash
+  {
+    using is_transparent = void;
+    using is_avalanching = void;
+    [[nodiscard]] uint64_t operator()(std::string_view key) const noexcept
+    {
+      return ankerl::unordered_dense::hash<std::string_view>{}(key);
+    }
+  };
+
+  T* Get(uint32_t index, uint32_t generation)
+  {
+    if (index < slots_.size() && slots_[index].live && slots_[index].generation == generation) {
+      return &slots_[index].resource;
+    }
+    return nullptr;
+  }
+
+  void AddRef(uint32_t index, uint32_t generation)
+  {
+    if (Get(index, generation) != nullptr) {
+      ++slots_[index].ref_count;
+    }
+  }
+
+  void Release(uint32_t index, uint32_t generation)
+  {
+    if (Get(index, generation) != nullptr && --slots_[index].ref_count == 0) {
+      pending_.push_back(index);
+    }
+  }
+
+  uint32_t AllocateSlot()
+  {
+    if (!free_slots_.empty()) {
+      const uint32_t index = free_slots_.back();
+      free_slots_.pop_back();
+      return index;
+    }
+    slots_.emplace_back();
+    return static_cast<uint32_t>(slots_.size() - 1);
+  }
+
+  void Free(uint32_t index)
+  {
+    Slot& slot = slots_[index];
+    keys_.erase(slot.key);
+    slot.key.clear();
+    slot.resource = T{};
+    slot.live = false;
+    slot.ref_count = 0;
+    // Any handle still pointing at this slot no longer matches.
+    ++slot.generation;
+    free_slots_.push_back(index);
+    --live_count_;
+  }
+
+  // A deque so resources don't move when the pool grows.
+  std::deque<Slot> slots_;
+  std::vector<uint32_t> free_slots_;
+  std::vector<uint32_t> pending_;
+  ankerl::unordered_dense::map<std::string, uint32_t, KeyHash, std::equal_to<>> keys_;
+  size_t live_count_{ 0 };
+};
+
+// A vertex buffer and the vertex array describing it.
+struct MeshResource
+{
+  VertexBuffer<> vertex_buffer;
+  VertexArray<> vertex_array;
+};
+
+using MeshHandle = ResourceHandle<MeshResource>;
+using TextureHandle = ResourceHandle<Texture2D>;
+using ShaderProgramHandle = ResourceHandle<ShaderProgram>;
+
+/**
+ * @brief Shared meshes, textures and shader programs. Loading something that's already loaded returns a handle to
+ * the existing GL objects, so e.g. spawning an entity that uses a loaded mesh creates no GL objects at all.
+ *
+ * Resources are destroyed by CollectGarbage() once nothing references them. The application calls it at the end of
+ * every frame.
+ */
+class EVIE_API ResourceManager
+{
+public:
+  // Start the texture loading workers. Must be called on the GL thread.
+  Error Initialise(size_t worker_count = ThreadPool::DefaultWorkerCount());
+
+  /**
+   * @brief Load a mesh from vertices in memory, e.g. one of default_models.
+   *
+   * @param key Unique name for the mesh such as "default_models::cube". vertices are only read the first time.
+   */
+  Result<MeshHandle> LoadMesh(std::string_view key, const std::vector<float>& vertices, const BufferLayout& layout);
+
+  Result<TextureHandle> LoadTexture(const std::string& path,
+    bool flip = false,
+    TextureWrapping wrapping = TextureWrapping::Repeat);
+
+  /**
+   * @brief Load a texture without blocking. The handle is usable straight away and refers to a placeholder until the
+   * image has been decoded on a worker thread and uploaded by Update(). If the texture is already loaded, or loading,
+   * the existing one is returned.
+   */
+  Result<TextureHandle> LoadTextureAsync(const std::string& path,
+    bool flip = false,
+    TextureWrapping wrapping = TextureWrapping::Repeat);
+
+  Result<ShaderProgramHandle> LoadShaderProgram(const std::string& vertex_path, const std::string& fragment_path);
+
+  // Finish asynchronous loads until the budget is spent. Call once per frame on the GL thread.
+  size_t Update(std::chrono::microseconds budget = AsyncTextureLoader::DefaultBudget);
+
+  // Destroy resources without handles. Call after the frame's draws have been issued.
+  size_t CollectGarbage();
+
+  // Destroy everything while the GL context is still alive. Outstanding handles become invalid.
+  void Destroy();
+
+  [[nodiscard]] size_t GetMeshCount() const { return meshes_.Size(); }
+  [[nodiscard]] size_t GetTextureCount() const { return textures_.Size(); }
+  [[nodiscard]] size_t GetShaderProgramCount() const { return shader_programs_.Size(); }
+  [[nodiscard]] size_t GetPendingTextureCount() const { return texture_loader_.GetPendingCount(); }
+
+  // The texture loading workers, for other loading work such as Model::Initialise(). Null until initialised.
+  [[nodiscard]] ThreadPool* GetWorkers() const { return texture_loader_.GetWorkers(); }
+
+  // Textures packed into shared texture arrays, for MeshComponent::texture_layer. Destroyed with everything else.
+  [[nodiscard]] TextureArrayManager& GetTextureArrays() { return texture_arrays_; }
+
+private:
+  static std::string TextureKey(const std::string& path, bool flip, TextureWrapping wrapping);
+  void DestroyTexture(Texture2D& texture) const;
+
+  AsyncTextureLoader texture_loader_;
+  ResourcePool<MeshResource> meshes_;
+  ResourcePool<Texture2D> textures_;
+  ResourcePool<ShaderProgram> shader_programs_;
+  TextureArrayManager texture_arrays_;
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_RESOURCE_MANAGER_H_
@@ -36,6 +36,7 @@ public:
         glGetShaderInfoLog(id_, log_length, nullptr, infoLog.data());
         EV_ERROR("ERROR::SHADER::COMPILATION_FAILED");
         EV_ERROR("{}", infoLog.data());
+        Destroy();
         return Error("Vertex shader failed to compile");
       }
       initialised_ = true;
@@ -44,6 +45,16 @@ public:
     return shader_code.Error();
   }
 
+  // Delete the shader object. Safe to call on a shader that was never initialised or is already destroyed.
+  void Destroy()
+  {
+    if (id_ != 0) {
+      glDeleteShader(id_);
+    }
+    id_ = 0;
+    initialised_ = false;
+  }
+
   [[nodiscard]] Result<ShaderID> GetID() const
   {
     // Suppress this check because it makes no sense.
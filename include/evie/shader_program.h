@@ -1,26 +1,73 @@
 #ifndef EVIE_RENDERING_SHADER_PROGRAM_H_
 #define EVIE_RENDERING_SHADER_PROGRAM_H_
 
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "ankerl/unordered_dense.h"
+
 #include "evie/error.h"
 #include "evie/ids.h"
 #include "evie/shader.h"
 #include <evie/types.h>
 
-
 namespace evie {
+
+// A uniform location resolved once after link. Setting through a handle skips the name lookup entirely.
+class UniformHandle
+{
+public:
+  UniformHandle() = default;
+  constexpr explicit UniformHandle(int location) : location_(location) {}
+
+  // False if the uniform doesn't exist or was optimised out. Setting an invalid handle is a no-op in GL.
+  [[nodiscard]] bool Valid() const { return location_ != -1; }
+  [[nodiscard]] int Location() const { return location_; }
+
+private:
+  int location_{ -1 };
+};
+
 class EVIE_API ShaderProgram
 {
 public:
+  /**
+   * @brief Link the shaders into a program. On success the shaders are destroyed, only the program is kept and they
+   * aren't referenced afterwards. On failure they're left for the caller to destroy.
+   */
   Error Initialise(VertexShader* vertex_shader, FragmentShader* fragment_shader);
   void Use() const;
-  void SetBool(const std::string& name, bool value) const;
-  void SetInt(const std::string& name, int value) const;
-  void SetFloat(const std::string& name, float value) const;
-  void SetMat4(const std::string& name, float* first_element) const;
-  void SetVec3(const std::string& name, evie::vec3 vec) const;
-  bool HasVec3(const std::string& name) const;
+
+  /**
+   * @brief Look up a uniform in the table built after link. Resolve handles once, e.g. at initialisation or when the
+   * program changes, and use the handle overloads below when drawing.
+   *
+   * @param name Name as written in GLSL, e.g. "model", "material.diffuse" or "point_lights[1].linear".
+   * @return UniformHandle An invalid handle if the program has no active uniform with that name.
+   */
+  [[nodiscard]] UniformHandle GetUniformHandle(std::string_view name) const;
+  [[nodiscard]] bool HasUniform(std::string_view name) const { return GetUniformHandle(name).Valid(); }
+
+  void SetBool(UniformHandle handle, bool value) const;
+  void SetInt(UniformHandle handle, int value) const;
+  void SetFloat(UniformHandle handle, float value) const;
+  void SetMat4(UniformHandle handle, const float* first_element) const;
+  void SetVec3(UniformHandle handle, evie::vec3 vec) const;
+
+  // Convenience overloads for setup code. These hash the name but never query the driver.
+  void SetBool(std::string_view name, bool value) const { SetBool(GetUniformHandle(name), value); }
+  void SetInt(std::string_view name, int value) const { SetInt(GetUniformHandle(name), value); }
+  void SetFloat(std::string_view name, float value) const { SetFloat(GetUniformHandle(name), value); }
+  void SetMat4(std::string_view name, const float* first_element) const
+  {
+    SetMat4(GetUniformHandle(name), first_element);
+  }
+  void SetVec3(std::string_view name, evie::vec3 vec) const { SetVec3(GetUniformHandle(name), vec); }
+  bool HasVec3(std::string_view name) const { return HasUniform(name); }
   void Destroy() const;
-  Result<ShaderProgramID> GetID()
+  Result<ShaderProgramID> GetID() const
   {
     Error err = CheckIfInitialised();
     if (err) {
@@ -30,6 +77,10 @@ public:
     return err;
   }
 
+  // Unique to each successful Initialise(), unlike the ID which GL can hand out again once a program is destroyed. Use
+  // it to tell whether state cached for a program, such as uniform handles, is still valid. 0 until initialised.
+  [[nodiscard]] uint64_t GetGeneration() const { return generation_; }
+
   [[nodiscard]] Error CheckIfInitialised() const
   {
     Error err = Error::OK();
@@ -40,10 +91,27 @@ public:
   }
 
 private:
-  VertexShader* vertex_shader_{ nullptr };
-  FragmentShader* fragment_shader_{ nullptr };
+  // Transparent so that lookups by std::string_view don't allocate.
+  struct UniformNameHash
+  {
+    using is_transparent = void;
+    using is_avalanching = void;
+    [[nodiscard]] uint64_t operator()(std::string_view name) const noexcept
+    {
+      return ankerl::unordered_dense::hash<std::string_view>{}(name);
+    }
+  };
+  using UniformTable = ankerl::unordered_dense::map<std::string, int, UniformNameHash, std::equal_to<>>;
+
+  // Query every active uniform once so that nothing after link has to call glGetUniformLocation.
+  void BuildUniformTable();
+  // Attach any of the shared blocks in uniform_blocks.h that the program declares to their binding points.
+  void BindUniformBlocks() const;
+
+  UniformTable uniforms_;
   bool initialised_{ false };
   unsigned int id_{ 0 };
+  uint64_t generation_{ 0 };
 };
 }// namespace evie
 
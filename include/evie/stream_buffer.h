@@ -0,0 +1,124 @@
+#ifndef EVIE_INCLUDE_STREAM_BUFFER_H_
+#define EVIE_INCLUDE_STREAM_BUFFER_H_
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+#include "evie/core.h"
+#include "evie/error.h"
+#include "evie/result.h"
+
+namespace evie {
+
+/**
+ * @brief Sub-allocates a buffer split into equally sized regions, one region per frame. Allocations are bump allocated
+ * from the current region and NextRegion() moves on to the next one, wrapping around. Kept separate from StreamBuffer
+ * so the arithmetic doesn't need a context.
+ */
+class StreamRingAllocator
+{
+public:
+  StreamRingAllocator() = default;
+  StreamRingAllocator(size_t region_size, size_t region_count)
+    : region_size_(region_size), region_count_(region_count)
+  {}
+
+  /**
+   * @brief Reserve size bytes in the current region.
+   *
+   * @param alignment Alignment of the returned offset, must be a power of two.
+   * @return std::optional<size_t> Byte offset from the start of the whole buffer, or empty if the region is full.
+   */
+  [[nodiscard]] std::optional<size_t> Allocate(size_t size, size_t alignment = 1)
+  {
+    const size_t aligned = (used_ + alignment - 1) & ~(alignment - 1);
+    if (aligned + size > region_size_) {
+      return std::nullopt;
+    }
+    used_ = aligned + size;
+    return region_ * region_size_ + aligned;
+  }
+
+  // Move to the next region and start allocating from its beginning.
+  void NextRegion()
+  {
+    region_ = (region_ + 1) % region_count_;
+    used_ = 0;
+  }
+
+  [[nodiscard]] size_t CurrentRegion() const { return region_; }
+  [[nodiscard]] size_t RegionSize() const { return region_size_; }
+  [[nodiscard]] size_t RegionCount() const { return region_count_; }
+  [[nodiscard]] size_t Used() const { return used_; }
+
+private:
+  size_t region_size_{ 0 };
+  size_t region_count_{ 1 };
+  size_t region_{ 0 };
+  size_t used_{ 0 };
+};
+
+/**
+ * @brief A buffer for data that is rewritten every frame, e.g. instance matrices, debug lines or particles.
+ *
+ * The buffer is split into RegionCount regions and each frame writes into the next one, so the CPU is writing one
+ * region while the GPU reads the previous ones. Writes map the range unsynchronised so the driver never stalls waiting
+ * for draws that are in flight. A fence is placed at the end of each frame and only waited on when the ring wraps
+ * around to a region the GPU still hasn't finished with, i.e. when the CPU is more than RegionCount frames ahead.
+ *
+ * Usage each frame:
+ *   stream.BeginFrame();
+ *   Result<size_t> offset = stream.Write(data, size);
+ *   ... draw reading from the buffer at *offset ...
+ *   stream.EndFrame();
+ */
+class EVIE_API StreamBuffer
+{
+public:
+  static constexpr size_t RegionCount = 3;
+
+  /**
+   * @brief Create the buffer.
+   *
+   * @param target Buffer target the data is read through, e.g. GL_ARRAY_BUFFER or GL_UNIFORM_BUFFER.
+   * @param region_size Maximum bytes that can be written in a single frame.
+   */
+  Error Initialise(unsigned int target, size_t region_size);
+
+  /**
+   * @brief Move on to the next region. Waits only if the GPU hasn't finished the frame that last used it.
+   */
+  void BeginFrame();
+
+  /**
+   * @brief Copy data into the current region. The buffer is left bound to its target.
+   *
+   * @param alignment Alignment of the returned offset, e.g. GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT for uniform blocks.
+   * @return Result<size_t> Byte offset of the data in the buffer or an error if the region is full.
+   */
+  Result<size_t> Write(const void* data, size_t size, size_t alignment = 1);
+
+  // Fence the current region. Call once all draws reading this frame's data have been issued.
+  void EndFrame();
+
+  void Destroy();
+
+  [[nodiscard]] bool IsInitialised() const { return id_ != 0; }
+  [[nodiscard]] unsigned int GetID() const { return id_; }
+  [[nodiscard]] size_t GetRegionSize() const { return ring_.RegionSize(); }
+  // Number of times BeginFrame() had to block on the GPU. Should stay at 0.
+  [[nodiscard]] size_t GetWaitCount() const { return wait_count_; }
+
+private:
+  unsigned int id_{ 0 };
+  unsigned int target_{ 0 };
+  StreamRingAllocator ring_;
+  // GLsync for each region, held as void* so GL headers aren't needed here.
+  std::array<void*, RegionCount> fences_{};
+  size_t wait_count_{ 0 };
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_STREAM_BUFFER_H_
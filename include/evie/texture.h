@@ -1,23 +1,82 @@
 #ifndef EVIE_RENDERING_TEXTURE_H_
 #define EVIE_RENDERING_TEXTURE_H_
 
+#include <cstddef>
+#include <memory>
 #include <string>
 
 #include "evie/core.h"
 #include "evie/error.h"
 #include "evie/ids.h"
+#include "evie/result.h"
 
 #include "glad/glad.h"
 
 namespace evie {
 
+class BakedTexture;
+
 enum class TextureType { Diffuse, Specular };
 
 enum class TextureWrapping { Repeat, MirroredRepeat, ClampToEdge, ClampToBorder };
+
+struct ImageInfo
+{
+  int width{ 0 };
+  int height{ 0 };
+  // 2, 3 or 4 bytes per pixel.
+  int channels{ 0 };
+
+  [[nodiscard]] size_t Size() const
+  {
+    return static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(channels);
+  }
+};
+
+struct EVIE_API ImageFree
+{
+  void operator()(unsigned char* pixels) const;
+};
+
+// Tightly packed 8 bit pixels decoded from an image file.
+struct DecodedImage
+{
+  ImageInfo info;
+  std::unique_ptr<unsigned char, ImageFree> pixels;
+};
+
+/**
+ * @brief Read and decode an image file. Doesn't touch GL so it's safe to call from any thread.
+ *
+ * @param flip Flip vertically so the first row is the bottom of the image, as GL expects.
+ */
+EVIE_API Result<DecodedImage> DecodeImage(const std::string& filename, bool flip = false);
+
 class EVIE_API Texture2D
 {
 public:
+  /**
+   * @brief Load an image file, or a baked texture if filename ends in BakedTextureExtension.
+   *
+   * @param flip Baked textures are flipped when baked, a warning is logged if that doesn't match.
+   */
   Error Initialise(const std::string& filename, bool flip = false, TextureWrapping wrapping = TextureWrapping::Repeat);
+
+  /**
+   * @brief Create the texture from decoded pixels.
+   *
+   * @param pixels The pixel data, or the byte offset into it if a buffer is bound to GL_PIXEL_UNPACK_BUFFER.
+   * @param name Usually the file the pixels came from.
+   */
+  Error Initialise(const ImageInfo& info,
+    const void* pixels,
+    const std::string& name,
+    TextureWrapping wrapping = TextureWrapping::Repeat);
+
+  // Upload every level of a baked texture as it is, no mipmaps are generated.
+  Error Initialise(const BakedTexture& baked,
+    const std::string& name,
+    TextureWrapping wrapping = TextureWrapping::Repeat);
   void SetSlot(int slot);
   void Bind();
   void Destroy();
@@ -29,6 +88,9 @@ public:
   TextureID GetID() const { return id_; }
 
 private:
+  // Generate and bind the texture and set its sampling parameters.
+  void CreateTexture(TextureWrapping wrapping);
+
   TextureID id_{ 0 };
   int texture_slot_{ 0 };
   int width_{ 0 };
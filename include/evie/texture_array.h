@@ -0,0 +1,145 @@
+#ifndef EVIE_INCLUDE_TEXTURE_ARRAY_H_
+#define EVIE_INCLUDE_TEXTURE_ARRAY_H_
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ankerl/unordered_dense.h"
+
+#include "evie/core.h"
+#include "evie/error.h"
+#include "evie/ids.h"
+#include "evie/result.h"
+#include "evie/texture.h"
+
+namespace evie {
+
+// Only textures with the same size and channels can share an array.
+struct TextureArrayFormat
+{
+  int width{ 0 };
+  int height{ 0 };
+  int channels{ 0 };
+
+  auto operator<=>(const TextureArrayFormat&) const = default;
+};
+
+/**
+ * @brief Hands out layers of texture arrays, starting a new array when every array of a format is full. Doesn't touch
+ * GL, TextureArrayManager creates the arrays.
+ */
+class EVIE_API TextureLayerAllocator
+{
+public:
+  struct Allocation
+  {
+    size_t array{ 0 };
+    uint32_t layer{ 0 };
+    // The array was made for this allocation and needs creating.
+    bool new_array{ false };
+  };
+
+  explicit TextureLayerAllocator(uint32_t layers_per_array) : layers_per_array_(layers_per_array) {}
+
+  Allocation Allocate(const TextureArrayFormat& format);
+  // The layer can be handed out again, its array is kept.
+  void Free(size_t array, uint32_t layer);
+
+  [[nodiscard]] size_t GetArrayCount() const { return arrays_.size(); }
+  [[nodiscard]] uint32_t GetUsedLayers(size_t array) const { return arrays_[array].used; }
+
+private:
+  struct ArrayState
+  {
+    TextureArrayFormat format;
+    // Layers below this have been handed out at some point, free_layers holds those given back since.
+    uint32_t used{ 0 };
+    std::vector<uint32_t> free_layers;
+  };
+
+  uint32_t layers_per_array_;
+  std::vector<ArrayState> arrays_;
+};
+
+// A GL_TEXTURE_2D_ARRAY with a fixed number of layers, sampled in shaders as a sampler2DArray.
+class EVIE_API TextureArray
+{
+public:
+  // Allocate every layer up front, GL 3.3 can't grow an array without copying it through the CPU. Layers repeat.
+  Error Initialise(const TextureArrayFormat& format, uint32_t layers);
+
+  // Pixels must be tightly packed and match the array's format. Mipmaps are regenerated when next bound.
+  Error Upload(uint32_t layer, const void* pixels);
+
+  void SetSlot(int slot);
+  void Bind();
+  void Destroy();
+
+  [[nodiscard]] TextureID GetID() const { return id_; }
+  [[nodiscard]] const TextureArrayFormat& GetFormat() const { return format_; }
+  [[nodiscard]] uint32_t GetLayerCount() const { return layers_; }
+
+private:
+  TextureID id_{ 0 };
+  TextureArrayFormat format_;
+  uint32_t layers_{ 0 };
+  bool mipmaps_dirty_{ false };
+};
+
+// Where a texture lives in a TextureArrayManager. Pass both to a DrawCommand.
+struct TextureLayer
+{
+  TextureArray* array{ nullptr };
+  uint32_t layer{ 0 };
+
+  [[nodiscard]] bool Valid() const { return array != nullptr; }
+};
+
+/**
+ * @brief Packs textures of the same size into the layers of shared texture arrays, so draws that only differ by
+ * texture can be batched. The layer is passed per instance rather than binding a different texture per draw, see
+ * DrawCommand::texture_array.
+ */
+class EVIE_API TextureArrayManager
+{
+public:
+  // 16 layers of 1024x1024 RGBA is 64MB, a new array is only made when one fills up.
+  static constexpr uint32_t DefaultLayersPerArray = 16;
+
+  explicit TextureArrayManager(uint32_t layers_per_array = DefaultLayersPerArray)
+    : allocator_(layers_per_array), layers_per_array_(layers_per_array)
+  {}
+
+  /**
+   * @brief Load an image file into a layer, or return its layer if it's already loaded.
+   *
+   * @param flip Flip vertically so the first row is the bottom of the image, as GL expects.
+   */
+  Result<TextureLayer> Load(const std::string& path, bool flip = false);
+
+  // Copy decoded pixels into a free layer. Not cached, Remove() the layer when done with it.
+  Result<TextureLayer> Add(const ImageInfo& info, const void* pixels);
+
+  // Give a layer back. The pixels stay until the layer is reused.
+  void Remove(const TextureLayer& layer);
+  void Unload(const std::string& path);
+
+  void Destroy();
+
+  [[nodiscard]] size_t GetArrayCount() const { return arrays_.size(); }
+
+private:
+  TextureLayerAllocator allocator_;
+  uint32_t layers_per_array_;
+  // Pointers to arrays are handed out so they're kept behind unique_ptr.
+  std::vector<std::unique_ptr<TextureArray>> arrays_;
+  ankerl::unordered_dense::map<std::string, TextureLayer> loaded_;
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_TEXTURE_ARRAY_H_
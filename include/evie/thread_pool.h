@@ -0,0 +1,187 @@
+#ifndef EVIE_INCLUDE_THREAD_POOL_H_
+#define EVIE_INCLUDE_THREAD_POOL_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace evie {
+
+/**
+ * @brief A fixed set of worker threads running jobs in submission order. Jobs must not touch GL, hand the results
+ * back to the GL thread instead.
+ *
+ * Destroying the pool waits for the jobs that are running and drops any that haven't started.
+ */
+class ThreadPool
+{
+public:
+  // One less than the hardware threads so the main thread keeps a core, but always at least one.
+  static size_t DefaultWorkerCount()
+  {
+    const unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 1;
+  }
+
+  explicit ThreadPool(size_t worker_count = DefaultWorkerCount())
+  {
+    worker_count = std::max<size_t>(worker_count, 1);
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+      workers_.emplace_back([this] { Run(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  ~ThreadPool()
+  {
+    {
+      const std::scoped_lock lock(mutex_);
+      stopping_ = true;
+      jobs_.clear();
+    }
+    job_added_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  void Submit(std::function<void()> job)
+  {
+    {
+      const std::scoped_lock lock(mutex_);
+      jobs_.push_back(std::move(job));
+    }
+    job_added_.notify_one();
+  }
+
+  // Block until every submitted job has finished, including other users'. Use a TaskGroup to wait for just yours.
+  void Wait()
+  {
+    std::unique_lock lock(mutex_);
+    idle_.wait(lock, [this] { return jobs_.empty() && running_ == 0; });
+  }
+
+  [[nodiscard]] size_t WorkerCount() const { return workers_.size(); }
+
+private:
+  void Run()
+  {
+    while (true) {
+      std::function<void()> job;
+      {
+        std::unique_lock lock(mutex_);
+        job_added_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (stopping_) {
+          return;
+        }
+        job = std::move(jobs_.front());
+        jobs_.pop_front();
+        ++running_;
+      }
+      job();
+      {
+        const std::scoped_lock lock(mutex_);
+        --running_;
+      }
+      idle_.notify_all();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable job_added_;
+  std::condition_variable idle_;
+  std::deque<std::function<void()>> jobs_;
+  size_t running_{ 0 };
+  bool stopping_{ false };
+  std::vector<std::thread> workers_;
+};
+
+/**
+ * @brief Jobs that can be waited on apart from everything else on a ThreadPool. Wait() runs any of the group's jobs
+ * that no worker has started yet on the calling thread, then waits only for the ones already running. So it never
+ * waits on other users of the pool, and is safe to call from one of the pool's own workers.
+ *
+ * Without a pool every job runs on the calling thread in Wait().
+ */
+class TaskGroup
+{
+public:
+  explicit TaskGroup(ThreadPool* pool) : pool_(pool), state_(std::make_shared<State>()) {}
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup(TaskGroup&&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+  TaskGroup& operator=(TaskGroup&&) = delete;
+  // Jobs usually reference the caller's locals, so they're all finished before the group goes away.
+  ~TaskGroup() { Wait(); }
+
+  void Submit(std::function<void()> job)
+  {
+    {
+      const std::scoped_lock lock(state_->mutex);
+      state_->jobs.push_back(std::move(job));
+    }
+    if (pool_ != nullptr) {
+      // The pool only gets a ticket to run one of the group's jobs. If Wait() has already run them all it does
+      // nothing, so it's fine for it to outlive the group.
+      pool_->Submit([state = state_] { RunOne(*state); });
+    }
+  }
+
+  void Wait()
+  {
+    while (RunOne(*state_)) {
+    }
+    std::unique_lock lock(state_->mutex);
+    state_->finished.wait(lock, [this] { return state_->running == 0; });
+  }
+
+private:
+  struct State
+  {
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::deque<std::function<void()>> jobs;
+    size_t running{ 0 };
+  };
+
+  // Run the oldest job that hasn't started, returning false if there wasn't one.
+  static bool RunOne(State& state)
+  {
+    std::function<void()> job;
+    {
+      const std::scoped_lock lock(state.mutex);
+      if (state.jobs.empty()) {
+        return false;
+      }
+      job = std::move(state.jobs.front());
+      state.jobs.pop_front();
+      ++state.running;
+    }
+    job();
+    {
+      const std::scoped_lock lock(state.mutex);
+      --state.running;
+    }
+    state.finished.notify_all();
+    return true;
+  }
+
+  ThreadPool* pool_;
+  std::shared_ptr<State> state_;
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_THREAD_POOL_H_
@@ -1,6 +1,7 @@
 #ifndef EVIE_INCLUDE_TYPES_H_
 #define EVIE_INCLUDE_TYPES_H_
 
+#include <cstdint>
 #include <string>
 
 #include <glm/vec3.hpp>
@@ -13,10 +14,20 @@ struct WindowDimensions
   int width{ 0 };
   int height{ 0 };
 };
+enum class VSyncMode : uint8_t {
+  Off,
+  // Wait for the display's vertical blank before presenting.
+  On,
+  // Wait for the vertical blank unless the frame is already late, then present straight away and tear rather than
+  // stall for a whole refresh. Falls back to On where the driver doesn't support it.
+  Adaptive
+};
+
 struct WindowProperties
 {
   WindowDimensions dimensions;
   std::string name;
+  VSyncMode vsync{ VSyncMode::On };
 };
 struct MousePosition
 {
@@ -0,0 +1,86 @@
+#ifndef EVIE_INCLUDE_UNIFORM_BLOCKS_H_
+#define EVIE_INCLUDE_UNIFORM_BLOCKS_H_
+
+#include <array>
+#include <string_view>
+
+#include "evie/types.h"
+
+// C++ mirrors of the std140 uniform blocks shared by the shaders in /shaders. Every vec3 is aligned to 16 bytes and
+// scalars are packed into the padding after a vec3 so the structs match the GLSL declarations byte for byte. Keep the
+// two in sync, test/uniform_buffer_tests.cpp checks the offsets against Std140Layout.
+
+namespace evie {
+
+constexpr unsigned int FrameBlockBinding = 0;
+constexpr unsigned int LightsBlockBinding = 1;
+
+struct UniformBlockInfo
+{
+  std::string_view name;
+  unsigned int binding;
+};
+
+// Blocks that ShaderProgram attaches to their binding point after link. GLSL 330 can't declare the binding itself.
+constexpr std::array<UniformBlockInfo, 2> UniformBlocks{ { { "Frame", FrameBlockBinding },
+  { "Lights", LightsBlockBinding } } };
+
+// layout(std140) uniform Frame
+struct FrameBlock
+{
+  mat4 view{ 1.0F };
+  mat4 projection{ 1.0F };
+  mat4 inverse_transpose_view{ 1.0F };
+  alignas(16) vec3 view_position{ 0.0F };
+  // Seconds since the application started.
+  float time{ 0.0F };
+};
+
+struct DirectionalLightData
+{
+  alignas(16) vec3 direction{ 0.0F, -1.0F, 0.0F };
+  alignas(16) vec3 ambient{ 0.0F };
+  alignas(16) vec3 diffuse{ 0.0F };
+  alignas(16) vec3 specular{ 0.0F };
+};
+
+struct PointLightData
+{
+  alignas(16) vec3 position{ 0.0F };
+  float constant{ 1.0F };
+  alignas(16) vec3 ambient{ 0.0F };
+  float linear{ 0.0F };
+  alignas(16) vec3 diffuse{ 0.0F };
+  float quadratic{ 0.0F };
+  alignas(16) vec3 specular{ 0.0F };
+};
+
+struct SpotLightData
+{
+  alignas(16) vec3 position{ 0.0F };
+  // Cosines of the inner and outer cone angles.
+  float cut_off{ 1.0F };
+  alignas(16) vec3 direction{ 0.0F, 0.0F, -1.0F };
+  float outer_cut_off{ 1.0F };
+  alignas(16) vec3 ambient{ 0.0F };
+  float constant{ 1.0F };
+  alignas(16) vec3 diffuse{ 0.0F };
+  float linear{ 0.0F };
+  alignas(16) vec3 specular{ 0.0F };
+  float quadratic{ 0.0F };
+};
+
+// Matches NR_POINT_LIGHTS in the lighting shaders.
+constexpr size_t MaxPointLights = 4;
+
+// layout(std140) uniform Lights
+struct LightsBlock
+{
+  DirectionalLightData directional_light;
+  std::array<PointLightData, MaxPointLights> point_lights;
+  SpotLightData spot_light;
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_UNIFORM_BLOCKS_H_
@@ -0,0 +1,147 @@
+#ifndef EVIE_INCLUDE_UNIFORM_BUFFER_H_
+#define EVIE_INCLUDE_UNIFORM_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "evie/core.h"
+#include "evie/error.h"
+
+namespace evie {
+
+enum class Std140Type : uint8_t { Int, Float, Vec2, Vec3, Vec4, Mat4 };
+
+/**
+ * @brief Computes member offsets following the std140 rules so that C++ structs mirroring a GLSL uniform block can be
+ * checked against it. Members are added in declaration order:
+ *
+ *   Std140Layout layout;
+ *   layout.Add(Std140Type::Mat4);      // 0
+ *   layout.Add(Std140Type::Vec3);      // 64
+ *   layout.Add(Std140Type::Float);     // 76, packs into the vec3's padding
+ *   layout.Add(Std140Type::Vec4, 4);   // 80, arrays are aligned and strided to 16 bytes
+ */
+class Std140Layout
+{
+public:
+  static constexpr size_t Vec4Alignment = 16;
+
+  [[nodiscard]] static constexpr size_t Alignment(Std140Type type)
+  {
+    switch (type) {
+    case Std140Type::Int:
+    case Std140Type::Float:
+      return 4;
+    case Std140Type::Vec2:
+      return 8;
+    case Std140Type::Vec3:
+    case Std140Type::Vec4:
+    case Std140Type::Mat4:
+      return Vec4Alignment;
+    }
+    return Vec4Alignment;
+  }
+
+  [[nodiscard]] static constexpr size_t Size(Std140Type type)
+  {
+    switch (type) {
+    case Std140Type::Int:
+    case Std140Type::Float:
+      return 4;
+    case Std140Type::Vec2:
+      return 8;
+    case Std140Type::Vec3:
+      return 12;
+    case Std140Type::Vec4:
+      return 16;
+    case Std140Type::Mat4:
+      return 64;
+    }
+    return 0;
+  }
+
+  [[nodiscard]] static constexpr size_t RoundUp(size_t value, size_t alignment)
+  {
+    return (value + alignment - 1) / alignment * alignment;
+  }
+
+  /**
+   * @brief Add a member, or an array of members if count > 1.
+   *
+   * @return size_t Byte offset of the member from the start of the block.
+   */
+  constexpr size_t Add(Std140Type type, size_t count = 1)
+  {
+    if (count > 1) {
+      // Array elements are aligned and padded to a vec4, whatever their type.
+      const size_t stride = RoundUp(Size(type), Vec4Alignment);
+      const size_t offset = RoundUp(size_, Vec4Alignment);
+      size_ = offset + stride * count;
+      return offset;
+    }
+    const size_t offset = RoundUp(size_, Alignment(type));
+    size_ = offset + Size(type);
+    return offset;
+  }
+
+  /**
+   * @brief Start a struct member. Structs are aligned to a vec4 and their members are laid out as normal.
+   *
+   * @return size_t Byte offset of the struct from the start of the block.
+   */
+  constexpr size_t BeginStruct()
+  {
+    size_ = RoundUp(size_, Vec4Alignment);
+    return size_;
+  }
+
+  // Finish a struct member. Its size is padded up to a multiple of a vec4.
+  constexpr void EndStruct() { size_ = RoundUp(size_, Vec4Alignment); }
+
+  // Size of the block so far. A buffer backing the block needs to be at least this big.
+  [[nodiscard]] constexpr size_t Size() const { return RoundUp(size_, Vec4Alignment); }
+
+private:
+  size_t size_{ 0 };
+};
+
+/**
+ * @brief A uniform buffer object attached to a fixed binding point. Shader programs bind their blocks to the same
+ * points after link (see uniform_blocks.h) so data shared by every draw, e.g. the camera, is uploaded once per frame
+ * rather than once per program or per draw.
+ */
+class EVIE_API UniformBuffer
+{
+public:
+  /**
+   * @brief Create the buffer storage and attach it to the binding point.
+   *
+   * @param size Size of the block in bytes.
+   * @param binding Uniform buffer binding point.
+   */
+  Error Initialise(size_t size, unsigned int binding);
+
+  template<typename Block> Error Initialise(unsigned int binding) { return Initialise(sizeof(Block), binding); }
+
+  /**
+   * @brief Upload data into the buffer. The data must already be in std140 layout.
+   */
+  void Update(const void* data, size_t size, size_t offset = 0) const;
+
+  template<typename Block> void Update(const Block& block) const { Update(&block, sizeof(Block)); }
+
+  void Destroy();
+
+  [[nodiscard]] bool IsInitialised() const { return id_ != 0; }
+  [[nodiscard]] unsigned int GetBinding() const { return binding_; }
+  [[nodiscard]] size_t GetSize() const { return size_; }
+
+private:
+  unsigned int id_{ 0 };
+  unsigned int binding_{ 0 };
+  size_t size_{ 0 };
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_UNIFORM_BUFFER_H_
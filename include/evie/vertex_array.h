@@ -6,6 +6,7 @@
 #include "evie/ids.h"
 #include "evie/indices_array.h"
 #include "evie/vertex_buffer.h"
+#include "rendering/gl_state_cache.h"
 
 
 namespace evie {
@@ -30,6 +31,8 @@ constexpr evie::Result<OpenGLTypeAndSize> ConvertVertexDataTypeToOpenGL(evie::Ve
     return { static_cast<GLenum>(GL_UNSIGNED_SHORT), sizeof(unsigned short) };
   case evie::VertexDataType::Int:
     return { static_cast<GLenum>(GL_INT), sizeof(int) };
+  case evie::VertexDataType::HalfFloat:
+    return { static_cast<GLenum>(GL_HALF_FLOAT), sizeof(uint16_t) };
   case evie::VertexDataType::Float:
     return { static_cast<GLenum>(GL_FLOAT), sizeof(float) };
   case evie::VertexDataType::Double:
@@ -39,6 +42,65 @@ constexpr evie::Result<OpenGLTypeAndSize> ConvertVertexDataTypeToOpenGL(evie::Ve
   }
 }
 
+/**
+ * @brief Point the attributes described by layout at the buffer bound to GL_ARRAY_BUFFER, for the bound vertex array.
+ *
+ * @param first_attribute The attribute location of the first entry in the layout.
+ * @param byte_offset Offset of the first vertex in the buffer.
+ * @param divisor 0 for per vertex data, otherwise the number of instances that share each element.
+ */
+inline Error SetVertexAttributePointers(const BufferLayout& buffer_layout,
+  GLuint first_attribute = 0,
+  size_t byte_offset = 0,
+  GLuint divisor = 0)
+{
+  if (!buffer_layout.attributes.empty()) {
+    // Mixed types, stride and offsets are in bytes.
+    size_t offset = 0;
+    for (size_t i = 0; i < buffer_layout.attributes.size(); ++i) {
+      const VertexAttribute& vertex_attribute = buffer_layout.attributes[i];
+      Result<OpenGLTypeAndSize> type_and_size = ConvertVertexDataTypeToOpenGL(vertex_attribute.type);
+      if (type_and_size.Bad()) {
+        return type_and_size.Error();
+      }
+      const auto attribute = static_cast<GLuint>(first_attribute + i);
+      CallOpenGL(glVertexAttribPointer,
+        attribute,
+        vertex_attribute.size,
+        type_and_size->type,
+        vertex_attribute.normalised,
+        static_cast<GLsizei>(buffer_layout.stride),
+        reinterpret_cast<void*>(byte_offset + offset));// NOLINT(*-reinterpret-cast)
+      CallOpenGL(glEnableVertexAttribArray, attribute);
+      CallOpenGL(glVertexAttribDivisor, attribute, divisor);
+      offset += buffer_layout.layout_sizes[i];
+    }
+    return Error::OK();
+  }
+
+  // Convert Evie layout type to OpenGL
+  Result<OpenGLTypeAndSize> type_and_size;
+  if (type_and_size = ConvertVertexDataTypeToOpenGL(buffer_layout.type); type_and_size.Bad()) {
+    return type_and_size.Error();
+  }
+  // Iterate over the layout sizes of the buffer_layout and set attribute pointers
+  size_t offset = 0;
+  for (size_t i = 0; i < buffer_layout.layout_sizes.size(); ++i) {
+    const auto attribute = static_cast<GLuint>(first_attribute + i);
+    CallOpenGL(glVertexAttribPointer,
+      attribute,
+      buffer_layout.layout_sizes[i],
+      type_and_size->type,
+      false,
+      static_cast<GLsizei>(buffer_layout.stride * type_and_size->size),
+      reinterpret_cast<void*>(byte_offset + type_and_size->size * offset));// NOLINT(*-reinterpret-cast)
+    CallOpenGL(glEnableVertexAttribArray, attribute);
+    CallOpenGL(glVertexAttribDivisor, attribute, divisor);
+    offset += buffer_layout.layout_sizes[i];
+  }
+  return Error::OK();
+}
+
 template<typename VertexType = float> class EVIE_API VertexArray
 {
 public:
@@ -48,6 +110,8 @@ public:
   void Bind() const;
   void Destroy();
 
+  [[nodiscard]] VertexArrayID GetID() const { return id_; }
+
 private:
   VertexBuffer<VertexType>* vertex_buffer_{ nullptr };
   IndicesArray* indices_array_{ nullptr };
@@ -69,26 +133,7 @@ Error VertexArray<VertexType>::AssociateVertexBuffer(VertexBuffer<VertexType>& v
   Bind();
   // Bind the vertex buffer to associate it to the vertex array
   vertex_buffer.Bind();
-  const auto& buffer_layout = vertex_buffer.GetBufferLayout();
-  // Convert Evie layout type to OpenGL
-  Result<OpenGLTypeAndSize> type_and_size;
-  if (type_and_size = ConvertVertexDataTypeToOpenGL(buffer_layout.type); type_and_size.Bad()) {
-    return type_and_size.Error();
-  }
-  // Iterate over the layout sizes of the buffer_layout and set attribute pointers
-  int offset = 0;
-  for (size_t i = 0; i < buffer_layout.layout_sizes.size(); ++i) {
-    CallOpenGL(glVertexAttribPointer,
-      static_cast<GLuint>(i),
-      buffer_layout.layout_sizes[i],
-      type_and_size->type,
-      false,
-      static_cast<GLsizei>(buffer_layout.stride * type_and_size->size),
-      reinterpret_cast<void*>(type_and_size->size * offset));
-    CallOpenGL(glEnableVertexAttribArray, static_cast<GLuint>(i));
-    offset += buffer_layout.layout_sizes[i];
-  }
-  return Error::OK();
+  return SetVertexAttributePointers(vertex_buffer.GetBufferLayout());
 }
 
 template<typename VertexType> void VertexArray<VertexType>::AssociateIndicesArray(IndicesArray& indices_array)
@@ -97,11 +142,15 @@ template<typename VertexType> void VertexArray<VertexType>::AssociateIndicesArra
   indices_array.Bind();
 }
 
-template<typename VertexType> void VertexArray<VertexType>::Bind() const { CallOpenGL(glBindVertexArray, id_.Get()); }
+template<typename VertexType> void VertexArray<VertexType>::Bind() const
+{
+  GLStateCache::Get().BindVertexArray(id_.Get());
+}
 
 template<typename VertexType> void VertexArray<VertexType>::Destroy()
 {
   CallOpenGL(glDeleteVertexArrays, 1, &id_.Get());
+  GLStateCache::Get().OnVertexArrayDeleted(id_.Get());
 }
 }// namespace evie
 
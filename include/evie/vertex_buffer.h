@@ -1,20 +1,53 @@
 #ifndef EVIE_INCLUDE_VERTEX_BUFFER_H_
 #define EVIE_INCLUDE_VERTEX_BUFFER_H_
 
+#include <algorithm>
 #include <evie/logging.h>
 #include <numeric>
+#include <span>
 #include <vector>
 
+#include "evie/buffer_retention.h"
 #include "evie/core.h"
 #include "evie/error.h"
+#include "evie/frustum_culling.h"
 #include "evie/ids.h"
 #include "rendering/debug.h"
+#include "rendering/gl_state_cache.h"
 
 #include "glad/glad.h"
 
 namespace evie {
 
-enum class VertexDataType { Byte, UnsignedByte, Short, UnsignedShort, Int, Float, Double };
+enum class VertexDataType { Byte, UnsignedByte, Short, UnsignedShort, Int, HalfFloat, Float, Double };
+
+constexpr size_t SizeOfVertexDataType(VertexDataType type)
+{
+  switch (type) {
+  case VertexDataType::Byte:
+  case VertexDataType::UnsignedByte:
+    return 1;
+  case VertexDataType::Short:
+  case VertexDataType::UnsignedShort:
+  case VertexDataType::HalfFloat:
+    return 2;
+  case VertexDataType::Int:
+  case VertexDataType::Float:
+    return 4;
+  case VertexDataType::Double:
+    return 8;
+  }
+  return 0;
+}
+
+// One attribute of a layout whose attributes don't all share a type.
+struct VertexAttribute
+{
+  uint16_t size{ 0 };
+  VertexDataType type{ VertexDataType::Float };
+  // Integer types are read as [0, 1] or [-1, 1] rather than converted to float as they are.
+  bool normalised{ false };
+};
 
 struct BufferLayout
 {
@@ -22,31 +55,68 @@ struct BufferLayout
   BufferLayout(uint16_t stride, VertexDataType type, const std::vector<uint16_t>& layout_sizes)
     : stride(stride), type(type), layout_sizes(layout_sizes)
   {}
+  // Mixed types. The layout is then described in bytes so stride and layout_sizes still add up.
+  explicit BufferLayout(const std::vector<VertexAttribute>& attributes)
+    : type(VertexDataType::UnsignedByte), attributes(attributes)
+  {
+    for (const auto& attribute : attributes) {
+      const auto bytes = static_cast<uint16_t>(attribute.size * SizeOfVertexDataType(attribute.type));
+      layout_sizes.push_back(bytes);
+      stride = static_cast<uint16_t>(stride + bytes);
+    }
+  }
   uint16_t stride{ 0 };
   VertexDataType type{ VertexDataType::Float };
   std::vector<uint16_t> layout_sizes;
+  // Empty unless the layout has mixed types.
+  std::vector<VertexAttribute> attributes;
 };
 
 template<typename T = float> class EVIE_API VertexBuffer
 {
 public:
-  Error Initialise(const std::vector<T>& vertices_data, const BufferLayout& buffer_layout);
+  /**
+   * @brief Upload the vertices to a new buffer. They're only read during the call so they can live anywhere, e.g. in a
+   * mapped file.
+   *
+   * @param retention By default the CPU copy isn't kept once it's on the GPU. Use BufferRetention::Retain if the
+   * vertices are needed later through GetBuffer().
+   */
+  Error Initialise(std::span<const T> vertices_data,
+    const BufferLayout& buffer_layout,
+    BufferRetention retention = BufferRetention::Release);
   void Bind();
   void Destroy();
   [[nodiscard]] const BufferLayout& GetBufferLayout() const { return buffer_layout_; }
 
+  // Overwrite the start of the buffer. Must be no larger than the data the buffer was initialised with.
   void UpdateBuffer(const std::vector<T>& vertices_data);
 
+  // The CPU copy of the vertices. Empty unless the buffer was initialised with BufferRetention::Retain.
   [[nodiscard]] const std::vector<T>& GetBuffer() const { return vertices_data_; }
 
+  [[nodiscard]] size_t GetVertexCount() const { return vertex_count_; }
+  [[nodiscard]] size_t GetSizeInBytes() const { return size_in_bytes_; }
+  [[nodiscard]] BufferRetention GetRetention() const { return retention_; }
+
+  // Model space bounds of the positions in the buffer. Only calculated for float layouts where the first attribute is
+  // a 3 component position, otherwise it's left zero sized.
+  [[nodiscard]] const BoundingVolume& GetBoundingVolume() const { return bounding_volume_; }
+
 private:
   std::vector<T> vertices_data_{};
+  size_t vertex_count_{ 0 };
+  size_t size_in_bytes_{ 0 };
+  BufferRetention retention_{ BufferRetention::Release };
   BufferLayout buffer_layout_{};
+  BoundingVolume bounding_volume_{};
   VertexBufferID id_{ 0 };
 };
 
 template<typename T>
-Error VertexBuffer<T>::Initialise(const std::vector<T>& vertices_data, const BufferLayout& buffer_layout)
+Error VertexBuffer<T>::Initialise(std::span<const T> vertices_data,
+  const BufferLayout& buffer_layout,
+  BufferRetention retention)
 {
   unsigned int VBO{ 0 };
   CallOpenGL(glGenBuffers, 1, &VBO);
@@ -65,17 +135,45 @@ Error VertexBuffer<T>::Initialise(const std::vector<T>& vertices_data, const Buf
     return Error{ "Vertices data size isn't a multiple of the buffer layout" };
   }
   buffer_layout_ = buffer_layout;
-  vertices_data_ = vertices_data;
+  retention_ = retention;
+  size_in_bytes_ = vertices_data.size() * sizeof(T);
+  vertex_count_ = size_in_bytes_ / (buffer_layout.stride * SizeOfVertexDataType(buffer_layout.type));
+  if (retention_ == BufferRetention::Retain) {
+    vertices_data_.assign(vertices_data.begin(), vertices_data.end());
+  }
+  if (buffer_layout.type == VertexDataType::Float && buffer_layout.layout_sizes[0] >= 3) {
+    // T is either float or a struct made purely of floats (see Mesh Vertex) so it's safe to view it as floats.
+    bounding_volume_ = CalculateBoundingVolume(reinterpret_cast<const float*>(vertices_data.data()),// NOLINT
+      vertices_data.size() * sizeof(T) / sizeof(float),
+      buffer_layout.stride);
+  } else if (!buffer_layout.attributes.empty() && buffer_layout.attributes[0].type == VertexDataType::Float
+             && buffer_layout.attributes[0].size >= 3 && buffer_layout.stride % sizeof(float) == 0) {
+    // Mixed layouts starting with a float position, e.g. followed by normalised byte normals.
+    bounding_volume_ = CalculateBoundingVolume(reinterpret_cast<const float*>(vertices_data.data()),// NOLINT
+      vertices_data.size() * sizeof(T) / sizeof(float),
+      buffer_layout.stride / sizeof(float));
+  }
   CallOpenGL(glBufferData, GL_ARRAY_BUFFER, vertices_data.size() * sizeof(T), vertices_data.data(), GL_STATIC_DRAW);
   return Error::OK();
 }
 
-template<typename T> void VertexBuffer<T>::Bind() { CallOpenGL(glBindBuffer, GL_ARRAY_BUFFER, id_.Get()); }
+template<typename T> void VertexBuffer<T>::Bind() { GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, id_.Get()); }
 
-template<typename T> void VertexBuffer<T>::Destroy() { CallOpenGL(glDeleteBuffers, 1, &id_.Get()); }
+template<typename T> void VertexBuffer<T>::Destroy()
+{
+  CallOpenGL(glDeleteBuffers, 1, &id_.Get());
+  GLStateCache::Get().OnBufferDeleted(id_.Get());
+}
 
 template<typename T> void VertexBuffer<T>::UpdateBuffer(const std::vector<T>& vertices_data)
 {
+  if (vertices_data.size() * sizeof(T) > size_in_bytes_) {
+    EV_ERROR("VertexBuffer::UpdateBuffer data is larger than the buffer");
+    return;
+  }
+  if (retention_ == BufferRetention::Retain) {
+    std::copy(vertices_data.begin(), vertices_data.end(), vertices_data_.begin());
+  }
   Bind();
   CallOpenGL(glBufferSubData, GL_ARRAY_BUFFER, 0, vertices_data.size() * sizeof(T), vertices_data.data());
 }
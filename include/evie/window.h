@@ -22,6 +22,11 @@ public:
   virtual void Destroy() = 0;
   virtual void PollEvents() = 0;
   virtual void SwapBuffers() = 0;
+  // The context is current on one thread at a time, release it before making it current on another.
+  virtual void MakeContextCurrent() = 0;
+  virtual void ReleaseContext() = 0;
+  // Applies to the context current on the calling thread.
+  virtual void SetVSync(VSyncMode mode) = 0;
   [[nodiscard]] virtual Error RegisterEventManager(EventManager& event_manager) = 0;
   virtual void* GetNativeWindow() = 0;
   virtual void EnableCursor() = 0;
@@ -0,0 +1,24 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTexCoord;
+// Per instance model matrix and texture array layer, see RenderQueue::InstanceModelAttribute and
+// RenderQueue::InstanceLayerAttribute.
+layout (location = 8) in mat4 aModel;
+layout (location = 12) in float aLayer;
+out vec2 TexCoord;
+flat out float Layer;
+layout(std140) uniform Frame
+{
+  mat4 view;
+  mat4 projection;
+  mat4 inverse_transpose_view;
+  vec3 view_position;
+  float time;
+};
+
+void main()
+{
+   gl_Position = projection * view * aModel * vec4(aPos, 1.0);
+   TexCoord = vec2(aTexCoord.x, aTexCoord.y);
+   Layer = aLayer;
+}
@@ -0,0 +1,20 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTexCoord;
+// Per instance model matrix. Takes up locations 8 to 11, see RenderQueue::InstanceModelAttribute.
+layout (location = 8) in mat4 aModel;
+out vec2 TexCoord;
+layout(std140) uniform Frame
+{
+  mat4 view;
+  mat4 projection;
+  mat4 inverse_transpose_view;
+  vec3 view_position;
+  float time;
+};
+
+void main()
+{
+   gl_Position = projection * view * aModel * vec4(aPos, 1.0);
+   TexCoord = vec2(aTexCoord.x, aTexCoord.y);
+}
\ No newline at end of file
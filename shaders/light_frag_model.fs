@@ -5,8 +5,15 @@ in vec3 Normal;
 in vec3 FragPos;
 in vec3 LightPos;
 in vec2 TexCoords;
-uniform mat4 view;
-uniform mat4 inverse_transpose_view;
+
+layout(std140) uniform Frame
+{
+  mat4 view;
+  mat4 projection;
+  mat4 inverse_transpose_view;
+  vec3 view_position;
+  float time;
+};
 
 struct Material
 {
@@ -22,6 +29,7 @@ struct Material
 
 uniform Material material;
 
+// Scalars are packed after each vec3 to fill the std140 padding. Matches evie::LightsBlock.
 struct DirectionalLight
 {
   vec3 direction;
@@ -31,41 +39,43 @@ struct DirectionalLight
   vec3 specular;
 };
 
-uniform DirectionalLight directional_light;
-
 struct PointLight
 {
   vec3 position;
-
   float constant;
-  float linear;
-  float quadratic;
 
   vec3 ambient;
+  float linear;
   vec3 diffuse;
+  float quadratic;
   vec3 specular;
 };
-#define NR_POINT_LIGHTS 4
-uniform PointLight point_lights[NR_POINT_LIGHTS];
 
 struct SpotLight
 {
   vec3 position;
-  vec3 direction;
   float cut_off;
+  vec3 direction;
   float outer_cut_off;
 
   vec3 ambient;
-  vec3 diffuse;
-  vec3 specular;
-
   float constant;
+  vec3 diffuse;
   float linear;
+  vec3 specular;
   float quadratic;
-  sampler2D image;
 };
 
-uniform SpotLight spot_light;
+#define NR_POINT_LIGHTS 4
+layout(std140) uniform Lights
+{
+  DirectionalLight directional_light;
+  PointLight point_lights[NR_POINT_LIGHTS];
+  SpotLight spot_light;
+};
+
+// Samplers can't live in a uniform block.
+uniform sampler2D spot_light_image;
 
 vec3 CalcDirectionalLight(DirectionalLight light, vec3 normal, vec3 view_dir);
 vec3 CalcPointLight(PointLight light, vec3 normal, vec3 frag_pos, vec3 view_dir);
@@ -186,8 +196,8 @@ vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 frag_pos, vec3 view_dir)
 
   // Combine results
   vec3 ambient = intensity * attenuation * light.ambient * vec3(texture(material.texture_diffuse1, TexCoords));
-  vec3 diffuse = intensity * attenuation * light.diffuse * diff * vec3(texture(light.image, TexCoords));
-  vec3 specular = intensity * attenuation * light.specular * spec * vec3(texture(light.image, TexCoords));
+  vec3 diffuse = intensity * attenuation * light.diffuse * diff * vec3(texture(spot_light_image, TexCoords));
+  vec3 specular = intensity * attenuation * light.specular * spec * vec3(texture(spot_light_image, TexCoords));
 
   return (ambient + diffuse + specular);
 }
\ No newline at end of file
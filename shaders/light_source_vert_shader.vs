@@ -1,9 +1,15 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
 
-uniform mat4 projection;
+layout(std140) uniform Frame
+{
+  mat4 view;
+  mat4 projection;
+  mat4 inverse_transpose_view;
+  vec3 view_position;
+  float time;
+};
 uniform mat4 model;
-uniform mat4 view;
 
 void main()
 {
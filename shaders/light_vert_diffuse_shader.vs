@@ -28,9 +28,15 @@ struct Light
 
 uniform Light light;
 
-uniform mat4 projection;
+layout(std140) uniform Frame
+{
+  mat4 view;
+  mat4 projection;
+  mat4 inverse_transpose_view;
+  vec3 view_position;
+  float time;
+};
 uniform mat4 model;
-uniform mat4 view;
 uniform vec3 lightPos;
 
 void main()
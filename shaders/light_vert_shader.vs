@@ -6,9 +6,15 @@ out vec3 Normal;
 out vec3 FragPos;
 out vec3 LightPos;
 
-uniform mat4 projection;
+layout(std140) uniform Frame
+{
+  mat4 view;
+  mat4 projection;
+  mat4 inverse_transpose_view;
+  vec3 view_position;
+  float time;
+};
 uniform mat4 model;
-uniform mat4 view;
 uniform vec3 lightPos;
 
 void main()
@@ -0,0 +1,9 @@
+#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+flat in float Layer;
+uniform sampler2DArray textures;
+void main()
+{
+   FragColor = texture(textures, vec3(TexCoord, Layer));
+}
@@ -0,0 +1,24 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTexCoord;
+out vec2 TexCoord;
+flat out float Layer;
+layout(std140) uniform Frame
+{
+  mat4 view;
+  mat4 projection;
+  mat4 inverse_transpose_view;
+  vec3 view_position;
+  float time;
+};
+uniform mat4 model;
+// Set per draw by RenderQueue when the command has a texture array, instanced draws use
+// instanced_texture_array_vertex_shader.vs instead.
+uniform int texture_layer;
+
+void main()
+{
+   gl_Position = projection * view * model * vec4(aPos, 1.0);
+   TexCoord = vec2(aTexCoord.x, aTexCoord.y);
+   Layer = float(texture_layer);
+}
\ No newline at end of file
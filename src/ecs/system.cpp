@@ -1,4 +1,7 @@
 #include "evie/ecs/system.hpp"
+#include "evie/profiler.h"
+
+#include <chrono>
 
 namespace evie {
 
@@ -13,6 +16,8 @@ namespace evie {
 
 void System::UpdateSystem(const float& delta_time)
 {
+  EV_PROFILE_TYPE_SCOPE(*this);
+  const auto start = std::chrono::steady_clock::now();
   // Call user implemented Update() function first
   Update(delta_time);
 
@@ -23,6 +28,8 @@ void System::UpdateSystem(const float& delta_time)
 
   // Clear deleted entities for next iteration
   entities_to_delete_.clear();
+  last_update_ns_ = static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
 }
 
 void System::MarkEntityForDeletion(const Entity& entity) { entities_to_delete_.insert(entity); }
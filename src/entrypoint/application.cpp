@@ -1,16 +1,32 @@
 #include <imgui_internal.h>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <string>
 #include <thread>
+#include <tuple>
 
 #include "evie/application.h"
 #include "evie/camera.h"
 #include "evie/ecs/ecs_controller.hpp"
 #include "evie/error.h"
 #include "evie/events.h"
+#include "evie/fixed_timestep.h"
+#include "evie/frame_pacer.h"
+#include "evie/gpu_profiler.h"
 #include "evie/input_manager.h"
+#include "evie/key_events.h"
 #include "evie/logging.h"
+#include "evie/profiler.h"
+#include "evie/render_queue.h"
+#include "evie/render_stats.h"
+#include "evie/render_thread.h"
+#include "evie/resource_manager.h"
 #include "evie/window.h"
 #include "rendering/debug.h"
+#include "entrypoint/performance_overlay.h"
 #include "window/debug_layer.h"
 #include "window/event_manager.h"
 #include "window/input_manager_impl.h"
@@ -42,9 +58,26 @@ private:
   std::unique_ptr<EventManager> event_manager_;
   std::unique_ptr<Layer> debug_layer_;
   std::unique_ptr<IInputManager> input_manager_;
+  // Declared before the ECS so it outlives the handles held by components.
+  std::unique_ptr<ResourceManager> resource_manager_;
   std::unique_ptr<ECSController> ecs_controller_;
   LayerQueue layer_queue_;
   Camera camera_;
+  FixedTimestep fixed_timestep_;
+  FrameTime frame_time_;
+  FramePacer frame_pacer_;
+  // Only initialised once EnableGpuProfiling() has been called, until then its calls do nothing.
+  GpuProfiler gpu_profiler_;
+  std::unique_ptr<PerformanceOverlay> performance_overlay_;
+  // Counters for the last finished frame, shown by the overlay.
+  RenderStats last_render_stats_;
+  // Where the running profiler capture is written, empty when there isn't one.
+  std::string capture_path_;
+  // Unset until the first frame so the time spent initialising isn't simulated.
+  std::optional<std::chrono::steady_clock::time_point> last_frame_;
+  // Only used once EnableRenderThread() has been called.
+  RenderThread render_thread_;
+  RenderQueue render_queue_;
 };
 
 void Application::Impl::PushLayerFront(Layer& layer) { layer_queue_.PushFront(layer); }
@@ -60,8 +93,106 @@ IWindow* Application::GetWindow() const { return impl_->window_.get(); }
 
 ECSController* Application::GetECSController() const { return impl_->ecs_controller_.get(); }
 
+ResourceManager* Application::GetResourceManager() const { return impl_->resource_manager_.get(); }
+
 ImGuiContext* Application::GetImGuiContext() const { return ImGui::GetCurrentContext(); }
 
+const FrameTime& Application::GetFrameTime() const { return impl_->frame_time_; }
+
+void Application::SetFixedTickRate(double ticks_per_second)
+{
+  if (ticks_per_second <= 0.0) {
+    EV_WARN("Ignoring a fixed tick rate of {}, it must be positive", ticks_per_second);
+    return;
+  }
+  impl_->fixed_timestep_.SetTickRate(ticks_per_second);
+}
+
+void Application::SetMaxFixedStepsPerFrame(uint32_t max_steps)
+{
+  impl_->fixed_timestep_.SetMaxStepsPerFrame(max_steps);
+}
+
+void Application::SetTargetFrameRate(double frames_per_second)
+{
+  impl_->frame_pacer_.SetTargetFrameRate(frames_per_second);
+}
+
+void Application::SetVSync(VSyncMode mode) { impl_->window_->SetVSync(mode); }
+
+const FrameTimeHistory& Application::GetFrameTimeHistory() const { return impl_->frame_pacer_.GetHistory(); }
+
+void Application::EnableGpuProfiling()
+{
+#if EVIE_PROFILING
+  gpu_profiling_enabled_ = true;
+#else
+  EV_WARN("GPU profiling is unavailable, Evie was built without EVIE_PROFILING");
+#endif
+}
+
+GpuProfiler* Application::GetGpuProfiler() const { return &impl_->gpu_profiler_; }
+
+void Application::SetPerformanceOverlayVisible(bool visible)
+{
+  if (visible && render_thread_enabled_) {
+    EV_WARN("The performance overlay isn't available with the render thread enabled");
+    return;
+  }
+  if (impl_->performance_overlay_) {
+    impl_->performance_overlay_->SetVisible(visible);
+  }
+}
+
+void Application::StartProfilerCapture(const std::string& path)
+{
+#if EVIE_PROFILING
+  if (IsProfilerCapturing()) {
+    EV_WARN("A profiler capture is already running, writing to {}", impl_->capture_path_);
+    return;
+  }
+  Profiler& profiler = Profiler::Get();
+  profiler.Clear();
+  profiler.BeginCapture();
+  impl_->capture_path_ = path;
+  EV_INFO("Started a profiler capture, writing to {} when it stops", path);
+#else
+  EV_WARN("Can't capture {}, Evie was built without EVIE_PROFILING", path);
+#endif
+}
+
+void Application::StopProfilerCapture()
+{
+  if (!IsProfilerCapturing()) {
+    return;
+  }
+  Profiler& profiler = Profiler::Get();
+  profiler.EndCapture();
+  // Flushes every thread's ring, including the render thread's.
+  if (const Error err = profiler.WriteChromeTrace(impl_->capture_path_); err.Bad()) {
+    EV_ERROR("Failed to write the profiler capture to {}: {}", impl_->capture_path_, err.Message());
+  } else {
+    EV_INFO("Wrote the profiler capture to {}", impl_->capture_path_);
+  }
+  if (profiler.GetDroppedCount() > 0) {
+    EV_WARN("The profiler capture dropped {} zones", profiler.GetDroppedCount());
+  }
+  profiler.Clear();
+  impl_->capture_path_.clear();
+}
+
+bool Application::IsProfilerCapturing() const { return !impl_->capture_path_.empty(); }
+
+void Application::InitialiseGpuProfiler()
+{
+  if (!gpu_profiling_enabled_) {
+    return;
+  }
+  if (const Error err = impl_->gpu_profiler_.Initialise(); err.Bad()) {
+    EV_WARN("GPU profiling is disabled: {}", err.Message());
+  }
+}
+
 Error Application::Initialise(const WindowProperties& props)
 {
   // Logging
@@ -81,6 +212,9 @@ Error Application::Initialise(const WindowProperties& props)
 #if defined EVIE_PLATFORM_WINDOWS || defined EVIE_PLATFORM_APPLE || defined EVIE_PLATFORM_UNIX
   impl_->window_ = std::make_unique<GLFWWindow>();
   evie::Error err = impl_->window_->Initialise(props);
+  if (err.Good()) {
+    InitialiseGLErrorChecking(reinterpret_cast<GLADloadproc>(glfwGetProcAddress));// NOLINT
+  }
   // impl_->debug_layer_ = std::make_unique<DebugLayer>(impl_->window_->GetNativeWindow());
   // impl_->PushLayerBack(*impl_->debug_layer_);
 #endif
@@ -97,7 +231,9 @@ Error Application::Initialise(const WindowProperties& props)
   }
 
   if (err.Good()) {
+    impl_->resource_manager_ = std::make_unique<ResourceManager>();
     impl_->ecs_controller_ = std::make_unique<ECSController>();
+    err = impl_->resource_manager_->Initialise();
   }
 
   // Evie supports ImGui natively so set up the context here for other layers to use.
@@ -112,6 +248,47 @@ Error Application::Initialise(const WindowProperties& props)
     ImGui_ImplGlfw_InitForOpenGL(static_cast<GLFWwindow*>(impl_->window_->GetNativeWindow()),
       true);// Second param install_callback=true will install GLFW callbacks and chain to existing ones.
     ImGui_ImplOpenGL3_Init();
+
+    PerformanceOverlaySources sources;
+    sources.frame_times = &impl_->frame_pacer_.GetHistory();
+    sources.ecs = impl_->ecs_controller_.get();
+    sources.resources = impl_->resource_manager_.get();
+    sources.gpu_profiler = &impl_->gpu_profiler_;
+    sources.render_stats = &impl_->last_render_stats_;
+    impl_->performance_overlay_ = std::make_unique<PerformanceOverlay>(sources);
+    impl_->PushLayerBack(*impl_->performance_overlay_);
+    // Subscribed rather than left to the overlay's OnEvent so that layers can't swallow the key first.
+    impl_->event_manager_->SubscribeToEventType(EventType::KeyPressed, [this](Event& event) {
+      const auto* key_event = event.Cast<KeyPressedEvent>();
+      if (key_event->IsKeyCode(KeyCode::F3) && key_event->GetRepeatCount() == 0) {
+        if (render_thread_enabled_) {
+          EV_WARN("The performance overlay isn't available with the render thread enabled");
+        } else {
+          PerformanceOverlay& overlay = *impl_->performance_overlay_;
+          overlay.SetVisible(!overlay.IsVisible());
+        }
+        event.handled = true;
+      }
+    });
+  }
+
+  if (err.Good()) {
+    impl_->event_manager_->SubscribeToEventType(EventType::KeyPressed, [this](Event& event) {
+      const auto* key_event = event.Cast<KeyPressedEvent>();
+      if (key_event->IsKeyCode(KeyCode::F4) && key_event->GetRepeatCount() == 0) {
+        if (IsProfilerCapturing()) {
+          StopProfilerCapture();
+        } else {
+          StartProfilerCapture();
+        }
+        event.handled = true;
+      }
+    });
+    // Captures everything from here to Shutdown(), e.g. EVIE_PROFILE_CAPTURE=startup.json.
+    const char* capture_path = std::getenv("EVIE_PROFILE_CAPTURE");// NOLINT(concurrency-mt-unsafe)
+    if (capture_path != nullptr && *capture_path != '\0') {
+      StartProfilerCapture(capture_path);
+    }
   }
 
   if (err.Good()) {
@@ -130,27 +307,51 @@ void Application::Run()
   }
 
   // glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+  if (render_thread_enabled_) {
+    RunRenderThread();
+    return;
+  }
+
+  EV_PROFILE_THREAD("Main");
   glEnable(GL_DEPTH_TEST);
+  InitialiseGpuProfiler();
+  [[maybe_unused]] GpuProfiler& gpu_profiler = impl_->gpu_profiler_;
   while (running_ && err.Good()) {
-    impl_->window_->PollEvents();
+    FlushProfiler();
+    EV_PROFILE_SCOPE("Frame");
+#if EVIE_PROFILING
+    gpu_profiler.BeginFrame();
+    gpu_profiler.BeginZone("Frame");
+#endif
+    GLErrorCheckNewFrame();
+    {
+      EV_PROFILE_SCOPE("PollEvents");
+      impl_->window_->PollEvents();
+    }
+    // Swap in any textures that finished loading so this frame draws them.
+    impl_->resource_manager_->Update();
     // Move this to the renderer in the future
     // glClearColor(0.14F, 0.15F, 0.16F, 1.0F);
     glClearColor(0.14F, 0.15F, 0.16F, 1.0F);
     // glClearColor(0.0F, 0.0F, 0.0F, 1.0F);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     // Generally this involves updating physics etc based on events.
-    for (const auto& layer_wrapper : impl_->layer_queue_) {
-      layer_wrapper.layer->OnUpdate();
-    }
+    UpdateLayers();
     // Let all layers render what they want to render based on the previous on update.
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
     for (const auto& layer_wrapper : impl_->layer_queue_) {
+      EV_PROFILE_TYPE_SCOPE(*layer_wrapper.layer);
+      EV_PROFILE_GPU_TYPE_SCOPE(gpu_profiler, *layer_wrapper.layer);
       layer_wrapper.layer->OnRender();
     }
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    {
+      EV_PROFILE_SCOPE("ImGui::Render");
+      EV_PROFILE_GPU_SCOPE(gpu_profiler, "ImGui::Render");
+      ImGui::Render();
+      ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
     const ImGuiIO& imgui_io = ImGui::GetIO();
     if (imgui_io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
       GLFWwindow* backup_current_context = glfwGetCurrentContext();
@@ -158,7 +359,20 @@ void Application::Run()
       ImGui::RenderPlatformWindowsDefault();
       glfwMakeContextCurrent(backup_current_context);
     }
-    impl_->window_->SwapBuffers();
+#if EVIE_PROFILING
+    gpu_profiler.EndZone();
+    gpu_profiler.EndFrame();
+#endif
+    impl_->last_render_stats_ = GetRenderStats();
+    ResetRenderStats();
+    {
+      EV_PROFILE_SCOPE("SwapBuffers");
+      impl_->window_->SwapBuffers();
+    }
+    // Anything released this frame has had its draws issued so it's safe to delete now.
+    impl_->resource_manager_->CollectGarbage();
+    EV_PROFILE_SCOPE("FramePacer::EndFrame");
+    impl_->frame_pacer_.EndFrame();
   }
 
   if (err.Bad()) {
@@ -167,10 +381,146 @@ void Application::Run()
   }
 }
 
+void Application::UpdateLayers()
+{
+  EV_PROFILE_SCOPE("Application::UpdateLayers");
+  const auto now = std::chrono::steady_clock::now();
+  const double frame_seconds =
+    impl_->last_frame_ ? std::chrono::duration<double>(now - *impl_->last_frame_).count() : 0.0;
+  impl_->last_frame_ = now;
+
+  FixedTimestep& fixed_timestep = impl_->fixed_timestep_;
+  const uint32_t steps = fixed_timestep.Advance(frame_seconds);
+  FrameTime& frame_time = impl_->frame_time_;
+  frame_time.delta_time = static_cast<float>(frame_seconds);
+  frame_time.fixed_delta_time = static_cast<float>(fixed_timestep.GetStep());
+  frame_time.alpha = fixed_timestep.GetAlpha();
+  frame_time.fixed_steps = steps;
+  for (uint32_t step = 0; step < steps; ++step) {
+    EV_PROFILE_SCOPE("FixedUpdate");
+    for (const auto& layer_wrapper : impl_->layer_queue_) {
+      EV_PROFILE_TYPE_SCOPE(*layer_wrapper.layer);
+      layer_wrapper.layer->OnFixedUpdate(frame_time.fixed_delta_time);
+    }
+  }
+
+  for (const auto& layer_wrapper : impl_->layer_queue_) {
+    EV_PROFILE_TYPE_SCOPE(*layer_wrapper.layer);
+    layer_wrapper.layer->OnUpdate();
+  }
+}
+
+void Application::FlushProfiler()
+{
+  // Frequent enough that a thread's ring only has to hold a frame's worth of zones.
+  Profiler& profiler = Profiler::Get();
+  if (profiler.IsCapturing()) {
+    profiler.Flush();
+  }
+}
+
+void Application::EnableRenderThread() { render_thread_enabled_ = true; }
+
+void Application::RunRenderThread()
+{
+  IWindow& window = *impl_->window_;
+  ResourceManager& resource_manager = *impl_->resource_manager_;
+  RenderQueue& render_queue = impl_->render_queue_;
+  GpuProfiler& gpu_profiler = impl_->gpu_profiler_;
+  window.ReleaseContext();
+  impl_->render_thread_.Start(
+    [this, &window] {
+      EV_PROFILE_THREAD("Render");
+      window.MakeContextCurrent();
+      glEnable(GL_DEPTH_TEST);
+      InitialiseGpuProfiler();
+    },
+    [this, &window, &render_queue, &gpu_profiler](CommandList& commands) {
+      EV_PROFILE_SCOPE("RenderThread::Frame");
+#if EVIE_PROFILING
+      gpu_profiler.BeginFrame();
+      gpu_profiler.BeginZone("Frame");
+#else
+      std::ignore = gpu_profiler;
+#endif
+      GLErrorCheckNewFrame();
+      for (const auto& task : commands.tasks) {
+        task();
+      }
+      glViewport(0, 0, commands.viewport.width, commands.viewport.height);
+      const vec4& colour = commands.clear_colour;
+      glClearColor(colour.x, colour.y, colour.z, colour.w);
+      glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+      render_queue.Clear();
+      render_queue.Reserve(commands.draws.size());
+      for (const auto& command : commands.draws) {
+        render_queue.Submit(command);
+      }
+      render_queue.Sort();
+      {
+        EV_PROFILE_GPU_SCOPE(gpu_profiler, "RenderQueue::Execute");
+        render_queue.Execute(commands.frame);
+        for (const auto& task : commands.draw_tasks) {
+          task();
+        }
+      }
+#if EVIE_PROFILING
+      gpu_profiler.EndZone();
+      gpu_profiler.EndFrame();
+#endif
+      // The counters are only touched by the thread rendering, so they're read and reset here.
+      impl_->last_render_stats_ = GetRenderStats();
+      ResetRenderStats();
+      EV_PROFILE_SCOPE("SwapBuffers");
+      window.SwapBuffers();
+    },
+    [&window] { window.ReleaseContext(); });
+
+  // Runs on the render thread between frames while this thread waits, so nothing else is touching the resources.
+  const std::function<void()> between_frames = [&resource_manager] {
+    // The frame that drew anything released has finished.
+    resource_manager.CollectGarbage();
+    resource_manager.Update();
+  };
+  EV_PROFILE_THREAD("Main");
+  while (running_) {
+    FlushProfiler();
+    EV_PROFILE_SCOPE("Frame");
+    window.PollEvents();
+    UpdateLayers();
+    CommandList& commands = impl_->render_thread_.GetRecordingList();
+    commands.viewport = window.GetWindowProperties().dimensions;
+    for (const auto& layer_wrapper : impl_->layer_queue_) {
+      EV_PROFILE_TYPE_SCOPE(*layer_wrapper.layer);
+      layer_wrapper.layer->OnRecord(commands);
+    }
+    {
+      // Includes waiting for the render thread to finish the previous frame.
+      EV_PROFILE_SCOPE("RenderThread::Submit");
+      impl_->render_thread_.Submit(between_frames);
+    }
+    // Pacing the simulation paces rendering too, the render thread never gets more than a frame ahead.
+    impl_->frame_pacer_.EndFrame();
+  }
+
+  impl_->render_thread_.Stop();
+  // Shutdown destroys GL objects from this thread.
+  window.MakeContextCurrent();
+  render_queue.Destroy();
+  gpu_profiler.Destroy();
+}
+
 void Application::Shutdown()
 {
+  // Written before anything is torn down so a capture covering the whole run isn't lost.
+  StopProfilerCapture();
   // Shutdown layers first as they'll be using contexts from the window like glfw, opengl etc.
   impl_->layer_queue_.Shutdown();
+  // Components may still hold handles but the GL objects have to go before the context does.
+  if (impl_->resource_manager_) {
+    impl_->resource_manager_->Destroy();
+  }
+  impl_->gpu_profiler_.Destroy();
   if (impl_->window_) {
     impl_->window_->Destroy();
   }
@@ -0,0 +1,62 @@
+#ifndef EVIE_INCLUDE_ENTRYPOINT_PERFORMANCE_OVERLAY_H_
+#define EVIE_INCLUDE_ENTRYPOINT_PERFORMANCE_OVERLAY_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "evie/ecs/ecs_controller.hpp"
+#include "evie/frame_pacer.h"
+#include "evie/gpu_profiler.h"
+#include "evie/layer.h"
+#include "evie/render_stats.h"
+#include "evie/resource_manager.h"
+
+namespace evie {
+
+// Everything the overlay reads, owned by the Application. Any of them can be null.
+struct PerformanceOverlaySources
+{
+  const FrameTimeHistory* frame_times{ nullptr };
+  const ECSController* ecs{ nullptr };
+  const ResourceManager* resources{ nullptr };
+  const GpuProfiler* gpu_profiler{ nullptr };
+  // The last finished frame's counters.
+  const RenderStats* render_stats{ nullptr };
+};
+
+/**
+ * @brief An ImGui window of frame times, system update times, ECS counts, render counters and resource pool usage.
+ * Hidden it only checks a flag, so it can stay in the layer queue of shipping builds.
+ */
+class PerformanceOverlay final : public Layer
+{
+public:
+  explicit PerformanceOverlay(const PerformanceOverlaySources& sources) : sources_(sources) {}
+
+  void SetVisible(bool visible) { visible_ = visible; }
+  [[nodiscard]] bool IsVisible() const { return visible_; }
+
+  void OnUpdate() override {}
+  void OnRender() override;
+  void OnEvent(Event& event) override;
+
+private:
+  void DrawFrameTimes();
+  void DrawSystems();
+  void DrawEntities();
+  void DrawRendering();
+  void DrawResources();
+  // Demangled once per type rather than every frame.
+  const std::string& GetTypeName(const char* mangled);
+
+  PerformanceOverlaySources sources_;
+  bool visible_{ false };
+  // Frame times in milliseconds, oldest first, for the graph.
+  std::vector<float> frame_ms_;
+  std::unordered_map<const char*, std::string> type_names_;
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_ENTRYPOINT_PERFORMANCE_OVERLAY_H_
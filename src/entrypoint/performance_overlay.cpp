@@ -0,0 +1,188 @@
+#include "entrypoint/performance_overlay.h"
+#include "evie/profiler.h"
+
+#include <cstdint>
+
+#include "imgui.h"
+
+namespace evie {
+
+namespace {
+constexpr float MillisecondsPerSecond = 1000.0F;
+constexpr double NanosecondsPerMillisecond = 1'000'000.0;
+constexpr float GraphHeight = 80.0F;
+// Leave some room above the slowest frame so the graph doesn't touch the top.
+constexpr float GraphHeadroom = 1.2F;
+
+// Start a two column table row with its label, leaving the value column current.
+void Label(const char* label)
+{
+  ImGui::TableNextRow();
+  ImGui::TableSetColumnIndex(0);
+  ImGui::TextUnformatted(label);
+  ImGui::TableSetColumnIndex(1);
+}
+}// namespace
+
+void PerformanceOverlay::OnRender()
+{
+  if (!visible_) {
+    return;
+  }
+  EV_PROFILE_SCOPE("PerformanceOverlay::OnRender");
+  if (ImGui::Begin("Performance", &visible_)) {
+    DrawFrameTimes();
+    DrawSystems();
+    DrawEntities();
+    DrawRendering();
+    DrawResources();
+  }
+  ImGui::End();
+}
+
+void PerformanceOverlay::OnEvent(Event& event)
+{
+  if (!visible_) {
+    return;
+  }
+  // Don't let clicks on the overlay reach the game.
+  if (event.IsInCategory(EventCategoryBitmask::Mouse) && ImGui::GetIO().WantCaptureMouse) {
+    event.handled = true;
+  }
+}
+
+void PerformanceOverlay::DrawFrameTimes()
+{
+  if (sources_.frame_times == nullptr || sources_.frame_times->Empty()) {
+    ImGui::TextUnformatted("No frames yet");
+    return;
+  }
+  const FrameTimeHistory& history = *sources_.frame_times;
+  frame_ms_.resize(history.Size());
+  for (size_t i = 0; i < history.Size(); ++i) {
+    frame_ms_[i] = history[i] * MillisecondsPerSecond;
+  }
+  const float average = history.Average() * MillisecondsPerSecond;
+  const float slowest = history.Max() * MillisecondsPerSecond;
+  const float fps = average > 0.0F ? MillisecondsPerSecond / average : 0.0F;
+  const auto percentile = [&history](float fraction) {
+    return static_cast<double>(history.Percentile(fraction) * MillisecondsPerSecond);
+  };
+  ImGui::Text("%.1f FPS, %.2f ms average", static_cast<double>(fps), static_cast<double>(average));
+  ImGui::Text("p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms",
+    percentile(0.5F),// NOLINT(*-magic-numbers)
+    percentile(0.95F),// NOLINT(*-magic-numbers)
+    percentile(0.99F),// NOLINT(*-magic-numbers)
+    static_cast<double>(slowest));
+  ImGui::PlotLines("##FrameTimes",
+    frame_ms_.data(),
+    static_cast<int>(frame_ms_.size()),
+    0,
+    nullptr,
+    0.0F,
+    slowest * GraphHeadroom,
+    ImVec2(-1.0F, GraphHeight));
+}
+
+void PerformanceOverlay::DrawSystems()
+{
+  if (sources_.ecs == nullptr || !ImGui::CollapsingHeader("Systems", ImGuiTreeNodeFlags_DefaultOpen)) {
+    return;
+  }
+  const ECSController& ecs = *sources_.ecs;
+  if (ImGui::BeginTable("Systems", 2)) {
+    for (size_t i = 0; i < ecs.SystemCount(); ++i) {
+      const System& system = ecs.GetSystemAt(i);
+      Label(GetTypeName(typeid(system).name()).c_str());
+      ImGui::Text("%.3f ms", static_cast<double>(system.GetLastUpdateTime()) / NanosecondsPerMillisecond);
+    }
+    ImGui::EndTable();
+  }
+}
+
+void PerformanceOverlay::DrawEntities()
+{
+  if (sources_.ecs == nullptr || !ImGui::CollapsingHeader("Entities")) {
+    return;
+  }
+  const ECSController& ecs = *sources_.ecs;
+  if (ImGui::BeginTable("Entities", 2)) {
+    Label("Entities");
+    ImGui::Text("%llu", static_cast<unsigned long long>(ecs.EntityCount()));// NOLINT(*-runtime-int)
+    for (size_t i = 0; i < ecs.ComponentTypeCount(); ++i) {
+      const IComponentArray& components = ecs.GetComponentArray(i);
+      Label(GetTypeName(components.GetType().name()).c_str());
+      ImGui::Text("%zu", components.Size());
+    }
+    ImGui::EndTable();
+  }
+}
+
+void PerformanceOverlay::DrawRendering()
+{
+  if (!ImGui::CollapsingHeader("Rendering", ImGuiTreeNodeFlags_DefaultOpen)) {
+    return;
+  }
+  if (sources_.render_stats != nullptr && ImGui::BeginTable("Rendering", 2)) {
+    const RenderStats& stats = *sources_.render_stats;
+    Label("Draw calls");
+    ImGui::Text("%zu", stats.draw_calls);
+    Label("Draws");
+    ImGui::Text("%zu", stats.draws);
+    Label("Binds issued");
+    ImGui::Text("%zu", stats.binds_issued);
+    Label("Binds skipped");
+    ImGui::Text("%zu", stats.binds_elided);
+    ImGui::EndTable();
+  }
+  if (sources_.gpu_profiler == nullptr || !sources_.gpu_profiler->IsInitialised()) {
+    ImGui::TextDisabled("GPU timing is off, see Application::EnableGpuProfiling()");
+    return;
+  }
+  if (ImGui::BeginTable("GPU", 2)) {
+    for (const auto& zone : sources_.gpu_profiler->GetLastFrame()) {
+      // Nested zones are indented under the zone they ran in.
+      const float indent = static_cast<float>(zone.depth) * ImGui::GetStyle().IndentSpacing;
+      ImGui::TableNextRow();
+      ImGui::TableSetColumnIndex(0);
+      ImGui::Indent(indent);
+      ImGui::TextUnformatted(zone.type_name ? GetTypeName(zone.name).c_str() : zone.name);
+      ImGui::Unindent(indent);
+      ImGui::TableSetColumnIndex(1);
+      ImGui::Text("%.3f ms GPU", zone.milliseconds);
+    }
+    ImGui::EndTable();
+  }
+}
+
+void PerformanceOverlay::DrawResources()
+{
+  if (sources_.resources == nullptr || !ImGui::CollapsingHeader("Resources")) {
+    return;
+  }
+  const ResourceManager& resources = *sources_.resources;
+  if (ImGui::BeginTable("Resources", 2)) {
+    Label("Meshes");
+    ImGui::Text("%zu", resources.GetMeshCount());
+    Label("Textures");
+    ImGui::Text("%zu", resources.GetTextureCount());
+    Label("Textures loading");
+    ImGui::Text("%zu", resources.GetPendingTextureCount());
+    Label("Shader programs");
+    ImGui::Text("%zu", resources.GetShaderProgramCount());
+    Label("Profiler events dropped");
+    ImGui::Text("%zu", Profiler::Get().GetDroppedCount());
+    ImGui::EndTable();
+  }
+}
+
+const std::string& PerformanceOverlay::GetTypeName(const char* mangled)
+{
+  auto [it, inserted] = type_names_.try_emplace(mangled);
+  if (inserted) {
+    it->second = DemangleTypeName(mangled);
+  }
+  return it->second;
+}
+
+}// namespace evie
@@ -0,0 +1,277 @@
+#include "evie/profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#endif
+
+namespace evie {
+
+std::string DemangleTypeName(const char* name)
+{
+#if __has_include(<cxxabi.h>)
+  int status = 0;
+  const std::unique_ptr<char, decltype(&std::free)> demangled(
+    abi::__cxa_demangle(name, nullptr, nullptr, &status), &std::free);
+  if (status == 0 && demangled != nullptr) {
+    return demangled.get();
+  }
+  return name;
+#else
+  // MSVC names are already readable, apart from a "class " or "struct " prefix.
+  std::string_view view(name);
+  for (const std::string_view prefix : { "class ", "struct " }) {
+    if (view.starts_with(prefix)) {
+      view.remove_prefix(prefix.size());
+    }
+  }
+  return std::string(view);
+#endif
+}
+
+namespace {
+void WriteJSONString(std::ostream& stream, std::string_view text)
+{
+  stream << '"';
+  for (const char character : text) {
+    switch (character) {
+    case '"':
+      stream << "\\\"";
+      break;
+    case '\\':
+      stream << "\\\\";
+      break;
+    case '\n':
+      stream << "\\n";
+      break;
+    default:
+      if (static_cast<unsigned char>(character) < 0x20) {// NOLINT(*-magic-numbers)
+        std::array<char, 8> escaped{};// NOLINT(*-magic-numbers)
+        std::snprintf(escaped.data(), escaped.size(), "\\u%04x", static_cast<unsigned int>(character));
+        stream << escaped.data();
+      } else {
+        stream << character;
+      }
+      break;
+    }
+  }
+  stream << '"';
+}
+
+// Chrome traces are in microseconds.
+double Microseconds(uint64_t nanoseconds)
+{
+  constexpr double NanosecondsPerMicrosecond = 1000.0;
+  return static_cast<double>(nanoseconds) / NanosecondsPerMicrosecond;
+}
+}// namespace
+
+ProfileEventRing::ProfileEventRing(size_t capacity)
+  : events_(std::bit_ceil(std::max(capacity, size_t{ 1 }))), mask_(events_.size() - 1)
+{}
+
+bool ProfileEventRing::Push(const ProfileEvent& event)
+{
+  const uint64_t write = write_.load(std::memory_order_relaxed);
+  if (write - read_.load(std::memory_order_acquire) >= events_.size()) {
+    return false;
+  }
+  events_[write & mask_] = event;
+  // Publish the event before the reader can see the new index.
+  write_.store(write + 1, std::memory_order_release);
+  return true;
+}
+
+void ProfileEventRing::Drain(std::vector<ProfileEvent>& events)
+{
+  const uint64_t write = write_.load(std::memory_order_acquire);
+  uint64_t read = read_.load(std::memory_order_relaxed);
+  for (; read != write; ++read) {
+    events.push_back(events_[read & mask_]);
+  }
+  // Hand the slots back to the writer only once they've been copied.
+  read_.store(read, std::memory_order_release);
+}
+
+Profiler& Profiler::Get()
+{
+  static Profiler profiler;
+  return profiler;
+}
+
+uint64_t Profiler::Now()
+{
+  static const auto epoch = std::chrono::steady_clock::now();
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void Profiler::BeginCapture()
+{
+  // Start the clock before anything is timed against it.
+  std::ignore = Now();
+  capturing_.store(true, std::memory_order_relaxed);
+}
+
+void Profiler::EndCapture() { capturing_.store(false, std::memory_order_relaxed); }
+
+Profiler::ThreadProfile& Profiler::GetThreadProfile()
+{
+  thread_local ThreadProfile* profile = nullptr;
+  if (profile == nullptr) {
+    const std::scoped_lock lock(mutex_);
+    threads_.push_back(std::make_unique<ThreadProfile>(static_cast<uint32_t>(threads_.size())));
+    profile = threads_.back().get();
+  }
+  return *profile;
+}
+
+void Profiler::Record(const ProfileEvent& event)
+{
+  ThreadProfile& profile = GetThreadProfile();
+  ProfileEvent recorded = event;
+  recorded.thread = profile.id;
+  if (!profile.ring.Push(recorded)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+uint16_t& Profiler::ThreadDepth() { return GetThreadProfile().depth; }
+
+void Profiler::SetThreadName(const std::string& name)
+{
+  ThreadProfile& profile = GetThreadProfile();
+  const std::scoped_lock lock(mutex_);
+  profile.name = name;
+}
+
+uint32_t Profiler::AddTrack(const std::string& name)
+{
+  const std::scoped_lock lock(mutex_);
+  const auto track = static_cast<uint32_t>(threads_.size());
+  threads_.push_back(std::make_unique<ThreadProfile>(track));
+  threads_.back()->name = name;
+  return track;
+}
+
+void Profiler::RecordOnTrack(uint32_t track, const ProfileEvent& event)
+{
+  ProfileEvent recorded = event;
+  recorded.thread = track;
+  // Tracks are rare enough to look up under the lock, threads_ may be growing on another thread.
+  const std::scoped_lock lock(mutex_);
+  if (track >= threads_.size() || !threads_[track]->ring.Push(recorded)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void Profiler::Flush()
+{
+  const std::scoped_lock lock(mutex_);
+  FlushLocked();
+}
+
+void Profiler::FlushLocked()
+{
+  for (const auto& thread : threads_) {
+    thread->ring.Drain(events_);
+  }
+}
+
+void Profiler::Clear()
+{
+  const std::scoped_lock lock(mutex_);
+  FlushLocked();
+  events_.clear();
+  dropped_.store(0, std::memory_order_relaxed);
+}
+
+std::vector<ProfileEvent> Profiler::GetEvents()
+{
+  const std::scoped_lock lock(mutex_);
+  FlushLocked();
+  return events_;
+}
+
+void Profiler::WriteChromeTrace(std::ostream& stream)
+{
+  const std::scoped_lock lock(mutex_);
+  FlushLocked();
+
+  const std::ios_base::fmtflags flags = stream.flags();
+  const std::streamsize precision = stream.precision();
+  stream << std::fixed << std::setprecision(3);
+  stream << R"({"displayTimeUnit":"ms","traceEvents":[)";
+  bool first = true;
+  const auto separator = [&stream, &first] {
+    if (!first) {
+      stream << ",\n";
+    }
+    first = false;
+  };
+  for (const auto& thread : threads_) {
+    separator();
+    stream << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << thread->id << R"(,"args":{"name":)";
+    WriteJSONString(stream, thread->name.empty() ? "Thread " + std::to_string(thread->id) : thread->name);
+    stream << "}}";
+  }
+  // Many events share a type name, only demangle each once.
+  std::unordered_map<const char*, std::string> type_names;
+  for (const auto& event : events_) {
+    separator();
+    stream << R"({"name":)";
+    if (event.type_name) {
+      auto [it, inserted] = type_names.try_emplace(event.name);
+      if (inserted) {
+        it->second = DemangleTypeName(event.name);
+      }
+      WriteJSONString(stream, it->second);
+    } else {
+      WriteJSONString(stream, event.name);
+    }
+    stream << R"(,"cat":"evie","ph":"X","pid":1,"tid":)" << event.thread << R"(,"ts":)" << Microseconds(event.start_ns)
+           << R"(,"dur":)" << Microseconds(event.duration_ns) << "}";
+  }
+  stream << "]}\n";
+  stream.flags(flags);
+  stream.precision(precision);
+}
+
+Error Profiler::WriteChromeTrace(const std::string& path)
+{
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    return Error{ "Failed to open the trace file" };
+  }
+  WriteChromeTrace(file);
+  return file.good() ? Error::OK() : Error{ "Failed to write the trace file" };
+}
+
+void ProfileScope::Begin(const char* name, bool type_name)
+{
+  event_.name = name;
+  event_.type_name = type_name;
+  event_.depth = Profiler::Get().ThreadDepth()++;
+  event_.start_ns = Profiler::Now();
+}
+
+void ProfileScope::End()
+{
+  event_.duration_ns = Profiler::Now() - event_.start_ns;
+  Profiler& profiler = Profiler::Get();
+  --profiler.ThreadDepth();
+  profiler.Record(event_);
+}
+
+}// namespace evie
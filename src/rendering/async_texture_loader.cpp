@@ -0,0 +1,185 @@
+#include "evie/async_texture_loader.h"
+#include "evie/error.h"
+#include "evie/logging.h"
+#include "rendering/debug.h"
+#include "rendering/gl_state_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "glad/glad.h"
+
+namespace evie {
+
+namespace {
+// 8x8 magenta and black checkerboard, obvious enough to spot a texture that never finishes loading.
+constexpr int PlaceholderSize = 8;
+constexpr int PlaceholderChannels = 3;
+constexpr int PlaceholderSquare = 4;
+
+std::array<unsigned char, PlaceholderSize * PlaceholderSize * PlaceholderChannels> MakePlaceholderPixels()
+{
+  std::array<unsigned char, PlaceholderSize * PlaceholderSize * PlaceholderChannels> pixels{};
+  for (int y = 0; y < PlaceholderSize; ++y) {
+    for (int x = 0; x < PlaceholderSize; ++x) {
+      const bool magenta = ((x / PlaceholderSquare) + (y / PlaceholderSquare)) % 2 == 0;
+      const auto pixel = static_cast<size_t>((y * PlaceholderSize + x) * PlaceholderChannels);
+      pixels[pixel] = magenta ? 255 : 0;// NOLINT
+      pixels[pixel + 1] = 0;
+      pixels[pixel + 2] = magenta ? 255 : 0;// NOLINT
+    }
+  }
+  return pixels;
+}
+}// namespace
+
+Error AsyncTextureLoader::Initialise(size_t worker_count)
+{
+  const auto pixels = MakePlaceholderPixels();
+  Error err = placeholder_.Initialise(
+    ImageInfo{ PlaceholderSize, PlaceholderSize, PlaceholderChannels }, pixels.data(), "placeholder");
+  if (err.Good()) {
+    CallOpenGL(glGenBuffers, static_cast<GLsizei>(staging_buffers_.size()), staging_buffers_.data());
+    workers_ = std::make_unique<ThreadPool>(worker_count);
+  }
+  return err;
+}
+
+void AsyncTextureLoader::Load(const std::string& path, bool flip, TextureWrapping wrapping, OnLoaded on_loaded)
+{
+  const uint64_t id = next_id_++;
+  pending_.push_back({ id, path, wrapping, std::move(on_loaded) });
+  // The job only gets plain values, the callback never leaves the GL thread.
+  auto decode = [this, id, path, flip] {
+    DecodedLoad load{ id, Error::OK(), {}, std::nullopt };
+    if (IsBakedTexture(path)) {
+      if (Result<BakedTexture> baked = BakedTexture::Open(path); baked.Good()) {
+        if (baked->IsFlipped() != flip) {
+          EV_WARN("Baked texture {} wasn't flipped the way it was asked for, rebake it with or without --flip", path);
+        }
+        load.baked = std::move(*baked);
+      } else {
+        load.error = baked.Error();
+      }
+    } else if (Result<DecodedImage> image = DecodeImage(path, flip); image.Good()) {
+      load.image = std::move(*image);
+    } else {
+      load.error = image.Error();
+    }
+    const std::scoped_lock lock(decoded_mutex_);
+    decoded_.push_back(std::move(load));
+  };
+  if (workers_ == nullptr) {
+    // Not initialised, or the workers couldn't be started. Decode here so the load still finishes in Update().
+    decode();
+    return;
+  }
+  workers_->Submit(std::move(decode));
+}
+
+size_t AsyncTextureLoader::Update(std::chrono::microseconds budget)
+{
+  std::vector<DecodedLoad> decoded;
+  {
+    const std::scoped_lock lock(decoded_mutex_);
+    decoded.swap(decoded_);
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  size_t finished = 0;
+  auto next = decoded.begin();
+  for (; next != decoded.end(); ++next) {
+    if (finished > 0 && std::chrono::steady_clock::now() - start >= budget) {
+      break;
+    }
+    auto load =
+      std::find_if(pending_.begin(), pending_.end(), [&](const auto& pending) { return pending.id == next->id; });
+    if (load == pending_.end()) {
+      continue;
+    }
+    PendingLoad pending = std::move(*load);
+    pending_.erase(load);
+    if (next->error.Bad()) {
+      EV_WARN("Failed to load texture {}: {}", pending.path, next->error.Message());
+      pending.on_loaded(next->error);
+    } else if (next->baked) {
+      pending.on_loaded(UploadBaked(pending, *next->baked));
+    } else {
+      pending.on_loaded(Upload(pending, next->image));
+    }
+    ++finished;
+  }
+
+  // Put back whatever didn't fit in the budget, ahead of anything decoded meanwhile.
+  if (next != decoded.end()) {
+    const std::scoped_lock lock(decoded_mutex_);
+    decoded_.insert(decoded_.begin(), std::make_move_iterator(next), std::make_move_iterator(decoded.end()));
+  }
+  return finished;
+}
+
+Result<Texture2D> AsyncTextureLoader::Upload(const PendingLoad& load, const DecodedImage& image)
+{
+  const size_t size = image.info.Size();
+  const unsigned int staging_buffer = staging_buffers_[next_staging_buffer_];
+  next_staging_buffer_ = (next_staging_buffer_ + 1) % staging_buffers_.size();
+
+  GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, staging_buffer);
+  // Orphan the previous contents so mapping never waits on an upload that's still in flight.
+  CallOpenGL(glBufferData, GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_DRAW);
+  void* staging = glMapBufferRange(
+    GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(size), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+  bool staged = staging != nullptr;
+  if (staged) {
+    std::memcpy(staging, image.pixels.get(), size);
+    // GL_FALSE means the buffer contents were lost, e.g. the display mode changed.
+    staged = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) != GL_FALSE;
+  }
+  Texture2D texture;
+  Error err = Error::OK();
+  if (staged) {
+    // With the buffer bound the pixels argument is an offset into it and the driver copies from there.
+    err = texture.Initialise(image.info, nullptr, load.path, load.wrapping);
+    GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  } else {
+    // Fall back to uploading straight from the decoded pixels.
+    GLStateCache::Get().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    err = texture.Initialise(image.info, image.pixels.get(), load.path, load.wrapping);
+  }
+  if (err.Bad()) {
+    return err;
+  }
+  return texture;
+}
+
+Result<Texture2D> AsyncTextureLoader::UploadBaked(const PendingLoad& load, const BakedTexture& baked)
+{
+  // Already in a form GL can take, staging it would only add a copy.
+  Texture2D texture;
+  if (Error err = texture.Initialise(baked, load.path, load.wrapping); err.Bad()) {
+    return err;
+  }
+  return texture;
+}
+
+void AsyncTextureLoader::Destroy()
+{
+  // Joins the workers so nothing touches decoded_ after this.
+  workers_.reset();
+  pending_.clear();
+  decoded_.clear();
+  if (staging_buffers_[0] != 0) {
+    CallOpenGL(glDeleteBuffers, static_cast<GLsizei>(staging_buffers_.size()), staging_buffers_.data());
+    for (const auto buffer : staging_buffers_) {
+      GLStateCache::Get().OnBufferDeleted(buffer);
+    }
+    staging_buffers_ = {};
+  }
+  if (placeholder_.GetID().Get() != 0) {
+    placeholder_.Destroy();
+    placeholder_ = Texture2D{};
+  }
+}
+
+}// namespace evie
@@ -0,0 +1,190 @@
+#include "evie/baked_mesh.h"
+#include "evie/error.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace evie {
+
+namespace {
+constexpr size_t SectionAlignment = 16;
+
+constexpr size_t AlignSection(size_t offset) { return (offset + SectionAlignment - 1) & ~(SectionAlignment - 1); }
+
+// Where each section starts, worked out from the counts in the header so they don't need storing.
+struct BakedMeshLayout
+{
+  size_t vertices{ 0 };
+  size_t indices{ 0 };
+  size_t submeshes{ 0 };
+  size_t materials{ 0 };
+  size_t textures{ 0 };
+  size_t strings{ 0 };
+  size_t end{ 0 };
+};
+
+BakedMeshLayout LayoutFor(const BakedMeshHeader& header)
+{
+  BakedMeshLayout layout;
+  layout.vertices = AlignSection(sizeof(BakedMeshHeader));
+  layout.indices = AlignSection(layout.vertices + sizeof(BakedVertex) * header.vertex_count);
+  layout.submeshes = AlignSection(layout.indices + sizeof(uint32_t) * header.index_count);
+  layout.materials = AlignSection(layout.submeshes + sizeof(BakedSubmesh) * header.submesh_count);
+  layout.textures = AlignSection(layout.materials + sizeof(BakedMaterial) * header.material_count);
+  layout.strings = AlignSection(layout.textures + sizeof(BakedMaterialTexture) * header.texture_count);
+  layout.end = layout.strings + header.string_bytes;
+  return layout;
+}
+
+template<typename T> void Write(std::vector<unsigned char>& file, size_t offset, std::span<const T> items)
+{
+  if (!items.empty()) {
+    std::memcpy(file.data() + offset, items.data(), items.size_bytes());
+  }
+}
+
+// Counts in the file are 32 bit.
+bool FitsInFile(size_t count) { return count <= std::numeric_limits<uint32_t>::max(); }
+}// namespace
+
+Result<std::vector<unsigned char>> BakeMesh(const MeshSource& source)
+{
+  std::vector<BakedVertex> vertices;
+  std::vector<uint32_t> indices;
+  std::vector<BakedSubmesh> submeshes;
+  std::vector<BakedMaterial> materials;
+  std::vector<BakedMaterialTexture> textures;
+  std::string strings;
+
+  for (const auto& submesh : source.submeshes) {
+    if (submesh.vertices.empty() || submesh.indices.empty()) {
+      continue;
+    }
+    if (submesh.material >= source.materials.size()) {
+      return Error{ "Submesh refers to a material that doesn't exist" };
+    }
+    if (std::any_of(submesh.indices.begin(), submesh.indices.end(), [&](uint32_t index) {
+          return index >= submesh.vertices.size();
+        })) {
+      return Error{ "Submesh index is out of range of its vertices" };
+    }
+    BakedSubmesh baked;
+    baked.first_index = static_cast<uint32_t>(indices.size());
+    baked.index_count = static_cast<uint32_t>(submesh.indices.size());
+    baked.base_vertex = static_cast<uint32_t>(vertices.size());
+    baked.vertex_count = static_cast<uint32_t>(submesh.vertices.size());
+    baked.material = submesh.material;
+    submeshes.push_back(baked);
+    vertices.insert(vertices.end(), submesh.vertices.begin(), submesh.vertices.end());
+    indices.insert(indices.end(), submesh.indices.begin(), submesh.indices.end());
+  }
+  if (submeshes.empty()) {
+    return Error{ "Mesh has no triangles to bake" };
+  }
+
+  for (const auto& material : source.materials) {
+    materials.push_back({ static_cast<uint32_t>(textures.size()),
+      static_cast<uint32_t>(material.textures.size()),
+      material.shininess });
+    for (const auto& texture : material.textures) {
+      textures.push_back(
+        { texture.type, static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(texture.path.size()) });
+      strings += texture.path;
+    }
+  }
+
+  if (!FitsInFile(vertices.size()) || !FitsInFile(indices.size()) || !FitsInFile(strings.size())) {
+    return Error{ "Mesh is too large to bake" };
+  }
+
+  BakedMeshHeader header;
+  header.vertex_count = static_cast<uint32_t>(vertices.size());
+  header.index_count = static_cast<uint32_t>(indices.size());
+  header.submesh_count = static_cast<uint32_t>(submeshes.size());
+  header.material_count = static_cast<uint32_t>(materials.size());
+  header.texture_count = static_cast<uint32_t>(textures.size());
+  header.string_bytes = static_cast<uint32_t>(strings.size());
+
+  const BakedMeshLayout layout = LayoutFor(header);
+  std::vector<unsigned char> file(layout.end);
+  std::memcpy(file.data(), &header, sizeof(header));
+  Write<BakedVertex>(file, layout.vertices, vertices);
+  Write<uint32_t>(file, layout.indices, indices);
+  Write<BakedSubmesh>(file, layout.submeshes, submeshes);
+  Write<BakedMaterial>(file, layout.materials, materials);
+  Write<BakedMaterialTexture>(file, layout.textures, textures);
+  Write<char>(file, layout.strings, strings);
+  return file;
+}
+
+Result<BakedMesh> BakedMesh::Open(const std::string& path)
+{
+  Result<MappedFile> file = MappedFile::Open(path);
+  if (file.Bad()) {
+    return file.Error();
+  }
+  BakedMesh mesh;
+  if (file->Size() < sizeof(BakedMeshHeader)) {
+    return Error{ "Baked mesh is too small to hold a header" };
+  }
+  std::memcpy(&mesh.header_, file->Data(), sizeof(BakedMeshHeader));
+  const BakedMeshHeader& header = mesh.header_;
+  if (header.magic != BakedMeshMagic) {
+    return Error{ "Not a baked mesh" };
+  }
+  if (header.version != BakedMeshVersion) {
+    return Error{ "Baked mesh was made by a different version of the baker, rebake it" };
+  }
+  // 32 bit counts can't overflow a 64 bit layout, so this is enough to keep every section inside the file.
+  const BakedMeshLayout layout = LayoutFor(header);
+  if (file->Size() < layout.end) {
+    return Error{ "Baked mesh is smaller than its header says" };
+  }
+
+  // Sections are 16 byte aligned from the start of the mapping, which is page aligned.
+  const unsigned char* data = file->Data();
+  // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+  mesh.vertices_ = { reinterpret_cast<const BakedVertex*>(data + layout.vertices), header.vertex_count };
+  mesh.indices_ = { reinterpret_cast<const uint32_t*>(data + layout.indices), header.index_count };
+  mesh.submeshes_ = { reinterpret_cast<const BakedSubmesh*>(data + layout.submeshes), header.submesh_count };
+  mesh.materials_ = { reinterpret_cast<const BakedMaterial*>(data + layout.materials), header.material_count };
+  mesh.textures_ = { reinterpret_cast<const BakedMaterialTexture*>(data + layout.textures), header.texture_count };
+  mesh.strings_ = { reinterpret_cast<const char*>(data + layout.strings), header.string_bytes };
+  // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+  // Anything out of range here would have GL read past the end of a buffer.
+  for (const auto& submesh : mesh.submeshes_) {
+    const bool in_range = submesh.first_index <= header.index_count
+                          && submesh.index_count <= header.index_count - submesh.first_index
+                          && submesh.base_vertex <= header.vertex_count
+                          && submesh.vertex_count <= header.vertex_count - submesh.base_vertex
+                          && submesh.material < header.material_count;
+    if (!in_range) {
+      return Error{ "Baked mesh submesh table is corrupt" };
+    }
+    const auto indices = mesh.GetIndices(submesh);
+    if (std::any_of(
+          indices.begin(), indices.end(), [&](uint32_t index) { return index >= submesh.vertex_count; })) {
+      return Error{ "Baked mesh index is out of range" };
+    }
+  }
+  for (const auto& material : mesh.materials_) {
+    if (material.first_texture > header.texture_count
+        || material.texture_count > header.texture_count - material.first_texture) {
+      return Error{ "Baked mesh material table is corrupt" };
+    }
+  }
+  for (const auto& texture : mesh.textures_) {
+    if (texture.path_offset > header.string_bytes || texture.path_length > header.string_bytes - texture.path_offset
+        || (texture.type != TextureType::Diffuse && texture.type != TextureType::Specular)) {
+      return Error{ "Baked mesh texture table is corrupt" };
+    }
+  }
+
+  mesh.file_ = std::move(*file);
+  return mesh;
+}
+
+}// namespace evie
@@ -0,0 +1,406 @@
+#include "evie/baked_texture.h"
+#include "evie/error.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace evie {
+
+namespace {
+constexpr int BlockSize = 4;
+constexpr int BlockPixels = BlockSize * BlockSize;
+constexpr size_t BC1BlockBytes = 8;
+constexpr size_t BC3BlockBytes = 16;
+// Enough for a 2^31 texture, anything more is a corrupt file.
+constexpr uint32_t MaxMipCount = 32;
+
+struct Colour
+{
+  int r{ 0 };
+  int g{ 0 };
+  int b{ 0 };
+};
+
+struct RGBAImage
+{
+  uint32_t width{ 0 };
+  uint32_t height{ 0 };
+  std::vector<unsigned char> pixels;
+};
+
+uint32_t MipCountFor(uint32_t width, uint32_t height)
+{
+  uint32_t count = 1;
+  for (uint32_t size = std::max(width, height); size > 1; size /= 2) {
+    ++count;
+  }
+  return count;
+}
+
+RGBAImage ExpandToRGBA(const ImageInfo& info, const unsigned char* pixels)
+{
+  RGBAImage image{ static_cast<uint32_t>(info.width), static_cast<uint32_t>(info.height), {} };
+  const size_t count = static_cast<size_t>(image.width) * image.height;
+  image.pixels.resize(count * 4);
+  const auto channels = static_cast<size_t>(info.channels);
+  for (size_t i = 0; i < count; ++i) {
+    const unsigned char* src = pixels + i * channels;
+    unsigned char* dst = &image.pixels[i * 4];
+    // Grey and grey + alpha images spread the grey over all three colours.
+    const bool grey = channels < 3;
+    dst[0] = src[0];
+    dst[1] = grey ? src[0] : src[1];
+    dst[2] = grey ? src[0] : src[2];
+    dst[3] = channels == 2 ? src[1] : (channels == 4 ? src[3] : 255);// NOLINT
+  }
+  return image;
+}
+
+// Box filter to half the size. Odd sizes repeat the last row or column.
+RGBAImage Downsample(const RGBAImage& src)
+{
+  RGBAImage dst{ std::max(src.width / 2, 1U), std::max(src.height / 2, 1U), {} };
+  dst.pixels.resize(static_cast<size_t>(dst.width) * dst.height * 4);
+  for (uint32_t y = 0; y < dst.height; ++y) {
+    const uint32_t y0 = std::min(y * 2, src.height - 1);
+    const uint32_t y1 = std::min(y * 2 + 1, src.height - 1);
+    for (uint32_t x = 0; x < dst.width; ++x) {
+      const uint32_t x0 = std::min(x * 2, src.width - 1);
+      const uint32_t x1 = std::min(x * 2 + 1, src.width - 1);
+      for (size_t c = 0; c < 4; ++c) {
+        const auto at = [&](uint32_t sx, uint32_t sy) {
+          return static_cast<int>(src.pixels[(static_cast<size_t>(sy) * src.width + sx) * 4 + c]);
+        };
+        const int sum = at(x0, y0) + at(x1, y0) + at(x0, y1) + at(x1, y1);
+        dst.pixels[(static_cast<size_t>(y) * dst.width + x) * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+      }
+    }
+  }
+  return dst;
+}
+
+uint16_t PackRGB565(const Colour& colour)
+{
+  const int r = (colour.r * 31 + 127) / 255;// NOLINT
+  const int g = (colour.g * 63 + 127) / 255;// NOLINT
+  const int b = (colour.b * 31 + 127) / 255;// NOLINT
+  return static_cast<uint16_t>((r << 11) | (g << 5) | b);// NOLINT
+}
+
+Colour UnpackRGB565(uint16_t packed)
+{
+  const int r = (packed >> 11) & 0x1F;// NOLINT
+  const int g = (packed >> 5) & 0x3F;// NOLINT
+  const int b = packed & 0x1F;// NOLINT
+  return { (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };// NOLINT
+}
+
+int DistanceSquared(const Colour& a, const unsigned char* pixel)
+{
+  const int r = a.r - pixel[0];
+  const int g = a.g - pixel[1];
+  const int b = a.b - pixel[2];
+  return r * r + g * g + b * b;
+}
+
+void WriteLE16(unsigned char* out, uint16_t value)
+{
+  out[0] = static_cast<unsigned char>(value & 0xFF);// NOLINT
+  out[1] = static_cast<unsigned char>(value >> 8);// NOLINT
+}
+
+// Endpoints are the two pixels furthest apart along the block's main colour axis, found with a few rounds of power
+// iteration on the covariance. Cheap, and close to a full least squares fit for typical texture blocks.
+std::pair<Colour, Colour> ColourEndpoints(const unsigned char* rgba)
+{
+  Colour mean;
+  for (int i = 0; i < BlockPixels; ++i) {
+    mean.r += rgba[i * 4];
+    mean.g += rgba[i * 4 + 1];
+    mean.b += rgba[i * 4 + 2];
+  }
+  std::array<float, 3> centre = { static_cast<float>(mean.r) / BlockPixels,
+    static_cast<float>(mean.g) / BlockPixels,
+    static_cast<float>(mean.b) / BlockPixels };
+
+  std::array<float, 6> covariance{};
+  for (int i = 0; i < BlockPixels; ++i) {
+    const float r = static_cast<float>(rgba[i * 4]) - centre[0];
+    const float g = static_cast<float>(rgba[i * 4 + 1]) - centre[1];
+    const float b = static_cast<float>(rgba[i * 4 + 2]) - centre[2];
+    covariance[0] += r * r;
+    covariance[1] += r * g;
+    covariance[2] += r * b;
+    covariance[3] += g * g;
+    covariance[4] += g * b;
+    covariance[5] += b * b;// NOLINT
+  }
+  std::array<float, 3> axis = { 1.0F, 1.0F, 1.0F };
+  constexpr int Iterations = 4;
+  for (int i = 0; i < Iterations; ++i) {
+    const std::array<float, 3> next = { axis[0] * covariance[0] + axis[1] * covariance[1] + axis[2] * covariance[2],
+      axis[0] * covariance[1] + axis[1] * covariance[3] + axis[2] * covariance[4],
+      axis[0] * covariance[2] + axis[1] * covariance[4] + axis[2] * covariance[5] };// NOLINT
+    const float largest = std::max({ std::abs(next[0]), std::abs(next[1]), std::abs(next[2]) });
+    if (largest < std::numeric_limits<float>::epsilon()) {
+      // Every pixel is the same colour.
+      break;
+    }
+    axis = { next[0] / largest, next[1] / largest, next[2] / largest };
+  }
+
+  int min_index = 0;
+  int max_index = 0;
+  float min_dot = std::numeric_limits<float>::max();
+  float max_dot = std::numeric_limits<float>::lowest();
+  for (int i = 0; i < BlockPixels; ++i) {
+    const float dot = static_cast<float>(rgba[i * 4]) * axis[0] + static_cast<float>(rgba[i * 4 + 1]) * axis[1]
+                      + static_cast<float>(rgba[i * 4 + 2]) * axis[2];
+    if (dot < min_dot) {
+      min_dot = dot;
+      min_index = i;
+    }
+    if (dot > max_dot) {
+      max_dot = dot;
+      max_index = i;
+    }
+  }
+  const auto pixel = [&](int i) { return Colour{ rgba[i * 4], rgba[i * 4 + 1], rgba[i * 4 + 2] }; };
+  return { pixel(max_index), pixel(min_index) };
+}
+
+// Always uses the four colour mode, which BC3 requires and BC1 selects with colour0 > colour1.
+void CompressColourBlock(const unsigned char* rgba, unsigned char* block)
+{
+  auto [high, low] = ColourEndpoints(rgba);
+  uint16_t colour0 = PackRGB565(high);
+  uint16_t colour1 = PackRGB565(low);
+  if (colour0 < colour1) {
+    std::swap(colour0, colour1);
+  }
+  uint32_t indices = 0;
+  if (colour0 != colour1) {
+    const Colour c0 = UnpackRGB565(colour0);
+    const Colour c1 = UnpackRGB565(colour1);
+    const std::array<Colour, 4> palette = { c0,
+      c1,
+      Colour{ (2 * c0.r + c1.r) / 3, (2 * c0.g + c1.g) / 3, (2 * c0.b + c1.b) / 3 },
+      Colour{ (c0.r + 2 * c1.r) / 3, (c0.g + 2 * c1.g) / 3, (c0.b + 2 * c1.b) / 3 } };
+    for (int i = 0; i < BlockPixels; ++i) {
+      uint32_t best = 0;
+      int best_distance = std::numeric_limits<int>::max();
+      for (uint32_t p = 0; p < palette.size(); ++p) {
+        const int distance = DistanceSquared(palette[p], &rgba[i * 4]);
+        if (distance < best_distance) {
+          best_distance = distance;
+          best = p;
+        }
+      }
+      indices |= best << (i * 2);
+    }
+  }
+  WriteLE16(block, colour0);
+  WriteLE16(block + 2, colour1);
+  WriteLE16(block + 4, static_cast<uint16_t>(indices & 0xFFFF));// NOLINT
+  WriteLE16(block + 6, static_cast<uint16_t>(indices >> 16));// NOLINT
+}
+
+// Eight alpha levels between the block's minimum and maximum, 3 bit indices.
+void CompressAlphaBlock(const unsigned char* rgba, unsigned char* block)
+{
+  int alpha0 = 0;
+  int alpha1 = 255;// NOLINT
+  for (int i = 0; i < BlockPixels; ++i) {
+    alpha0 = std::max<int>(alpha0, rgba[i * 4 + 3]);
+    alpha1 = std::min<int>(alpha1, rgba[i * 4 + 3]);
+  }
+  uint64_t indices = 0;
+  if (alpha0 != alpha1) {
+    // alpha0 > alpha1 selects six interpolated levels, ordered from alpha0 to alpha1.
+    std::array<int, 8> palette = { alpha0, alpha1 };
+    for (int i = 1; i < 7; ++i) {// NOLINT
+      palette[static_cast<size_t>(i + 1)] = ((7 - i) * alpha0 + i * alpha1) / 7;// NOLINT
+    }
+    for (int i = 0; i < BlockPixels; ++i) {
+      uint64_t best = 0;
+      int best_distance = std::numeric_limits<int>::max();
+      for (uint64_t p = 0; p < palette.size(); ++p) {
+        const int distance = std::abs(palette[p] - rgba[i * 4 + 3]);
+        if (distance < best_distance) {
+          best_distance = distance;
+          best = p;
+        }
+      }
+      indices |= best << (i * 3);
+    }
+  }
+  block[0] = static_cast<unsigned char>(alpha0);
+  block[1] = static_cast<unsigned char>(alpha1);
+  for (int i = 0; i < 6; ++i) {// NOLINT
+    block[2 + i] = static_cast<unsigned char>((indices >> (i * 8)) & 0xFF);// NOLINT
+  }
+}
+
+void EncodeLevel(const RGBAImage& image, BakedTextureFormat format, unsigned char* out)
+{
+  const size_t count = static_cast<size_t>(image.width) * image.height;
+  switch (format) {
+  case BakedTextureFormat::RGBA8:
+    std::memcpy(out, image.pixels.data(), count * 4);
+    return;
+  case BakedTextureFormat::RGB8:
+    for (size_t i = 0; i < count; ++i) {
+      std::memcpy(out + i * 3, &image.pixels[i * 4], 3);
+    }
+    return;
+  case BakedTextureFormat::BC1:
+  case BakedTextureFormat::BC3:
+    break;
+  }
+
+  const size_t block_bytes = format == BakedTextureFormat::BC1 ? BC1BlockBytes : BC3BlockBytes;
+  std::array<unsigned char, static_cast<size_t>(BlockPixels) * 4> block_pixels{};
+  for (uint32_t by = 0; by < image.height; by += BlockSize) {
+    for (uint32_t bx = 0; bx < image.width; bx += BlockSize) {
+      // Blocks hanging off the edge repeat the last row and column.
+      for (uint32_t y = 0; y < BlockSize; ++y) {
+        for (uint32_t x = 0; x < BlockSize; ++x) {
+          const size_t sx = std::min(bx + x, image.width - 1);
+          const size_t sy = std::min(by + y, image.height - 1);
+          std::memcpy(&block_pixels[(y * BlockSize + x) * 4], &image.pixels[(sy * image.width + sx) * 4], 4);
+        }
+      }
+      if (format == BakedTextureFormat::BC1) {
+        CompressBC1Block(block_pixels.data(), out);
+      } else {
+        CompressBC3Block(block_pixels.data(), out);
+      }
+      out += block_bytes;
+    }
+  }
+}
+
+// Levels start on 16 byte boundaries.
+constexpr uint64_t AlignLevel(uint64_t offset)
+{
+  constexpr uint64_t Alignment = 16;
+  return (offset + Alignment - 1) & ~(Alignment - 1);
+}
+}// namespace
+
+uint64_t BakedMipSize(BakedTextureFormat format, uint32_t width, uint32_t height)
+{
+  const uint64_t blocks = ((static_cast<uint64_t>(width) + 3) / 4) * ((static_cast<uint64_t>(height) + 3) / 4);
+  switch (format) {
+  case BakedTextureFormat::RGB8:
+    return static_cast<uint64_t>(width) * height * 3;
+  case BakedTextureFormat::RGBA8:
+    return static_cast<uint64_t>(width) * height * 4;
+  case BakedTextureFormat::BC1:
+    return blocks * BC1BlockBytes;
+  case BakedTextureFormat::BC3:
+    return blocks * BC3BlockBytes;
+  }
+  return 0;
+}
+
+void CompressBC1Block(const unsigned char* rgba, unsigned char* block) { CompressColourBlock(rgba, block); }
+
+void CompressBC3Block(const unsigned char* rgba, unsigned char* block)
+{
+  CompressAlphaBlock(rgba, block);
+  CompressColourBlock(rgba, block + BC1BlockBytes);
+}
+
+Result<std::vector<unsigned char>>
+  BakeTexture(const ImageInfo& info, const unsigned char* pixels, BakedTextureFormat format, bool flipped)
+{
+  if (pixels == nullptr || info.width <= 0 || info.height <= 0 || info.channels < 1 || info.channels > 4) {
+    return Error{ "Can't bake an empty image or one with an unsupported number of channels" };
+  }
+
+  std::vector<RGBAImage> levels;
+  levels.push_back(ExpandToRGBA(info, pixels));
+  const uint32_t mip_count = MipCountFor(levels.front().width, levels.front().height);
+  levels.reserve(mip_count);
+  while (levels.size() < mip_count) {
+    levels.push_back(Downsample(levels.back()));
+  }
+
+  BakedTextureHeader header;
+  header.format = format;
+  header.width = levels.front().width;
+  header.height = levels.front().height;
+  header.mip_count = mip_count;
+  header.flipped = flipped ? 1 : 0;
+
+  std::vector<BakedMipLevel> mips(mip_count);
+  uint64_t offset = sizeof(BakedTextureHeader) + sizeof(BakedMipLevel) * mip_count;
+  for (size_t level = 0; level < mips.size(); ++level) {
+    offset = AlignLevel(offset);
+    mips[level].width = levels[level].width;
+    mips[level].height = levels[level].height;
+    mips[level].offset = offset;
+    mips[level].size = BakedMipSize(format, levels[level].width, levels[level].height);
+    offset += mips[level].size;
+  }
+
+  std::vector<unsigned char> file(offset);
+  std::memcpy(file.data(), &header, sizeof(header));
+  std::memcpy(file.data() + sizeof(header), mips.data(), sizeof(BakedMipLevel) * mips.size());
+  for (size_t level = 0; level < mips.size(); ++level) {
+    EncodeLevel(levels[level], format, file.data() + mips[level].offset);
+  }
+  return file;
+}
+
+Result<BakedTexture> BakedTexture::Open(const std::string& path)
+{
+  Result<MappedFile> file = MappedFile::Open(path);
+  if (file.Bad()) {
+    return file.Error();
+  }
+  const size_t size = file->Size();
+  BakedTextureHeader header;
+  if (size < sizeof(header)) {
+    return Error{ "Baked texture is too small to hold a header" };
+  }
+  std::memcpy(&header, file->Data(), sizeof(header));
+  if (header.magic != BakedTextureMagic) {
+    return Error{ "Not a baked texture" };
+  }
+  if (header.version != BakedTextureVersion) {
+    return Error{ "Baked texture was made by a different version of the baker, rebake it" };
+  }
+  if (header.format > BakedTextureFormat::BC3 || header.width == 0 || header.height == 0
+      || header.mip_count == 0 || header.mip_count > MaxMipCount) {
+    return Error{ "Baked texture header is corrupt" };
+  }
+  if (size < sizeof(header) + sizeof(BakedMipLevel) * header.mip_count) {
+    return Error{ "Baked texture is too small to hold its mip table" };
+  }
+
+  BakedTexture texture;
+  texture.format_ = header.format;
+  texture.flipped_ = header.flipped != 0;
+  texture.mips_.resize(header.mip_count);
+  std::memcpy(texture.mips_.data(), file->Data() + sizeof(header), sizeof(BakedMipLevel) * header.mip_count);
+  for (uint32_t level = 0; level < header.mip_count; ++level) {
+    const BakedMipLevel& mip = texture.mips_[level];
+    const bool expected_size = mip.width == std::max(header.width >> level, 1U)
+                               && mip.height == std::max(header.height >> level, 1U)
+                               && mip.size == BakedMipSize(header.format, mip.width, mip.height);
+    if (!expected_size || mip.offset > size || mip.size > size - mip.offset) {
+      return Error{ "Baked texture mip table is corrupt" };
+    }
+  }
+  texture.file_ = std::move(*file);
+  return texture;
+}
+
+}// namespace evie
@@ -1,5 +1,100 @@
 #include "rendering/debug.h"
 #include "evie/error.h"
+#include "evie/logging.h"
+
+#include <cstring>
+#include <tuple>
+
+namespace {
+
+// KHR_debug enums. glad is generated for the 3.3 core profile without extensions so these aren't in glad.h.
+constexpr GLenum DebugOutput = 0x92E0;
+constexpr GLenum DebugOutputSynchronous = 0x8242;
+constexpr GLenum DebugSeverityHigh = 0x9146;
+constexpr GLenum DebugSeverityMedium = 0x9147;
+constexpr GLenum DebugSeverityNotification = 0x826B;
+
+using DebugMessageCallbackProc = void(APIENTRY*)(GLDEBUGPROC callback, const void* user_param);
+
+constexpr uint32_t DefaultSampleInterval = 60;
+
+struct GLErrorCheckState
+{
+#if EVIE_GL_ERROR_CHECKING
+  evie::GLErrorCheckMode mode{ evie::GLErrorCheckMode::PerCall };
+#else
+  evie::GLErrorCheckMode mode{ evie::GLErrorCheckMode::Off };
+#endif
+  uint32_t sample_interval{ DefaultSampleInterval };
+  uint64_t frame{ 0 };
+  bool check_this_frame{ true };
+  DebugMessageCallbackProc debug_message_callback{ nullptr };
+};
+
+GLErrorCheckState& GetState()
+{
+  static GLErrorCheckState state;
+  return state;
+}
+
+void APIENTRY DebugMessageCallback(GLenum source,
+  GLenum type,
+  GLuint identifier,
+  GLenum severity,
+  GLsizei length,
+  const GLchar* message,
+  const void* user_param)
+{
+  std::ignore = source;
+  std::ignore = length;
+  std::ignore = user_param;
+  switch (severity) {
+  case DebugSeverityHigh:
+    EV_ERROR("OPENGL DEBUG - type {:#x} id {}: {}", type, identifier, message);
+    break;
+  case DebugSeverityMedium:
+    EV_WARN("OPENGL DEBUG - type {:#x} id {}: {}", type, identifier, message);
+    break;
+  case DebugSeverityNotification:
+    // Drivers are very chatty at this level, e.g. every buffer upload.
+    break;
+  default:
+    EV_INFO("OPENGL DEBUG - type {:#x} id {}: {}", type, identifier, message);
+    break;
+  }
+}
+
+bool HasExtension(const char* name)
+{
+  GLint count = 0;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+  for (GLint i = 0; i < count; ++i) {
+    const auto* extension =
+      reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));// NOLINT
+    if (extension != nullptr && std::strcmp(extension, name) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void UpdateCheckThisFrame(GLErrorCheckState& state)
+{
+  switch (state.mode) {
+  case evie::GLErrorCheckMode::Off:
+  case evie::GLErrorCheckMode::DebugCallback:
+    state.check_this_frame = false;
+    break;
+  case evie::GLErrorCheckMode::Sampled:
+    state.check_this_frame = state.frame % state.sample_interval == 0;
+    break;
+  case evie::GLErrorCheckMode::PerCall:
+    state.check_this_frame = true;
+    break;
+  }
+}
+
+}// namespace
 
 namespace evie {
 Error glCheckError()
@@ -30,4 +125,61 @@ Error glCheckError()
   }
   return error;
 }
-}// namespace evie
\ No newline at end of file
+
+void InitialiseGLErrorChecking(GLADloadproc loader)
+{
+  auto& state = GetState();
+  const bool core_debug = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 3);
+  if (core_debug || HasExtension("GL_KHR_debug")) {
+    state.debug_message_callback =
+      reinterpret_cast<DebugMessageCallbackProc>(loader("glDebugMessageCallback"));// NOLINT
+  } else if (HasExtension("GL_ARB_debug_output")) {
+    state.debug_message_callback =
+      reinterpret_cast<DebugMessageCallbackProc>(loader("glDebugMessageCallbackARB"));// NOLINT
+  }
+}
+
+Error SetGLErrorCheckMode(GLErrorCheckMode mode)
+{
+  auto& state = GetState();
+  Error err = Error::OK();
+  const bool callback_enabled = state.mode == GLErrorCheckMode::DebugCallback;
+  if (mode == GLErrorCheckMode::DebugCallback && state.debug_message_callback == nullptr) {
+    err = Error{ "KHR_debug isn't available, falling back to sampled GL error checking" };
+    mode = GLErrorCheckMode::Sampled;
+  }
+
+  if (mode == GLErrorCheckMode::DebugCallback && !callback_enabled) {
+    glEnable(DebugOutput);
+    // Synchronous so that the callback runs on the calling thread and the call stack points at the bad call.
+    glEnable(DebugOutputSynchronous);
+    state.debug_message_callback(DebugMessageCallback, nullptr);
+  } else if (mode != GLErrorCheckMode::DebugCallback && callback_enabled) {
+    glDisable(DebugOutput);
+    state.debug_message_callback(nullptr, nullptr);
+  }
+
+  state.mode = mode;
+  UpdateCheckThisFrame(state);
+  return err;
+}
+
+GLErrorCheckMode GetGLErrorCheckMode() { return GetState().mode; }
+
+void SetGLErrorSampleInterval(uint32_t frames)
+{
+  auto& state = GetState();
+  state.sample_interval = frames == 0 ? 1 : frames;
+  UpdateCheckThisFrame(state);
+}
+
+void GLErrorCheckNewFrame()
+{
+  auto& state = GetState();
+  ++state.frame;
+  UpdateCheckThisFrame(state);
+}
+
+bool ShouldCheckGLErrors() { return GetState().check_this_frame; }
+
+}// namespace evie
@@ -0,0 +1,188 @@
+#include "evie/frustum_culling.h"
+#include "evie/types.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include <glm/geometric.hpp>
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64)
+#define EVIE_FRUSTUM_CULLING_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace evie {
+
+#ifdef EVIE_FRUSTUM_CULLING_SSE
+namespace {
+  // A frustum plane with each component broadcast across all four lanes.
+  struct SimdPlane
+  {
+    __m128 x;
+    __m128 y;
+    __m128 z;
+    __m128 w;
+  };
+}// namespace
+#endif
+
+BoundingVolume CalculateBoundingVolume(const float* data, size_t float_count, size_t stride)
+{
+  BoundingVolume volume;
+  if (data == nullptr || stride < 3 || float_count < stride) {
+    return volume;
+  }
+
+  const size_t vertex_count = float_count / stride;
+  vec3 min{ data[0], data[1], data[2] };// NOLINT(*-pointer-arithmetic)
+  vec3 max = min;
+  for (size_t i = 1; i < vertex_count; ++i) {
+    const float* position = data + i * stride;// NOLINT(*-pointer-arithmetic)
+    const vec3 point{ position[0], position[1], position[2] };// NOLINT(*-pointer-arithmetic)
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+  }
+  volume.aabb = { min, max };
+
+  // Centre the sphere on the AABB and then find the furthest vertex. This is tighter than using half the diagonal of
+  // the box.
+  const vec3 centre = (min + max) * 0.5F;// NOLINT(*-magic-numbers)
+  float radius_squared = 0.0F;
+  for (size_t i = 0; i < vertex_count; ++i) {
+    const float* position = data + i * stride;// NOLINT(*-pointer-arithmetic)
+    const vec3 offset = vec3{ position[0], position[1], position[2] } - centre;// NOLINT(*-pointer-arithmetic)
+    radius_squared = std::max(radius_squared, glm::dot(offset, offset));
+  }
+  volume.sphere = { centre, std::sqrt(radius_squared) };
+  return volume;
+}
+
+BoundingSphere TransformBoundingSphere(const BoundingSphere& sphere, const mat4& model)
+{
+  const vec4 centre = model * vec4(sphere.centre, 1.0F);
+  // NOLINTBEGIN(*-union-access)
+  const float scale_x = glm::dot(vec3(model[0]), vec3(model[0]));
+  const float scale_y = glm::dot(vec3(model[1]), vec3(model[1]));
+  const float scale_z = glm::dot(vec3(model[2]), vec3(model[2]));
+  const float max_scale = std::sqrt(std::max({ scale_x, scale_y, scale_z }));
+  return { vec3{ centre.x, centre.y, centre.z }, sphere.radius * max_scale };
+  // NOLINTEND(*-union-access)
+}
+
+Frustum Frustum::FromViewProjection(const mat4& view_projection)
+{
+  // Gribb/Hartmann plane extraction. glm is column major so m[col][row], gather the rows first.
+  std::array<vec4, 4> rows{};
+  for (int row = 0; row < 4; ++row) {
+    rows[row] =
+      vec4{ view_projection[0][row], view_projection[1][row], view_projection[2][row], view_projection[3][row] };
+  }
+
+  Frustum frustum;
+  frustum.planes[Left] = rows[3] + rows[0];
+  frustum.planes[Right] = rows[3] - rows[0];
+  frustum.planes[Bottom] = rows[3] + rows[1];
+  frustum.planes[Top] = rows[3] - rows[1];
+  frustum.planes[Near] = rows[3] + rows[2];
+  frustum.planes[Far] = rows[3] - rows[2];
+
+  // Normalise so that plane distances are in world units and can be compared against a radius.
+  for (auto& plane : frustum.planes) {
+    const float length = glm::length(vec3(plane));
+    if (length > 0.0F) {
+      plane = plane * (1.0F / length);
+    }
+  }
+  return frustum;
+}
+
+bool Frustum::Intersects(const BoundingSphere& sphere) const
+{
+  // NOLINTBEGIN(*-union-access)
+  return std::all_of(planes.begin(), planes.end(), [&sphere](const vec4& plane) {
+    return plane.x * sphere.centre.x + plane.y * sphere.centre.y + plane.z * sphere.centre.z + plane.w
+           >= -sphere.radius;
+  });
+  // NOLINTEND(*-union-access)
+}
+
+void FrustumCuller::Clear()
+{
+  x_.clear();
+  y_.clear();
+  z_.clear();
+  radius_.clear();
+  visible_.clear();
+  count_ = 0;
+}
+
+void FrustumCuller::Reserve(size_t count)
+{
+  x_.reserve(count);
+  y_.reserve(count);
+  z_.reserve(count);
+  radius_.reserve(count);
+  visible_.reserve(count);
+}
+
+uint32_t FrustumCuller::Add(const BoundingSphere& sphere)
+{
+  // NOLINTBEGIN(*-union-access)
+  x_.push_back(sphere.centre.x);
+  y_.push_back(sphere.centre.y);
+  z_.push_back(sphere.centre.z);
+  // NOLINTEND(*-union-access)
+  radius_.push_back(sphere.radius);
+  return static_cast<uint32_t>(count_++);
+}
+
+void FrustumCuller::Cull(const Frustum& frustum)
+{
+  visible_.clear();
+  size_t index = 0;
+#ifdef EVIE_FRUSTUM_CULLING_SSE
+  // Broadcast each plane once and test BatchSize spheres against it per iteration.
+  std::array<SimdPlane, Frustum::Count> planes{};
+  for (size_t side = 0; side < Frustum::Count; ++side) {
+    const vec4& plane = frustum.planes[side];// NOLINT(*-constant-array-index)
+    // NOLINTBEGIN(*-union-access, *-constant-array-index)
+    planes[side] = { _mm_set1_ps(plane.x), _mm_set1_ps(plane.y), _mm_set1_ps(plane.z), _mm_set1_ps(plane.w) };
+    // NOLINTEND(*-union-access, *-constant-array-index)
+  }
+
+  const size_t batched_count = count_ - (count_ % BatchSize);
+  for (; index < batched_count; index += BatchSize) {
+    const __m128 x = _mm_loadu_ps(&x_[index]);
+    const __m128 y = _mm_loadu_ps(&y_[index]);
+    const __m128 z = _mm_loadu_ps(&z_[index]);
+    const __m128 negative_radius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&radius_[index]));
+    __m128 inside = _mm_cmpeq_ps(x, x);
+    for (const auto& plane : planes) {
+      __m128 distance = _mm_add_ps(_mm_mul_ps(plane.x, x), plane.w);
+      distance = _mm_add_ps(distance, _mm_mul_ps(plane.y, y));
+      distance = _mm_add_ps(distance, _mm_mul_ps(plane.z, z));
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negative_radius));
+    }
+    // Append the visible lanes in order. A fully culled batch leaves the mask at 0.
+    int mask = _mm_movemask_ps(inside);
+    while (mask != 0) {
+      const int lane = std::countr_zero(static_cast<unsigned int>(mask));
+      visible_.push_back(static_cast<uint32_t>(index + static_cast<size_t>(lane)));
+      mask &= mask - 1;
+    }
+  }
+#endif
+  CullScalar(frustum, index);
+}
+
+void FrustumCuller::CullScalar(const Frustum& frustum, size_t first)
+{
+  for (size_t i = first; i < count_; ++i) {
+    if (frustum.Intersects(BoundingSphere{ vec3{ x_[i], y_[i], z_[i] }, radius_[i] })) {
+      visible_.push_back(static_cast<uint32_t>(i));
+    }
+  }
+}
+
+}// namespace evie
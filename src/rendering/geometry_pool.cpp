@@ -0,0 +1,213 @@
+#include "evie/geometry_pool.h"
+#include "evie/render_stats.h"
+#include "evie/vertex_array.h"
+#include "rendering/debug.h"
+#include "rendering/gl_state_cache.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <numeric>
+
+#include "glad/glad.h"
+
+namespace evie {
+
+std::optional<size_t> RangeAllocator::Allocate(size_t count)
+{
+  if (count == 0) {
+    return std::nullopt;
+  }
+  const auto it =
+    std::find_if(free_.begin(), free_.end(), [count](const Range& range) { return range.count >= count; });
+  if (it == free_.end()) {
+    return std::nullopt;
+  }
+  const size_t offset = it->offset;
+  if (it->count == count) {
+    free_.erase(it);
+  } else {
+    it->offset += count;
+    it->count -= count;
+  }
+  return offset;
+}
+
+void RangeAllocator::Free(size_t offset, size_t count)
+{
+  if (count == 0) {
+    return;
+  }
+  auto next = std::lower_bound(
+    free_.begin(), free_.end(), offset, [](const Range& range, size_t value) { return range.offset < value; });
+  const bool joins_previous = next != free_.begin() && std::prev(next)->offset + std::prev(next)->count == offset;
+  const bool joins_next = next != free_.end() && offset + count == next->offset;
+  if (joins_previous && joins_next) {
+    std::prev(next)->count += count + next->count;
+    free_.erase(next);
+  } else if (joins_previous) {
+    std::prev(next)->count += count;
+  } else if (joins_next) {
+    next->offset = offset;
+    next->count += count;
+  } else {
+    free_.insert(next, { offset, count });
+  }
+}
+
+size_t RangeAllocator::FreeCount() const
+{
+  return std::accumulate(
+    free_.begin(), free_.end(), size_t{ 0 }, [](size_t total, const Range& range) { return total + range.count; });
+}
+
+size_t RangeAllocator::LargestFree() const
+{
+  size_t largest = 0;
+  for (const auto& range : free_) {
+    largest = std::max(largest, range.count);
+  }
+  return largest;
+}
+
+void GeometryDrawList::Add(const GeometryRange& range)
+{
+  counts_.push_back(static_cast<int32_t>(range.index_count));
+  // NOLINTNEXTLINE(*-reinterpret-cast, performance-no-int-to-ptr)
+  offsets_.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(range.first_index) * sizeof(uint32_t)));
+  base_vertices_.push_back(static_cast<int32_t>(range.base_vertex));
+}
+
+void GeometryDrawList::Clear()
+{
+  counts_.clear();
+  offsets_.clear();
+  base_vertices_.clear();
+}
+
+void GeometryDrawList::Reserve(size_t count)
+{
+  counts_.reserve(count);
+  offsets_.reserve(count);
+  base_vertices_.reserve(count);
+}
+
+Error GeometryPool::Initialise(const BufferLayout& layout,
+  size_t vertex_size,
+  size_t vertex_capacity,
+  size_t index_capacity)
+{
+  // Ranges are handed out as 32 bit offsets and base vertices are signed.
+  constexpr auto MaxElements = static_cast<size_t>(std::numeric_limits<int32_t>::max());
+  if (vertex_size == 0 || vertex_capacity > MaxElements || index_capacity > MaxElements) {
+    return Error{ "Geometry pool capacity is out of range" };
+  }
+  // Add() copies vertex_size bytes per vertex, so a mismatch would misread every vertex after the first.
+  if (vertex_size != layout.stride * SizeOfVertexDataType(layout.type)) {
+    return Error{ "Vertex size doesn't match the geometry pool's layout" };
+  }
+  vertex_size_ = vertex_size;
+  vertex_allocator_ = RangeAllocator(vertex_capacity);
+  index_allocator_ = RangeAllocator(index_capacity);
+  GLStateCache& state_cache = GLStateCache::Get();
+
+  unsigned int vertex_array = 0;
+  CallOpenGL(glGenVertexArrays, 1, &vertex_array);
+  vertex_array_ = VertexArrayID(vertex_array);
+  state_cache.BindVertexArray(vertex_array);
+
+  unsigned int vertex_buffer = 0;
+  CallOpenGL(glGenBuffers, 1, &vertex_buffer);
+  vertex_buffer_ = VertexBufferID(vertex_buffer);
+  state_cache.BindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+  CallOpenGL(
+    glBufferData, GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertex_capacity * vertex_size), nullptr, GL_STATIC_DRAW);
+
+  unsigned int index_buffer = 0;
+  CallOpenGL(glGenBuffers, 1, &index_buffer);
+  index_buffer_ = IndicesArrayID(index_buffer);
+  // Bound while the vertex array is, so it becomes part of the vertex array's state.
+  state_cache.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer);
+  CallOpenGL(glBufferData,
+    GL_ELEMENT_ARRAY_BUFFER,
+    static_cast<GLsizeiptr>(index_capacity * sizeof(uint32_t)),
+    nullptr,
+    GL_STATIC_DRAW);
+
+  return SetVertexAttributePointers(layout);
+}
+
+Result<GeometryRange> GeometryPool::Add(const void* vertices, size_t vertex_count, std::span<const uint32_t> indices)
+{
+  // There'd be nothing to draw, and the allocators hand out no empty ranges.
+  if (vertex_count == 0 || indices.empty()) {
+    return Error{ "Can't add a mesh without vertices or indices to a geometry pool" };
+  }
+  if (std::any_of(indices.begin(), indices.end(), [vertex_count](uint32_t index) { return index >= vertex_count; })) {
+    return Error{ "Index is out of range of its vertices" };
+  }
+  const std::optional<size_t> base_vertex = vertex_allocator_.Allocate(vertex_count);
+  if (!base_vertex.has_value()) {
+    return Error{ "Geometry pool has no room for the vertices" };
+  }
+  const std::optional<size_t> first_index = index_allocator_.Allocate(indices.size());
+  if (!first_index.has_value()) {
+    vertex_allocator_.Free(*base_vertex, vertex_count);
+    return Error{ "Geometry pool has no room for the indices" };
+  }
+
+  GLStateCache& state_cache = GLStateCache::Get();
+  state_cache.BindBuffer(GL_ARRAY_BUFFER, vertex_buffer_.Get());
+  CallOpenGL(glBufferSubData,
+    GL_ARRAY_BUFFER,
+    static_cast<GLintptr>(*base_vertex * vertex_size_),
+    static_cast<GLsizeiptr>(vertex_count * vertex_size_),
+    vertices);
+  // The element array binding belongs to the vertex array, so bind that first.
+  state_cache.BindVertexArray(vertex_array_.Get());
+  state_cache.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer_.Get());
+  CallOpenGL(glBufferSubData,
+    GL_ELEMENT_ARRAY_BUFFER,
+    static_cast<GLintptr>(*first_index * sizeof(uint32_t)),
+    static_cast<GLsizeiptr>(indices.size_bytes()),
+    indices.data());
+
+  return GeometryRange{ static_cast<uint32_t>(*first_index),
+    static_cast<uint32_t>(indices.size()),
+    static_cast<uint32_t>(*base_vertex),
+    static_cast<uint32_t>(vertex_count) };
+}
+
+void GeometryPool::Remove(const GeometryRange& range)
+{
+  vertex_allocator_.Free(range.base_vertex, range.vertex_count);
+  index_allocator_.Free(range.first_index, range.index_count);
+}
+
+void GeometryPool::Draw(const GeometryDrawList& draws) const
+{
+  if (draws.Empty()) {
+    return;
+  }
+  GLStateCache::Get().BindVertexArray(vertex_array_.Get());
+  CallOpenGL(glMultiDrawElementsBaseVertex,
+    GL_TRIANGLES,
+    draws.GetCounts().data(),
+    GL_UNSIGNED_INT,
+    draws.GetOffsets().data(),
+    static_cast<GLsizei>(draws.Size()),
+    draws.GetBaseVertices().data());
+  CountDrawCall(draws.Size());
+}
+
+void GeometryPool::Destroy()
+{
+  CallOpenGL(glDeleteBuffers, 1, &vertex_buffer_.Get());
+  GLStateCache::Get().OnBufferDeleted(vertex_buffer_.Get());
+  CallOpenGL(glDeleteBuffers, 1, &index_buffer_.Get());
+  GLStateCache::Get().OnBufferDeleted(index_buffer_.Get());
+  CallOpenGL(glDeleteVertexArrays, 1, &vertex_array_.Get());
+  GLStateCache::Get().OnVertexArrayDeleted(vertex_array_.Get());
+}
+
+}// namespace evie
@@ -0,0 +1,163 @@
+#include "rendering/gl_state_cache.h"
+#include "rendering/debug.h"
+
+namespace evie {
+
+GLFunctions GLFunctions::OpenGL()
+{
+  GLFunctions functions;
+  functions.use_program = [](GLuint program) { CallOpenGL(glUseProgram, program); };
+  functions.bind_vertex_array = [](GLuint vertex_array) { CallOpenGL(glBindVertexArray, vertex_array); };
+  functions.bind_buffer = [](GLenum target, GLuint buffer) { CallOpenGL(glBindBuffer, target, buffer); };
+  functions.active_texture = [](GLenum unit) { CallOpenGL(glActiveTexture, unit); };
+  functions.bind_texture = [](GLenum target, GLuint texture) { CallOpenGL(glBindTexture, target, texture); };
+  return functions;
+}
+
+GLStateCache::GLStateCache(GLFunctions functions) : functions_(functions) { Invalidate(); }
+
+GLStateCache& GLStateCache::Get()
+{
+  static GLStateCache cache;
+  return cache;
+}
+
+void GLStateCache::UseProgram(GLuint program)
+{
+  if (Track(program_, program)) {
+    functions_.use_program(program);
+  }
+}
+
+void GLStateCache::BindVertexArray(GLuint vertex_array)
+{
+  if (Track(vertex_array_, vertex_array)) {
+    functions_.bind_vertex_array(vertex_array);
+    // The element array buffer binding is part of the vertex array's state.
+    buffers_[ElementArrayBuffer] = Unknown;
+  }
+}
+
+void GLStateCache::BindBuffer(GLenum target, GLuint buffer)
+{
+  const size_t index = GetBufferTargetIndex(target);
+  if (index == BufferTargetCount) {
+    ++stats_.issued;
+    functions_.bind_buffer(target, buffer);
+    return;
+  }
+  if (Track(buffers_[index], buffer)) {// NOLINT(*-constant-array-index)
+    functions_.bind_buffer(target, buffer);
+  }
+}
+
+void GLStateCache::ActiveTexture(GLenum unit)
+{
+  if (Track(active_unit_, unit)) {
+    functions_.active_texture(unit);
+  }
+}
+
+void GLStateCache::BindTexture(GLenum target, GLuint texture)
+{
+  const size_t index = GetTextureTargetIndex(target);
+  const size_t unit = active_unit_ - GL_TEXTURE0;
+  if (index == TextureTargetCount || active_unit_ == Unknown || unit >= MaxTextureUnits) {
+    ++stats_.issued;
+    functions_.bind_texture(target, texture);
+    return;
+  }
+  if (Track(textures_[unit][index], texture)) {// NOLINT(*-constant-array-index)
+    functions_.bind_texture(target, texture);
+  }
+}
+
+void GLStateCache::OnProgramDeleted(GLuint program)
+{
+  // The program stays in use until another is bound, but the name may be handed out again.
+  if (program_ == program) {
+    program_ = Unknown;
+  }
+}
+
+void GLStateCache::OnVertexArrayDeleted(GLuint vertex_array)
+{
+  if (vertex_array_ == vertex_array) {
+    vertex_array_ = 0;
+    buffers_[ElementArrayBuffer] = Unknown;
+  }
+}
+
+void GLStateCache::OnBufferDeleted(GLuint buffer)
+{
+  for (auto& bound : buffers_) {
+    if (bound == buffer) {
+      bound = 0;
+    }
+  }
+}
+
+void GLStateCache::OnTextureDeleted(GLuint texture)
+{
+  for (auto& unit : textures_) {
+    for (auto& bound : unit) {
+      if (bound == texture) {
+        bound = 0;
+      }
+    }
+  }
+}
+
+void GLStateCache::Invalidate()
+{
+  program_ = Unknown;
+  vertex_array_ = Unknown;
+  buffers_.fill(Unknown);
+  active_unit_ = Unknown;
+  for (auto& unit : textures_) {
+    unit.fill(Unknown);
+  }
+}
+
+size_t GLStateCache::GetBufferTargetIndex(GLenum target)
+{
+  switch (target) {
+  case GL_ARRAY_BUFFER:
+    return ArrayBuffer;
+  case GL_ELEMENT_ARRAY_BUFFER:
+    return ElementArrayBuffer;
+  case GL_UNIFORM_BUFFER:
+    return UniformBuffer;
+  case GL_PIXEL_UNPACK_BUFFER:
+    return PixelUnpackBuffer;
+  default:
+    return BufferTargetCount;
+  }
+}
+
+size_t GLStateCache::GetTextureTargetIndex(GLenum target)
+{
+  switch (target) {
+  case GL_TEXTURE_2D:
+    return Target2D;
+  case GL_TEXTURE_2D_ARRAY:
+    return Target2DArray;
+  case GL_TEXTURE_CUBE_MAP:
+    return TargetCubeMap;
+  default:
+    return TextureTargetCount;
+  }
+}
+
+bool GLStateCache::Track(GLuint& current, GLuint value)
+{
+  if (current == value) {
+    ++stats_.elided;
+    return false;
+  }
+  current = value;
+  ++stats_.issued;
+  return true;
+}
+
+}// namespace evie
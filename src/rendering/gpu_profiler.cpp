@@ -0,0 +1,178 @@
+#include "evie/gpu_profiler.h"
+#include "rendering/debug.h"
+
+#include <algorithm>
+
+#include "glad/glad.h"
+
+namespace evie {
+
+Error GpuProfiler::Initialise(size_t frames_in_flight, size_t max_zones_per_frame)
+{
+  if (frames_in_flight == 0 || max_zones_per_frame == 0) {
+    return Error{ "GPU profiler needs at least one frame and one zone" };
+  }
+  // Core since GL 3.3, but a null pointer here means the context is older than glad was asked for.
+  if (glQueryCounter == nullptr || glGetQueryObjectui64v == nullptr) {
+    return Error{ "Timer queries aren't supported by this context" };
+  }
+  Destroy();
+
+  max_zones_ = max_zones_per_frame;
+  frames_.resize(frames_in_flight);
+  for (auto& frame : frames_) {
+    frame.zones.reserve(max_zones_);
+  }
+  queries_.resize(frames_in_flight * max_zones_ * 2);
+  CallOpenGL(glGenQueries, static_cast<GLsizei>(queries_.size()), queries_.data());
+  if (!has_track_) {
+    track_ = Profiler::Get().AddTrack("GPU");
+    has_track_ = true;
+  }
+  Calibrate();
+  return Error::OK();
+}
+
+void GpuProfiler::Destroy()
+{
+  if (!queries_.empty()) {
+    CallOpenGL(glDeleteQueries, static_cast<GLsizei>(queries_.size()), queries_.data());
+  }
+  queries_.clear();
+  frames_.clear();
+  open_.clear();
+  last_frame_.clear();
+  current_ = 0;
+  recording_ = false;
+}
+
+void GpuProfiler::Calibrate()
+{
+  GLint64 gpu_now = 0;
+  CallOpenGL(glGetInteger64v, GL_TIMESTAMP, &gpu_now);
+  clock_offset_ns_ = static_cast<int64_t>(Profiler::Now()) - gpu_now;
+}
+
+void GpuProfiler::BeginFrame()
+{
+  if (!IsInitialised()) {
+    return;
+  }
+  if (recording_) {
+    EndFrame();
+  }
+  // Oldest first, starting with the slot about to be reused. Queries complete in order so the first frame that isn't
+  // ready means none after it are either.
+  for (size_t age = 0; age < frames_.size(); ++age) {
+    const size_t slot = (current_ + age) % frames_.size();
+    if (!frames_[slot].pending) {
+      continue;
+    }
+    if (!IsAvailable(frames_[slot])) {
+      break;
+    }
+    Resolve(slot);
+  }
+  Frame& frame = frames_[current_];
+  if (frame.pending) {
+    // The GPU is more than a pool behind, waiting for it would stall the CPU.
+    frame.pending = false;
+    ++dropped_frames_;
+  }
+  frame.zones.clear();
+  open_.clear();
+  recording_ = true;
+}
+
+void GpuProfiler::EndFrame()
+{
+  if (!recording_) {
+    return;
+  }
+  while (!open_.empty()) {
+    EndZone();
+  }
+  Frame& frame = frames_[current_];
+  frame.pending = !frame.zones.empty();
+  recording_ = false;
+  current_ = (current_ + 1) % frames_.size();
+}
+
+void GpuProfiler::BeginZone(const char* name, bool type_name)
+{
+  if (!recording_) {
+    return;
+  }
+  Frame& frame = frames_[current_];
+  if (frame.zones.size() >= max_zones_) {
+    ++dropped_zones_;
+    open_.push_back(NotTimed);
+    return;
+  }
+  const auto zone = static_cast<uint32_t>(frame.zones.size());
+  frame.zones.push_back(Zone{ name, type_name, static_cast<uint16_t>(open_.size()) });
+  frame.last_query = Query(current_, size_t{ zone } * 2);
+  CallOpenGL(glQueryCounter, frame.last_query, GL_TIMESTAMP);
+  open_.push_back(zone);
+}
+
+void GpuProfiler::EndZone()
+{
+  if (!recording_ || open_.empty()) {
+    return;
+  }
+  const uint32_t zone = open_.back();
+  open_.pop_back();
+  if (zone == NotTimed) {
+    return;
+  }
+  Frame& frame = frames_[current_];
+  frame.last_query = Query(current_, size_t{ zone } * 2 + 1);
+  CallOpenGL(glQueryCounter, frame.last_query, GL_TIMESTAMP);
+}
+
+bool GpuProfiler::IsAvailable(const Frame& frame) const
+{
+  GLint available = GL_FALSE;
+  CallOpenGL(glGetQueryObjectiv, frame.last_query, GL_QUERY_RESULT_AVAILABLE, &available);
+  return available == GL_TRUE;
+}
+
+void GpuProfiler::Resolve(size_t slot)
+{
+  constexpr double NanosecondsPerMillisecond = 1'000'000.0;
+  Frame& frame = frames_[slot];
+  Profiler& profiler = Profiler::Get();
+  const bool capturing = profiler.IsCapturing();
+  last_frame_.clear();
+  GLuint64 frame_start = 0;
+  for (size_t i = 0; i < frame.zones.size(); ++i) {
+    GLuint64 begin = 0;
+    GLuint64 end = 0;
+    CallOpenGL(glGetQueryObjectui64v, Query(slot, i * 2), GL_QUERY_RESULT, &begin);
+    CallOpenGL(glGetQueryObjectui64v, Query(slot, i * 2 + 1), GL_QUERY_RESULT, &end);
+    end = std::max(begin, end);
+    if (i == 0) {
+      frame_start = begin;
+    }
+    const Zone& zone = frame.zones[i];
+    last_frame_.push_back(GpuZoneTiming{ zone.name,
+      zone.type_name,
+      zone.depth,
+      static_cast<double>(begin - std::min(begin, frame_start)) / NanosecondsPerMillisecond,
+      static_cast<double>(end - begin) / NanosecondsPerMillisecond });
+    if (capturing) {
+      ProfileEvent event;
+      event.name = zone.name;
+      event.type_name = zone.type_name;
+      event.depth = zone.depth;
+      event.start_ns = static_cast<uint64_t>(std::max(int64_t{ 0 }, static_cast<int64_t>(begin) + clock_offset_ns_));
+      event.duration_ns = end - begin;
+      profiler.RecordOnTrack(track_, event);
+    }
+  }
+  frame.pending = false;
+  ++resolved_frames_;
+}
+
+}// namespace evie
@@ -1,6 +1,7 @@
 #ifndef EVIE_INCLUDE_RENDERING_DEBUG_H_
 #define EVIE_INCLUDE_RENDERING_DEBUG_H_
 
+#include <cstdint>
 #include <source_location>
 #include <string>
 
@@ -9,16 +10,66 @@
 
 #include "glad/glad.h"
 
+// Compile time switch for GL error checking. When 0 CallOpenGL is just the GL call. Defaults to off in release builds.
+#ifndef EVIE_GL_ERROR_CHECKING
+#ifdef NDEBUG
+#define EVIE_GL_ERROR_CHECKING 0
+#else
+#define EVIE_GL_ERROR_CHECKING 1
+#endif
+#endif
+
 namespace evie {
 
+enum class GLErrorCheckMode : uint8_t {
+  // Never call glGetError.
+  Off,
+  // Check after every call, but only every Nth frame.
+  Sampled,
+  // Check after every call.
+  PerCall,
+  // Let the driver report errors through a KHR_debug callback and never poll.
+  DebugCallback
+};
+
 Error EVIE_API glCheckError();
 
+/**
+ * @brief Resolve the KHR_debug entry points so that GLErrorCheckMode::DebugCallback can be used. Needs a current
+ * context. Does nothing if the context doesn't advertise KHR_debug (or ARB_debug_output).
+ *
+ * @param loader The same loader that was passed to glad.
+ */
+EVIE_API void InitialiseGLErrorChecking(GLADloadproc loader);
+
+/**
+ * @brief Select how CallOpenGL checks for errors. If DebugCallback is requested but isn't available the mode falls back
+ * to Sampled and an error is returned.
+ */
+EVIE_API Error SetGLErrorCheckMode(GLErrorCheckMode mode);
+EVIE_API GLErrorCheckMode GetGLErrorCheckMode();
+
+// Number of frames between checked frames in GLErrorCheckMode::Sampled.
+EVIE_API void SetGLErrorSampleInterval(uint32_t frames);
+
+// Advance the frame counter used by GLErrorCheckMode::Sampled. Called once at the start of every frame.
+EVIE_API void GLErrorCheckNewFrame();
+
+// Whether CallOpenGL should poll glGetError after the current call.
+EVIE_API bool ShouldCheckGLErrors();
+
 template<typename func, typename... Ts> struct EVIE_API CallOpenGL
 {
-  CallOpenGL(func&& f, Ts&&... ts, const std::source_location& loc = std::source_location::current())
+  CallOpenGL(func&& f,
+    Ts&&... ts,
+    [[maybe_unused]] const std::source_location& loc = std::source_location::current())
   // CallOpenGL(func&& f, Ts&&... ts)
   {
     f(ts...);
+#if EVIE_GL_ERROR_CHECKING
+    if (!ShouldCheckGLErrors()) {
+      return;
+    }
     Error error = glCheckError();
     if (error.Bad()) {
       // EV_ERROR("OPENGL ERROR - {}", error.Message());
@@ -30,6 +81,7 @@ template<typename func, typename... Ts> struct EVIE_API CallOpenGL
         error.Message());
         //assert(false);
     }
+#endif
   }
 };
 
@@ -37,4 +89,4 @@ template<typename func, typename... Ts> CallOpenGL(func&& f, Ts&&... args) -> Ca
 
 }// namespace evie
 
-#endif// !EVIE_INCLUDE_RENDERING_DEBUG_H_
\ No newline at end of file
+#endif// !EVIE_INCLUDE_RENDERING_DEBUG_H_
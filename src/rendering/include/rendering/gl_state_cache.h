@@ -0,0 +1,95 @@
+#ifndef EVIE_INCLUDE_RENDERING_GL_STATE_CACHE_H_
+#define EVIE_INCLUDE_RENDERING_GL_STATE_CACHE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "evie/core.h"
+
+#include "glad/glad.h"
+
+namespace evie {
+
+// The GL entry points that the state cache forwards to. Swapping the table lets the tracking logic be tested without a
+// GL context.
+struct GLFunctions
+{
+  void (*use_program)(GLuint program){ nullptr };
+  void (*bind_vertex_array)(GLuint vertex_array){ nullptr };
+  void (*bind_buffer)(GLenum target, GLuint buffer){ nullptr };
+  void (*active_texture)(GLenum unit){ nullptr };
+  void (*bind_texture)(GLenum target, GLuint texture){ nullptr };
+
+  // Forwards each call to the loaded OpenGL functions through CallOpenGL.
+  static EVIE_API GLFunctions OpenGL();
+};
+
+// Number of binds that were passed through to GL and the number that were skipped because the state was already set.
+struct GLStateCacheStats
+{
+  size_t issued{ 0 };
+  size_t elided{ 0 };
+};
+
+// Remembers the currently bound program, vertex array, buffer per target and texture per unit so that binds which
+// wouldn't change anything never reach the driver. Everything that binds GL state should go through the cache,
+// anything that doesn't must call Invalidate() afterwards.
+class EVIE_API GLStateCache
+{
+public:
+  static constexpr size_t MaxTextureUnits = 32;
+
+  explicit GLStateCache(GLFunctions functions = GLFunctions::OpenGL());
+
+  // The cache for the current GL context.
+  static GLStateCache& Get();
+
+  void UseProgram(GLuint program);
+  void BindVertexArray(GLuint vertex_array);
+  void BindBuffer(GLenum target, GLuint buffer);
+  // unit is GL_TEXTURE0 + n, the same as glActiveTexture.
+  void ActiveTexture(GLenum unit);
+  // Binds to the currently active texture unit.
+  void BindTexture(GLenum target, GLuint texture);
+
+  // GL unbinds objects when they're deleted and names can be reused, so forget about any binding to a deleted object.
+  void OnProgramDeleted(GLuint program);
+  void OnVertexArrayDeleted(GLuint vertex_array);
+  void OnBufferDeleted(GLuint buffer);
+  void OnTextureDeleted(GLuint texture);
+
+  // Forget all tracked state so that the next bind of everything is issued.
+  void Invalidate();
+
+  [[nodiscard]] const GLStateCacheStats& GetStats() const { return stats_; }
+  void ResetStats() { stats_ = {}; }
+
+  void SetFunctions(GLFunctions functions) { functions_ = functions; }
+
+private:
+  // Marks a binding whose value isn't known.
+  static constexpr GLuint Unknown = std::numeric_limits<GLuint>::max();
+
+  enum BufferTarget : uint8_t { ArrayBuffer, ElementArrayBuffer, UniformBuffer, PixelUnpackBuffer, BufferTargetCount };
+  enum TextureTarget : uint8_t { Target2D, Target2DArray, TargetCubeMap, TextureTargetCount };
+
+  static size_t GetBufferTargetIndex(GLenum target);
+  static size_t GetTextureTargetIndex(GLenum target);
+
+  // Returns true when the call was issued.
+  bool Track(GLuint& current, GLuint value);
+
+  GLFunctions functions_;
+  GLuint program_{ Unknown };
+  GLuint vertex_array_{ Unknown };
+  std::array<GLuint, BufferTargetCount> buffers_{};
+  GLenum active_unit_{ Unknown };
+  std::array<std::array<GLuint, TextureTargetCount>, MaxTextureUnits> textures_{};
+  GLStateCacheStats stats_;
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_RENDERING_GL_STATE_CACHE_H_
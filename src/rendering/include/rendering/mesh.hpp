@@ -1,6 +1,8 @@
 #ifndef EVIE_INCLUDE_RENDERING_MESH_HPP_
 #define EVIE_INCLUDE_RENDERING_MESH_HPP_
 
+#include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -8,6 +10,7 @@
 
 #include <evie/ids.h>
 #include <evie/indices_array.h>
+#include <evie/render_stats.h>
 #include <evie/shader_program.h>
 #include <evie/texture.h>
 #include <evie/types.h>
@@ -27,17 +30,36 @@ struct Vertex
 template<typename VertexType = Vertex> class Mesh
 {
 public:
+  // Freed once uploaded by Initialise() unless the mesh is created with BufferRetention::Retain.
   std::vector<Vertex> vertices;
   std::vector<unsigned int> indices;
   std::vector<Texture2D> textures;
 
   Mesh(const std::vector<Vertex>& vertices,
     const std::vector<unsigned int>& indices,
-    const std::vector<Texture2D>& textures)
-    : vertices(vertices), indices(indices), textures(textures)
+    const std::vector<Texture2D>& textures,
+    BufferRetention retention = BufferRetention::Release)
+    : vertices(vertices), indices(indices), textures(textures), retention_(retention)
   {}
 
-  Error Initialise() { return SetupMesh(); }
+  // For meshes whose vertices and indices are passed straight to Initialise() rather than copied in.
+  explicit Mesh(const std::vector<Texture2D>& textures, BufferRetention retention = BufferRetention::Release)
+    : textures(textures), retention_(retention)
+  {}
+
+  Error Initialise() { return SetupMesh(vertices, indices); }
+
+  // Upload from memory owned by the caller, e.g. a mapped baked mesh. Copied only if the mesh retains its data.
+  Error Initialise(std::span<const Vertex> vertex_data, std::span<const unsigned int> index_data)
+  {
+    if (retention_ == BufferRetention::Retain) {
+      vertices.assign(vertex_data.begin(), vertex_data.end());
+      indices.assign(index_data.begin(), index_data.end());
+    }
+    return SetupMesh(vertex_data, index_data);
+  }
+
+  [[nodiscard]] size_t GetIndexCount() const { return indices_array_.GetCount(); }
 
   void Draw(ShaderProgram& shader);
 
@@ -45,26 +67,36 @@ private:
   VertexArray<VertexType> vertex_array_;
   VertexBuffer<VertexType> vertex_buffer_;
   IndicesArray indices_array_;
-  Error SetupMesh();
+  BufferRetention retention_{ BufferRetention::Release };
+  // "material.texture_diffuseN" style names, one per texture. Empty for unsupported texture types.
+  std::vector<std::string> texture_uniform_names_;
+  std::vector<UniformHandle> texture_uniforms_;
+  // ShaderProgram::GetGeneration() of the program texture_uniforms_ were resolved for. Not its ID, which GL may reuse
+  // for a different program after the first is destroyed.
+  uint64_t texture_uniforms_generation_{ 0 };
+  Error SetupMesh(std::span<const Vertex> vertex_data, std::span<const unsigned int> index_data);
+  void BuildTextureUniformNames();
 };
 
 template<typename VertexType> void Mesh<VertexType>::Draw(ShaderProgram& shader_program)
 {
-  int diffuseNr = 1;
-  int specularNr = 1;
-  for (int i = 0; i < textures.size(); i++) {
-    textures[i].SetSlot(i);
-    std::string texture_name;
-    TextureType& type = textures[i].type;
-    if (type == TextureType::Diffuse) {
-      texture_name = "texture_diffuse" + std::to_string(diffuseNr++);
-    } else if (type == TextureType::Specular) {
-      texture_name = "texture_specular" + std::to_string(specularNr++);
-    } else {
-      EV_INFO("Unsupported texture type");
+  // Handles only need resolving again when the mesh is drawn with a different program.
+  const uint64_t generation = shader_program.GetGeneration();
+  if (generation != 0 && generation != texture_uniforms_generation_) {
+    texture_uniforms_generation_ = generation;
+    texture_uniforms_.clear();
+    for (const auto& name : texture_uniform_names_) {
+      texture_uniforms_.push_back(name.empty() ? UniformHandle{} : shader_program.GetUniformHandle(name));
+    }
+  }
+
+  for (size_t i = 0; i < texture_uniforms_.size(); i++) {
+    if (texture_uniform_names_[i].empty()) {
       continue;
     }
-    shader_program.SetInt("material." + texture_name, i);
+    const int slot = static_cast<int>(i);
+    textures[i].SetSlot(slot);
+    shader_program.SetInt(texture_uniforms_[i], slot);
     textures[i].Bind();
   }
   // Reset current active texture
@@ -74,13 +106,36 @@ template<typename VertexType> void Mesh<VertexType>::Draw(ShaderProgram& shader_
 
   // Draw mesh
   vertex_array_.Bind();
-  CallOpenGL(
-    glDrawElements, GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, static_cast<void*>(0));
+  CallOpenGL(glDrawElements,
+    GL_TRIANGLES,
+    static_cast<unsigned int>(indices_array_.GetCount()),
+    GL_UNSIGNED_INT,
+    static_cast<void*>(0));
+  CountDrawCall();
+}
+
+template<typename VertexType> void Mesh<VertexType>::BuildTextureUniformNames()
+{
+  int diffuseNr = 1;
+  int specularNr = 1;
+  texture_uniform_names_.clear();
+  for (const auto& texture : textures) {
+    if (texture.type == TextureType::Diffuse) {
+      texture_uniform_names_.push_back("material.texture_diffuse" + std::to_string(diffuseNr++));
+    } else if (texture.type == TextureType::Specular) {
+      texture_uniform_names_.push_back("material.texture_specular" + std::to_string(specularNr++));
+    } else {
+      EV_INFO("Unsupported texture type");
+      texture_uniform_names_.emplace_back();
+    }
+  }
 }
 
-template<typename VertexType> Error Mesh<VertexType>::SetupMesh()
+template<typename VertexType>
+Error Mesh<VertexType>::SetupMesh(std::span<const Vertex> vertex_data, std::span<const unsigned int> index_data)
 {
   evie::Error err = Error::OK();
+  BuildTextureUniformNames();
   vertex_array_.Initialise();
 
   const BufferLayout mesh_layout{
@@ -95,11 +150,11 @@ template<typename VertexType> Error Mesh<VertexType>::SetupMesh()
   };
 
   if (err.Good()) {
-    err = vertex_buffer_.Initialise(vertices, mesh_layout);
+    err = vertex_buffer_.Initialise(vertex_data, mesh_layout, retention_);
   }
 
   if (err.Good()) {
-    indices_array_.Initialise(indices);
+    indices_array_.Initialise(index_data, retention_);
   }
 
   if (err.Good()) {
@@ -109,6 +164,14 @@ template<typename VertexType> Error Mesh<VertexType>::SetupMesh()
   if (err.Good()) {
     vertex_array_.AssociateIndicesArray(indices_array_);
   }
+
+  // The GPU has its own copy now, only the counts are needed to draw.
+  if (err.Good() && retention_ == BufferRetention::Release) {
+    vertices.clear();
+    vertices.shrink_to_fit();
+    indices.clear();
+    indices.shrink_to_fit();
+  }
   return err;
 }
 
@@ -5,20 +5,30 @@
 #include <string>
 #include <vector>
 
-#include <assimp/Importer.hpp>
-#include <assimp/postprocess.h>
-#include <assimp/scene.h>
-
 #include <evie/shader_program.h>
 
 #include <rendering/mesh.hpp>
 
 namespace evie {
+class ThreadPool;
+
+/**
+ * @brief A model made of textured meshes. Paths ending in BakedMeshExtension are loaded from a baked mesh without
+ * Assimp, anything else is imported with Assimp.
+ *
+ * Imported meshes are converted and their textures decoded on worker threads, then everything is uploaded in one go
+ * on the calling thread, so a model with many meshes loads in about the time of its largest. Without workers the same
+ * steps run on the calling thread.
+ */
 class Model
 {
 public:
-  Model(const std::string& path) : path_(path) {}
-  Error EVIE_API Initialise();
+  // Pass BufferRetention::Retain to keep each mesh's vertices and indices on the CPU, e.g. for picking or physics.
+  Model(const std::string& path, BufferRetention retention = BufferRetention::Release)
+    : path_(path), retention_(retention)
+  {}
+  // Must be called on the GL thread. Pass a pool such as ResourceManager::GetWorkers() to load in parallel.
+  Error EVIE_API Initialise(ThreadPool* workers = nullptr);
   void EVIE_API Draw(ShaderProgram& shader);
 
 private:
@@ -26,12 +36,15 @@ private:
   std::vector<Mesh<>> meshes_;
   std::string directory_;
   std::string path_;
+  BufferRetention retention_{ BufferRetention::Release };
   std::unordered_map<std::string, Texture2D> loaded_textures_;
 
-  Error LoadModel(const std::string& path);
-  void ProcessNode(aiNode* node, const aiScene* scene);
-  Mesh<> ProcessMesh(aiMesh* mesh, const aiScene* scene);
-  std::vector<Texture2D> LoadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& typeName);
+  Error LoadModel(const std::string& path, ThreadPool* workers);
+  Error LoadBakedModel(const std::string& path);
+  // Load a texture relative to the model's directory, or reuse it if another mesh already has. Pass decoded if the
+  // pixels have already been decoded on a worker.
+  Texture2D LoadTexture(const std::string& name, TextureType type, const DecodedImage* decoded = nullptr);
+  [[nodiscard]] std::string TexturePath(const std::string& name) const;
 };
 }// namespace evie
 
@@ -0,0 +1,44 @@
+#ifndef EVIE_INCLUDE_RENDERING_PIXEL_STORE_H_
+#define EVIE_INCLUDE_RENDERING_PIXEL_STORE_H_
+
+#include "rendering/debug.h"
+
+#include "glad/glad.h"
+
+namespace evie {
+
+/**
+ * @brief Set GL_UNPACK_ALIGNMENT for the lifetime of the object and put back whatever it was before. Pixel store state
+ * is global to the context, so an upload that leaves it changed breaks later uploads made by code expecting the
+ * default of 4, e.g. ImGui's font atlas.
+ */
+class ScopedUnpackAlignment
+{
+public:
+  explicit ScopedUnpackAlignment(GLint alignment)
+  {
+    CallOpenGL(glGetIntegerv, GL_UNPACK_ALIGNMENT, &previous_);
+    if (previous_ != alignment) {
+      CallOpenGL(glPixelStorei, GL_UNPACK_ALIGNMENT, alignment);
+      changed_ = true;
+    }
+  }
+  ~ScopedUnpackAlignment()
+  {
+    if (changed_) {
+      CallOpenGL(glPixelStorei, GL_UNPACK_ALIGNMENT, previous_);
+    }
+  }
+  ScopedUnpackAlignment(const ScopedUnpackAlignment&) = delete;
+  ScopedUnpackAlignment& operator=(const ScopedUnpackAlignment&) = delete;
+  ScopedUnpackAlignment(ScopedUnpackAlignment&&) = delete;
+  ScopedUnpackAlignment& operator=(ScopedUnpackAlignment&&) = delete;
+
+private:
+  GLint previous_{ 4 };
+  bool changed_{ false };
+};
+
+}// namespace evie
+
+#endif// !EVIE_INCLUDE_RENDERING_PIXEL_STORE_H_
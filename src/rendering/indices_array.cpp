@@ -1,23 +1,32 @@
 #include "evie/indices_array.h"
 #include "evie/ids.h"
 #include "rendering/debug.h"
+#include "rendering/gl_state_cache.h"
 
 
 #include "glad/glad.h"
 
 namespace evie {
-void IndicesArray::Initialise(const std::vector<unsigned int>& indices)
+void IndicesArray::Initialise(std::span<const unsigned int> indices, BufferRetention retention)
 {
   unsigned int EBO{ 0 };
   CallOpenGL(glGenBuffers, 1, &EBO);
   id_ = IndicesArrayID(EBO);
-  indices_ = indices;
+  count_ = indices.size();
+  if (retention == BufferRetention::Retain) {
+    indices_.assign(indices.begin(), indices.end());
+  }
   Bind();
-  CallOpenGL(glBufferData, GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(int), indices_.data(), GL_STATIC_DRAW);
+  CallOpenGL(
+    glBufferData, GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
 }
 
-void IndicesArray::Bind() { CallOpenGL(glBindBuffer, GL_ELEMENT_ARRAY_BUFFER, id_.Get()); }
+void IndicesArray::Bind() { GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, id_.Get()); }
 
-void IndicesArray::Destroy() { CallOpenGL(glDeleteBuffers, 1, &id_.Get()); }
+void IndicesArray::Destroy()
+{
+  CallOpenGL(glDeleteBuffers, 1, &id_.Get());
+  GLStateCache::Get().OnBufferDeleted(id_.Get());
+}
 
 }// namespace evie
\ No newline at end of file
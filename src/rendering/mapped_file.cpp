@@ -0,0 +1,113 @@
+#include "evie/mapped_file.h"
+#include "evie/error.h"
+
+#include <utility>
+
+#ifdef EVIE_PLATFORM_WINDOWS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace evie {
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+  : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0))
+{}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+  if (this != &other) {
+    Close();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() { Close(); }
+
+#ifdef EVIE_PLATFORM_WINDOWS
+
+Result<MappedFile> MappedFile::Open(const std::string& path)
+{
+  HANDLE file = CreateFileA(
+    path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return Error{ "Failed to open file for mapping" };
+  }
+  LARGE_INTEGER size{};
+  if (GetFileSizeEx(file, &size) == 0 || size.QuadPart == 0) {
+    CloseHandle(file);
+    return Error{ "Failed to map file, it's empty or its size couldn't be read" };
+  }
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  // The view keeps the mapping and file alive, the handles aren't needed once it exists.
+  CloseHandle(file);
+  if (mapping == nullptr) {
+    return Error{ "Failed to map file" };
+  }
+  void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (view == nullptr) {
+    return Error{ "Failed to map file" };
+  }
+  MappedFile mapped;
+  mapped.data_ = static_cast<const unsigned char*>(view);
+  mapped.size_ = static_cast<size_t>(size.QuadPart);
+  return mapped;
+}
+
+void MappedFile::Close()
+{
+  if (data_ != nullptr) {
+    UnmapViewOfFile(data_);
+    data_ = nullptr;
+    size_ = 0;
+  }
+}
+
+#else
+
+Result<MappedFile> MappedFile::Open(const std::string& path)
+{
+  const int file = open(path.c_str(), O_RDONLY);// NOLINT
+  if (file < 0) {
+    return Error{ "Failed to open file for mapping" };
+  }
+  struct stat info = {};
+  if (fstat(file, &info) != 0 || info.st_size == 0) {
+    close(file);
+    return Error{ "Failed to map file, it's empty or its size couldn't be read" };
+  }
+  const auto size = static_cast<size_t>(info.st_size);
+  void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+  // The mapping holds its own reference to the file.
+  close(file);
+  if (view == MAP_FAILED) {// NOLINT
+    return Error{ "Failed to map file" };
+  }
+  MappedFile mapped;
+  mapped.data_ = static_cast<const unsigned char*>(view);
+  mapped.size_ = size;
+  return mapped;
+}
+
+void MappedFile::Close()
+{
+  if (data_ != nullptr) {
+    munmap(const_cast<unsigned char*>(data_), size_);// NOLINT
+    data_ = nullptr;
+    size_ = 0;
+  }
+}
+
+#endif
+
+}// namespace evie
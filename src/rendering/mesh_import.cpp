@@ -0,0 +1,78 @@
+#include "evie/baked_mesh.h"
+#include "evie/error.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/material.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+namespace evie {
+
+namespace {
+MeshSource::Submesh ImportSubmesh(const aiMesh& mesh)
+{
+  MeshSource::Submesh submesh;
+  submesh.material = mesh.mMaterialIndex;
+  submesh.vertices.resize(mesh.mNumVertices);
+  for (unsigned int i = 0; i < mesh.mNumVertices; ++i) {
+    BakedVertex& vertex = submesh.vertices[i];
+    vertex.position = { mesh.mVertices[i].x, mesh.mVertices[i].y, mesh.mVertices[i].z };
+    if (mesh.HasNormals()) {
+      vertex.normal = { mesh.mNormals[i].x, mesh.mNormals[i].y, mesh.mNormals[i].z };
+    }
+    if (mesh.HasTextureCoords(0)) {
+      vertex.tex_coords = { mesh.mTextureCoords[0][i].x, mesh.mTextureCoords[0][i].y };
+    }
+  }
+  // Triangulated so every face has three indices, anything else is a point or line and isn't drawn.
+  submesh.indices.reserve(static_cast<size_t>(mesh.mNumFaces) * 3);
+  for (unsigned int i = 0; i < mesh.mNumFaces; ++i) {
+    const aiFace& face = mesh.mFaces[i];
+    if (face.mNumIndices == 3) {
+      submesh.indices.insert(submesh.indices.end(), face.mIndices, face.mIndices + 3);// NOLINT
+    }
+  }
+  return submesh;
+}
+
+void ImportNode(const aiNode& node, const aiScene& scene, MeshSource& source)
+{
+  for (unsigned int i = 0; i < node.mNumMeshes; ++i) {
+    source.submeshes.push_back(ImportSubmesh(*scene.mMeshes[node.mMeshes[i]]));// NOLINT
+  }
+  for (unsigned int i = 0; i < node.mNumChildren; ++i) {
+    ImportNode(*node.mChildren[i], scene, source);// NOLINT
+  }
+}
+
+void ImportTextures(const aiMaterial& material, aiTextureType ai_type, TextureType type, MeshSource::Material& out)
+{
+  for (unsigned int i = 0; i < material.GetTextureCount(ai_type); ++i) {
+    aiString path;
+    material.GetTexture(ai_type, i, &path);
+    out.textures.push_back({ type, path.C_Str() });
+  }
+}
+}// namespace
+
+Result<MeshSource> ImportMesh(const std::string& path)
+{
+  Assimp::Importer importer;
+  const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
+  if (scene == nullptr || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) != 0 || scene->mRootNode == nullptr) {
+    return Error{ "ASSIMP failed to read file" };
+  }
+
+  MeshSource source;
+  ImportNode(*scene->mRootNode, *scene, source);
+  source.materials.resize(scene->mNumMaterials);
+  for (unsigned int i = 0; i < scene->mNumMaterials; ++i) {
+    const aiMaterial& material = *scene->mMaterials[i];// NOLINT
+    aiGetMaterialFloat(&material, AI_MATKEY_SHININESS, &source.materials[i].shininess);
+    ImportTextures(material, aiTextureType_DIFFUSE, TextureType::Diffuse, source.materials[i]);
+    ImportTextures(material, aiTextureType_SPECULAR, TextureType::Specular, source.materials[i]);
+  }
+  return source;
+}
+
+}// namespace evie
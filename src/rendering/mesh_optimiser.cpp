@@ -0,0 +1,290 @@
+#include "evie/mesh_optimiser.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string_view>
+
+#include "ankerl/unordered_dense.h"
+
+namespace evie {
+
+namespace {
+constexpr size_t TriangleIndices = 3;
+// Below this many triangles a cluster isn't worth sorting on its own.
+constexpr size_t MinClusterTriangles = 16;
+
+// For each vertex, the triangles that use it.
+struct Adjacency
+{
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> triangles;
+
+  Adjacency(std::span<const uint32_t> indices, size_t vertex_count) : offsets(vertex_count + 1, 0)
+  {
+    for (const uint32_t index : indices) {
+      ++offsets[index + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    triangles.resize(indices.size());
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); ++i) {
+      triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / TriangleIndices);
+    }
+  }
+
+  [[nodiscard]] std::span<const uint32_t> Of(uint32_t vertex) const
+  {
+    return std::span<const uint32_t>(triangles).subspan(offsets[vertex], offsets[vertex + 1] - offsets[vertex]);
+  }
+};
+
+// A FIFO cache simulated with timestamps: a vertex is cached if it was added within the last cache_size additions.
+class CacheSimulation
+{
+public:
+  CacheSimulation(size_t vertex_count, uint32_t cache_size)
+    : added_at_(vertex_count, 0), cache_size_(cache_size), time_(cache_size + 1)
+  {}
+
+  // Returns true on a miss.
+  bool Access(uint32_t vertex)
+  {
+    if (time_ - added_at_[vertex] > cache_size_) {
+      added_at_[vertex] = time_++;
+      return true;
+    }
+    return false;
+  }
+
+  // Evict everything.
+  void Flush() { time_ += cache_size_ + 1; }
+
+private:
+  std::vector<uint64_t> added_at_;
+  uint64_t cache_size_;
+  uint64_t time_;
+};
+
+std::array<float, 3> Position(const float* positions, size_t stride, uint32_t vertex)
+{
+  const float* position = positions + static_cast<size_t>(vertex) * stride;// NOLINT
+  return { position[0], position[1], position[2] };// NOLINT
+}
+}// namespace
+
+size_t GenerateDeduplicationRemap(const void* vertices,
+  size_t vertex_count,
+  size_t vertex_size,
+  std::vector<uint32_t>& remap)
+{
+  const auto* bytes = static_cast<const char*>(vertices);
+  ankerl::unordered_dense::map<std::string_view, uint32_t> unique;
+  unique.reserve(vertex_count);
+  remap.resize(vertex_count);
+  for (size_t i = 0; i < vertex_count; ++i) {
+    const std::string_view key(bytes + i * vertex_size, vertex_size);// NOLINT
+    auto [it, inserted] = unique.try_emplace(key, static_cast<uint32_t>(unique.size()));
+    remap[i] = it->second;
+  }
+  return unique.size();
+}
+
+size_t GenerateVertexFetchRemap(std::span<const uint32_t> indices, size_t vertex_count, std::vector<uint32_t>& remap)
+{
+  remap.assign(vertex_count, UnusedVertex);
+  uint32_t next = 0;
+  for (const uint32_t index : indices) {
+    if (remap[index] == UnusedVertex) {
+      remap[index] = next++;
+    }
+  }
+  return next;
+}
+
+void OptimiseVertexCache(std::span<uint32_t> indices, size_t vertex_count, uint32_t cache_size)
+{
+  const size_t triangle_count = indices.size() / TriangleIndices;
+  if (triangle_count == 0) {
+    return;
+  }
+  const Adjacency adjacency(indices, vertex_count);
+  std::vector<uint32_t> live(vertex_count, 0);
+  for (const uint32_t index : indices) {
+    ++live[index];
+  }
+  // Time each vertex last entered the cache, it's cached while time - cache_time <= cache_size.
+  std::vector<uint64_t> cache_time(vertex_count, 0);
+  uint64_t time = cache_size + 1;
+  std::vector<bool> emitted(triangle_count, false);
+  std::vector<uint32_t> dead_ends;
+  std::vector<uint32_t> output;
+  output.reserve(indices.size());
+  std::vector<uint32_t> candidates;
+  uint32_t next_unvisited = 0;
+
+  int64_t fanning = indices[0];
+  while (fanning >= 0) {
+    candidates.clear();
+    // Emit every remaining triangle around the fanning vertex.
+    for (const uint32_t triangle : adjacency.Of(static_cast<uint32_t>(fanning))) {
+      if (emitted[triangle]) {
+        continue;
+      }
+      emitted[triangle] = true;
+      for (size_t corner = 0; corner < TriangleIndices; ++corner) {
+        const uint32_t vertex = indices[triangle * TriangleIndices + corner];
+        output.push_back(vertex);
+        dead_ends.push_back(vertex);
+        candidates.push_back(vertex);
+        --live[vertex];
+        if (time - cache_time[vertex] > cache_size) {
+          cache_time[vertex] = time++;
+        }
+      }
+    }
+
+    // Next fan around the candidate that will still be cached after its remaining triangles, oldest first.
+    fanning = -1;
+    int64_t best_priority = -1;
+    for (const uint32_t vertex : candidates) {
+      if (live[vertex] == 0) {
+        continue;
+      }
+      int64_t priority = 0;
+      if (time - cache_time[vertex] + 2 * live[vertex] <= cache_size) {
+        priority = static_cast<int64_t>(time - cache_time[vertex]);
+      }
+      if (priority > best_priority) {
+        best_priority = priority;
+        fanning = vertex;
+      }
+    }
+    if (fanning >= 0) {
+      continue;
+    }
+    // Nothing nearby, back up to a recent vertex with triangles left and failing that any vertex.
+    while (!dead_ends.empty() && fanning < 0) {
+      const uint32_t vertex = dead_ends.back();
+      dead_ends.pop_back();
+      if (live[vertex] > 0) {
+        fanning = vertex;
+      }
+    }
+    while (next_unvisited < vertex_count && fanning < 0) {
+      if (live[next_unvisited] > 0) {
+        fanning = next_unvisited;
+      }
+      ++next_unvisited;
+    }
+  }
+  std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void OptimiseOverdraw(std::span<uint32_t> indices,
+  const float* positions,
+  size_t vertex_count,
+  size_t stride,
+  float threshold,
+  uint32_t cache_size)
+{
+  const size_t triangle_count = indices.size() / TriangleIndices;
+  if (triangle_count < MinClusterTriangles * 2) {
+    return;
+  }
+
+  // Split wherever a cluster starting with an empty cache is still within threshold of the mesh as a whole.
+  const float mesh_ratio = AverageCacheMissRatio(indices, vertex_count, cache_size);
+  std::vector<size_t> cluster_starts{ 0 };
+  CacheSimulation cache(vertex_count, cache_size);
+  size_t cluster_misses = 0;
+  for (size_t triangle = 0; triangle < triangle_count; ++triangle) {
+    for (size_t corner = 0; corner < TriangleIndices; ++corner) {
+      cluster_misses += cache.Access(indices[triangle * TriangleIndices + corner]) ? 1 : 0;
+    }
+    const size_t cluster_triangles = triangle + 1 - cluster_starts.back();
+    const float cluster_ratio = static_cast<float>(cluster_misses) / static_cast<float>(cluster_triangles);
+    if (cluster_triangles >= MinClusterTriangles && cluster_ratio <= mesh_ratio * threshold
+        && triangle + 1 < triangle_count) {
+      cluster_starts.push_back(triangle + 1);
+      cluster_misses = 0;
+      cache.Flush();
+    }
+  }
+  cluster_starts.push_back(triangle_count);
+  const size_t cluster_count = cluster_starts.size() - 1;
+  if (cluster_count < 2) {
+    return;
+  }
+
+  std::array<double, 3> mesh_centre{};
+  for (const uint32_t index : indices) {
+    const auto position = Position(positions, stride, index);
+    for (size_t axis = 0; axis < 3; ++axis) {
+      mesh_centre[axis] += position[axis];
+    }
+  }
+  for (auto& axis : mesh_centre) {
+    axis /= static_cast<double>(indices.size());
+  }
+
+  // Clusters facing away from the centre are on the outside of the mesh and most likely to hide others.
+  std::vector<float> outwardness(cluster_count, 0.0F);
+  for (size_t cluster = 0; cluster < cluster_count; ++cluster) {
+    std::array<double, 3> centre{};
+    std::array<double, 3> normal{};
+    for (size_t triangle = cluster_starts[cluster]; triangle < cluster_starts[cluster + 1]; ++triangle) {
+      const auto a = Position(positions, stride, indices[triangle * TriangleIndices]);
+      const auto b = Position(positions, stride, indices[triangle * TriangleIndices + 1]);
+      const auto c = Position(positions, stride, indices[triangle * TriangleIndices + 2]);
+      const std::array<double, 3> ab = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+      const std::array<double, 3> ac = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+      // Unnormalised so larger triangles count for more.
+      normal[0] += ab[1] * ac[2] - ab[2] * ac[1];
+      normal[1] += ab[2] * ac[0] - ab[0] * ac[2];
+      normal[2] += ab[0] * ac[1] - ab[1] * ac[0];
+      for (size_t axis = 0; axis < 3; ++axis) {
+        centre[axis] += (a[axis] + b[axis] + c[axis]) / 3.0;
+      }
+    }
+    const auto triangles = static_cast<double>(cluster_starts[cluster + 1] - cluster_starts[cluster]);
+    const double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    if (length <= 0.0) {
+      continue;
+    }
+    double dot = 0.0;
+    for (size_t axis = 0; axis < 3; ++axis) {
+      dot += (centre[axis] / triangles - mesh_centre[axis]) * normal[axis] / length;
+    }
+    outwardness[cluster] = static_cast<float>(dot);
+  }
+
+  std::vector<size_t> order(cluster_count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return outwardness[a] > outwardness[b]; });
+
+  std::vector<uint32_t> output;
+  output.reserve(indices.size());
+  for (const size_t cluster : order) {
+    output.insert(output.end(),
+      indices.begin() + static_cast<std::ptrdiff_t>(cluster_starts[cluster] * TriangleIndices),
+      indices.begin() + static_cast<std::ptrdiff_t>(cluster_starts[cluster + 1] * TriangleIndices));
+  }
+  std::copy(output.begin(), output.end(), indices.begin());
+}
+
+float AverageCacheMissRatio(std::span<const uint32_t> indices, size_t vertex_count, uint32_t cache_size)
+{
+  const size_t triangle_count = indices.size() / TriangleIndices;
+  if (triangle_count == 0) {
+    return 0.0F;
+  }
+  CacheSimulation cache(vertex_count, cache_size);
+  size_t misses = 0;
+  for (const uint32_t index : indices) {
+    misses += cache.Access(index) ? 1 : 0;
+  }
+  return static_cast<float>(misses) / static_cast<float>(triangle_count);
+}
+
+}// namespace evie
@@ -1,121 +1,250 @@
-
 #include "rendering/model.hpp"
+#include "evie/baked_mesh.h"
+#include "evie/baked_texture.h"
 #include "evie/error.h"
+#include "evie/mesh_optimiser.h"
+#include "evie/profiler.h"
 #include "evie/shader_program.h"
-#include "stb/stb_image.h"
+#include "evie/thread_pool.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/material.h>
-#include <assimp/types.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
 #include <evie/logging.h>
 #include <evie/texture.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <utility>
 
-namespace evie {
 
-Error Model::Initialise() { return LoadModel(path_); }
+namespace evie {
 
-Error Model::LoadModel(const std::string& path)
+namespace {
+// A mesh converted on a worker, waiting for its GL upload.
+struct StagedMesh
 {
-  Assimp::Importer import;
-  const aiScene* scene = nullptr;
-  scene = import.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
+  std::vector<Vertex> vertices;
+  std::vector<unsigned int> indices;
+  unsigned int material{ 0 };
+};
 
-  if (scene == nullptr || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
-    return Error{ "ASSIMP failed to read file" };
-  }
+struct MaterialTexture
+{
+  std::string name;
+  TextureType type{ TextureType::Diffuse };
+};
 
-  directory_ = path.substr(0, path.find_last_of('\\'));
+// A texture decoded on a worker. Baked textures are left to Texture2D, mapping them is already cheap.
+struct StagedTexture
+{
+  MaterialTexture texture;
+  std::optional<DecodedImage> image;
+};
 
-  ProcessNode(scene->mRootNode, scene);
-  return Error::OK();
+// Every mesh in the scene in node order, which is the order they're drawn in.
+void CollectMeshes(const aiNode& node, const aiScene& scene, std::vector<const aiMesh*>& meshes)
+{
+  for (unsigned int i = 0; i < node.mNumMeshes; ++i) {
+    meshes.push_back(scene.mMeshes[node.mMeshes[i]]);// NOLINT
+  }
+  for (unsigned int i = 0; i < node.mNumChildren; ++i) {
+    CollectMeshes(*node.mChildren[i], scene, meshes);// NOLINT
+  }
 }
 
-void Model::Draw(ShaderProgram& shader_program)
+// Only reads the scene, so any number of these can run at once.
+void ConvertMesh(const aiMesh& mesh, StagedMesh& staged)
 {
-  for (auto i = 0; i < meshes_.size(); ++i) {
-    meshes_[i].Draw(shader_program);
+  staged.material = mesh.mMaterialIndex;
+  staged.vertices.resize(mesh.mNumVertices);
+  for (unsigned int i = 0; i < mesh.mNumVertices; ++i) {
+    Vertex& vertex = staged.vertices[i];
+    vertex.position = vec3{ mesh.mVertices[i].x, mesh.mVertices[i].y, mesh.mVertices[i].z };// NOLINT
+    if (mesh.HasNormals()) {
+      vertex.normal = vec3{ mesh.mNormals[i].x, mesh.mNormals[i].y, mesh.mNormals[i].z };// NOLINT
+    }
+    if (mesh.HasTextureCoords(0)) {
+      vertex.tex_coords = vec2{ mesh.mTextureCoords[0][i].x, mesh.mTextureCoords[0][i].y };// NOLINT
+    }
+  }
+  staged.indices.reserve(static_cast<size_t>(mesh.mNumFaces) * 3);
+  for (unsigned int i = 0; i < mesh.mNumFaces; ++i) {
+    const aiFace& face = mesh.mFaces[i];// NOLINT
+    staged.indices.insert(staged.indices.end(), face.mIndices, face.mIndices + face.mNumIndices);// NOLINT
   }
+  OptimiseMesh(staged.vertices, staged.indices);
 }
 
-void Model::ProcessNode(aiNode* node, const aiScene* scene)
+std::vector<MaterialTexture> MaterialTextures(const aiMaterial& material)
 {
-  // process all the node's meshes (if any)
-  for (unsigned int i = 0; i < node->mNumMeshes; i++) {
-    aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-    meshes_.push_back(ProcessMesh(mesh, scene));
-    meshes_.back().Initialise();
+  std::vector<MaterialTexture> textures;
+  for (const auto& [ai_type, type] : { std::pair{ aiTextureType_DIFFUSE, TextureType::Diffuse },
+         std::pair{ aiTextureType_SPECULAR, TextureType::Specular } }) {
+    for (unsigned int i = 0; i < material.GetTextureCount(ai_type); ++i) {
+      aiString name;
+      material.GetTexture(ai_type, i, &name);
+      textures.push_back({ name.C_Str(), type });
+    }
   }
-  // then do the same for each of its children
-  for (unsigned int i = 0; i < node->mNumChildren; i++) {
-    ProcessNode(node->mChildren[i], scene);
+  return textures;
+}
+}// namespace
+
+Error Model::Initialise(ThreadPool* workers)
+{
+  directory_ = std::filesystem::path(path_).parent_path().string();
+  if (IsBakedMesh(path_)) {
+    return LoadBakedModel(path_);
   }
+  return LoadModel(path_, workers);
 }
 
-Mesh<> Model::ProcessMesh(aiMesh* mesh, const aiScene* scene)
+Error Model::LoadModel(const std::string& path, ThreadPool* workers)
 {
-  std::vector<Vertex> vertices;
-  std::vector<unsigned int> indices;
-  std::vector<Texture2D> textures;
-
-  for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
-    Vertex vertex;
-    // process vertex positions, normals and texture coordinates
-    vertex.position = vec3{ mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z };
-    vertex.normal = vec3{ mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z };
-    if (mesh->HasTextureCoords(0)) {
-      vertex.tex_coords.x = mesh->mTextureCoords[0][i].x;
-      vertex.tex_coords.y = mesh->mTextureCoords[0][i].y;
-    }
-    vertices.push_back(vertex);
+  EV_PROFILE_SCOPE("Model::LoadModel");
+  Assimp::Importer import;
+  const aiScene* scene = nullptr;
+  scene = import.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
+
+  if (scene == nullptr || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+    return Error{ "ASSIMP failed to read file" };
   }
 
-  // process indices
-  for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
-    aiFace face = mesh->mFaces[i];
-    for (unsigned int j = 0; j < face.mNumIndices; ++j) {
-      indices.push_back(face.mIndices[j]);
+  std::vector<const aiMesh*> meshes;
+  CollectMeshes(*scene->mRootNode, *scene, meshes);
+  std::vector<std::vector<MaterialTexture>> materials(scene->mNumMaterials);
+  std::vector<bool> used(scene->mNumMaterials, false);
+  for (const aiMesh* mesh : meshes) {
+    if (mesh->mMaterialIndex < used.size()) {
+      used[mesh->mMaterialIndex] = true;
+    }
+  }
+  // Each texture is decoded once however many meshes use it, and not at all for materials no mesh uses.
+  std::vector<StagedTexture> textures;
+  for (unsigned int i = 0; i < scene->mNumMaterials; ++i) {
+    if (!used[i]) {
+      continue;
+    }
+    materials[i] = MaterialTextures(*scene->mMaterials[i]);// NOLINT
+    for (const auto& texture : materials[i]) {
+      const bool seen = loaded_textures_.contains(texture.name)
+                        || std::any_of(textures.begin(), textures.end(), [&](const StagedTexture& staged) {
+                             return staged.texture.name == texture.name;
+                           });
+      if (!seen) {
+        textures.push_back({ texture, std::nullopt });
+      }
     }
   }
 
-  // process material
-  if (mesh->mMaterialIndex >= 0) {
-    aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
-    float shininess{ 0.0F };
-    aiGetMaterialFloat(material, AI_MATKEY_SHININESS, &shininess);
-    std::vector<Texture2D> diffuse_maps = LoadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse");
-    textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
-    std::vector<Texture2D> specular_maps = LoadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular");
-    textures.insert(textures.end(), specular_maps.begin(), specular_maps.end());
+  // CPU phase. Largest meshes first so the pool doesn't finish on one big mesh started last. Only this load's jobs are
+  // waited for, the pool may be shared.
+  TaskGroup jobs(workers);
+  std::vector<StagedMesh> staged(meshes.size());
+  std::vector<size_t> order(meshes.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return meshes[a]->mNumVertices > meshes[b]->mNumVertices;
+  });
+  for (auto& texture : textures) {
+    jobs.Submit([this, &texture] {
+      const std::string texture_path = TexturePath(texture.texture.name);
+      if (IsBakedTexture(texture_path)) {
+        return;
+      }
+      // Left empty on failure, LoadTexture() then tries again on the GL thread and reports the error.
+      if (Result<DecodedImage> image = DecodeImage(texture_path, true); image.Good()) {
+        texture.image = std::move(*image);
+      }
+    });
+  }
+  for (const size_t i : order) {
+    jobs.Submit([&meshes, &staged, i] { ConvertMesh(*meshes[i], staged[i]); });
   }
+  jobs.Wait();
 
-  return { vertices, indices, textures };
+  // GL phase, everything is uploaded back to back.
+  for (const auto& texture : textures) {
+    LoadTexture(texture.texture.name, texture.texture.type, texture.image ? &*texture.image : nullptr);
+  }
+  meshes_.reserve(meshes_.size() + staged.size());
+  for (auto& mesh : staged) {
+    std::vector<Texture2D> mesh_textures;
+    if (mesh.material < materials.size()) {
+      for (const auto& texture : materials[mesh.material]) {
+        mesh_textures.push_back(LoadTexture(texture.name, texture.type));
+      }
+    }
+    meshes_.emplace_back(mesh_textures, retention_);
+    if (Error err = meshes_.back().Initialise(mesh.vertices, mesh.indices); err.Bad()) {
+      return err;
+    }
+    // Free the staging copy as soon as it's uploaded rather than holding every mesh until the end.
+    mesh = StagedMesh{};
+  }
+  return Error::OK();
 }
 
-std::vector<Texture2D> Model::LoadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& typeName)
+Error Model::LoadBakedModel(const std::string& path)
 {
-  std::vector<Texture2D> textures;
-  for (unsigned int i = 0; i < mat->GetTextureCount(type); ++i) {
-    aiString texture_name;
-    mat->GetTexture(type, i, &texture_name);
-    if (auto it = loaded_textures_.find(texture_name.C_Str()); it != loaded_textures_.end()) {
-      textures.push_back(it->second);
-      continue;
-    }
-    Texture2D texture;
-    std::string texture_path = directory_ + "\\" + texture_name.C_Str();
-    Error err = texture.Initialise(texture_path, true);
-    if (err.Bad()) {
-      EV_ERROR("Texture failed to initialise!");
+  EV_PROFILE_SCOPE("Model::LoadBakedModel");
+  // BakedVertex is laid out to match so the mapped vertices can be uploaded as they are.
+  static_assert(sizeof(BakedVertex) == sizeof(Vertex));
+  Result<BakedMesh> baked = BakedMesh::Open(path);
+  if (baked.Bad()) {
+    return baked.Error();
+  }
+
+  meshes_.reserve(baked->GetSubmeshes().size());
+  for (const BakedSubmesh& submesh : baked->GetSubmeshes()) {
+    const BakedMaterial& material = baked->GetMaterials()[submesh.material];
+    std::vector<Texture2D> textures;
+    for (const auto& texture : baked->GetTextures().subspan(material.first_texture, material.texture_count)) {
+      textures.push_back(LoadTexture(std::string(baked->GetTexturePath(texture)), texture.type));
     }
-    if (type == aiTextureType_DIFFUSE) {
-      texture.type = TextureType::Diffuse;
-    } else if (type == aiTextureType_SPECULAR) {
-      texture.type = TextureType::Specular;
+    meshes_.emplace_back(textures, retention_);
+
+    const std::span<const BakedVertex> vertices = baked->GetVertices(submesh);
+    const std::span<const Vertex> mesh_vertices(
+      reinterpret_cast<const Vertex*>(vertices.data()), vertices.size());// NOLINT
+    if (Error err = meshes_.back().Initialise(mesh_vertices, baked->GetIndices(submesh)); err.Bad()) {
+      return err;
     }
-    loaded_textures_.emplace(texture_name.C_Str(), texture);
-    textures.push_back(texture);
   }
-  return textures;
+  return Error::OK();
+}
+
+void Model::Draw(ShaderProgram& shader_program)
+{
+  for (auto i = 0; i < meshes_.size(); ++i) {
+    meshes_[i].Draw(shader_program);
+  }
+}
+
+Texture2D Model::LoadTexture(const std::string& name, TextureType type, const DecodedImage* decoded)
+{
+  if (auto it = loaded_textures_.find(name); it != loaded_textures_.end()) {
+    return it->second;
+  }
+  Texture2D texture;
+  const std::string texture_path = TexturePath(name);
+  Error err = decoded != nullptr ? texture.Initialise(decoded->info, decoded->pixels.get(), texture_path)
+                                 : texture.Initialise(texture_path, true);
+  if (err.Bad()) {
+    EV_ERROR("Texture failed to initialise!");
+  }
+  texture.type = type;
+  loaded_textures_.emplace(name, texture);
+  return texture;
+}
+
+std::string Model::TexturePath(const std::string& name) const
+{
+  return (std::filesystem::path(directory_) / name).string();
 }
-}// namespace evie
\ No newline at end of file
+}// namespace evie
@@ -0,0 +1,733 @@
+#include "evie/null_render_backend.h"
+#include "rendering/gl_state_cache.h"
+
+#include "glad/glad.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string_view>
+#include <vector>
+
+namespace evie {
+
+namespace {
+
+// Only one extension is reported, glad refuses to load a context without any.
+constexpr std::string_view ExtensionName = "GL_EVIE_null_render_backend";
+
+struct NullBackendState
+{
+  NullRenderStats stats;
+  bool record_draws{ false };
+  std::vector<RecordedDraw> draws;
+
+  GLuint next_name{ 1 };
+  GLuint program{ 0 };
+  GLuint vertex_array{ 0 };
+  GLuint pixel_unpack_buffer{ 0 };
+  GLenum active_unit{ GL_TEXTURE0 };
+  GLuint texture_unit_zero{ 0 };
+  GLint unpack_alignment{ 4 };
+  // Backing memory handed out by glMapBufferRange, per target until it's unmapped.
+  std::map<GLenum, std::vector<std::byte>> mapped;
+  // What each glQueryCounter wrote.
+  std::map<GLuint, GLuint64> timestamps;
+  bool query_results_available{ true };
+};
+
+NullBackendState& GetState()
+{
+  static NullBackendState state;
+  return state;
+}
+
+NullRenderStats& Count()
+{
+  NullRenderStats& stats = GetState().stats;
+  ++stats.gl_calls;
+  return stats;
+}
+
+void CountStateChange() { ++Count().state_changes; }
+void CountUniform() { ++Count().uniform_updates; }
+
+void CountUpload(GLsizeiptr bytes, const void* data)
+{
+  NullRenderStats& stats = Count();
+  if (data != nullptr) {
+    stats.bytes_uploaded += static_cast<size_t>(bytes);
+  }
+}
+
+void GenNames(GLsizei count, GLuint* names)
+{
+  NullBackendState& state = GetState();
+  ++state.stats.gl_calls;
+  for (GLsizei i = 0; i < count; ++i) {
+    names[i] = state.next_name++;// NOLINT(*-pointer-arithmetic)
+    ++state.stats.objects_created;
+  }
+}
+
+void DeleteNames(GLsizei count)
+{
+  NullRenderStats& stats = Count();
+  stats.objects_deleted += static_cast<size_t>(count);
+}
+
+// The null GPU does its work instantly, so its clock is the CPU's.
+GLuint64 GpuTimestamp()
+{
+  return static_cast<GLuint64>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Draw(GLenum mode, GLsizei count, GLsizei instances, GLsizei sub_draws)
+{
+  NullBackendState& state = GetState();
+  NullRenderStats& stats = Count();
+  ++stats.draw_calls;
+  stats.draws += static_cast<size_t>(instances) * static_cast<size_t>(sub_draws);
+  if (state.record_draws) {
+    state.draws.push_back(
+      RecordedDraw{ mode, count, instances, sub_draws, state.program, state.vertex_array, state.texture_unit_zero });
+  }
+}
+
+size_t BytesPerPixel(GLenum format, GLenum type)
+{
+  size_t channels = 4;
+  switch (format) {
+  case GL_RED:
+  case GL_DEPTH_COMPONENT:
+    channels = 1;
+    break;
+  case GL_RG:
+    channels = 2;
+    break;
+  case GL_RGB:
+  case GL_BGR:
+    channels = 3;
+    break;
+  default:
+    break;
+  }
+  switch (type) {
+  case GL_UNSIGNED_SHORT:
+  case GL_SHORT:
+  case GL_HALF_FLOAT:
+    return channels * 2;
+  case GL_UNSIGNED_INT:
+  case GL_INT:
+  case GL_FLOAT:
+    return channels * 4;
+  default:
+    return channels;
+  }
+}
+
+void CountTextureUpload(GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels)
+{
+  // With a pixel unpack buffer bound pixels is an offset into it, the bytes were counted when the buffer was written.
+  if (GetState().pixel_unpack_buffer != 0) {
+    Count();
+    return;
+  }
+  const auto texels = static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(depth);
+  CountUpload(static_cast<GLsizeiptr>(texels * BytesPerPixel(format, type)), pixels);
+}
+
+// Objects and state.
+
+void APIENTRY NullGenBuffers(GLsizei count, GLuint* buffers) { GenNames(count, buffers); }
+void APIENTRY NullGenTextures(GLsizei count, GLuint* textures) { GenNames(count, textures); }
+void APIENTRY NullGenVertexArrays(GLsizei count, GLuint* arrays) { GenNames(count, arrays); }
+void APIENTRY NullDeleteBuffers(GLsizei count, const GLuint* /*buffers*/) { DeleteNames(count); }
+void APIENTRY NullDeleteTextures(GLsizei count, const GLuint* /*textures*/) { DeleteNames(count); }
+void APIENTRY NullDeleteVertexArrays(GLsizei count, const GLuint* /*arrays*/) { DeleteNames(count); }
+
+GLuint APIENTRY NullCreateShader(GLenum /*type*/)
+{
+  GLuint shader = 0;
+  GenNames(1, &shader);
+  return shader;
+}
+
+GLuint APIENTRY NullCreateProgram()
+{
+  GLuint program = 0;
+  GenNames(1, &program);
+  return program;
+}
+
+void APIENTRY NullDeleteShader(GLuint /*shader*/) { DeleteNames(1); }
+void APIENTRY NullDeleteProgram(GLuint /*program*/) { DeleteNames(1); }
+
+GLsync APIENTRY NullFenceSync(GLenum /*condition*/, GLbitfield /*flags*/)
+{
+  // Never dereferenced, the driver's syncs are opaque too.
+  GLuint name = 0;
+  GenNames(1, &name);
+  // NOLINTNEXTLINE(*-reinterpret-cast, performance-no-int-to-ptr)
+  return reinterpret_cast<GLsync>(static_cast<uintptr_t>(name));
+}
+
+void APIENTRY NullDeleteSync(GLsync /*sync*/) { DeleteNames(1); }
+
+void APIENTRY NullGenQueries(GLsizei count, GLuint* queries) { GenNames(count, queries); }
+
+void APIENTRY NullDeleteQueries(GLsizei count, const GLuint* queries)
+{
+  for (GLsizei i = 0; i < count; ++i) {
+    GetState().timestamps.erase(queries[i]);// NOLINT(*-pointer-arithmetic)
+  }
+  DeleteNames(count);
+}
+
+void APIENTRY NullQueryCounter(GLuint query, GLenum /*target*/)
+{
+  GetState().timestamps[query] = GpuTimestamp();
+  Count();
+}
+
+GLenum APIENTRY NullClientWaitSync(GLsync /*sync*/, GLbitfield /*flags*/, GLuint64 /*timeout*/)
+{
+  Count();
+  return GL_ALREADY_SIGNALED;
+}
+
+void APIENTRY NullUseProgram(GLuint program)
+{
+  GetState().program = program;
+  CountStateChange();
+}
+
+void APIENTRY NullBindVertexArray(GLuint vertex_array)
+{
+  GetState().vertex_array = vertex_array;
+  CountStateChange();
+}
+
+void APIENTRY NullBindBuffer(GLenum target, GLuint buffer)
+{
+  if (target == GL_PIXEL_UNPACK_BUFFER) {
+    GetState().pixel_unpack_buffer = buffer;
+  }
+  CountStateChange();
+}
+
+void APIENTRY NullBindBufferBase(GLenum /*target*/, GLuint /*index*/, GLuint /*buffer*/) { CountStateChange(); }
+
+void APIENTRY NullActiveTexture(GLenum unit)
+{
+  GetState().active_unit = unit;
+  CountStateChange();
+}
+
+void APIENTRY NullBindTexture(GLenum /*target*/, GLuint texture)
+{
+  NullBackendState& state = GetState();
+  if (state.active_unit == GL_TEXTURE0) {
+    state.texture_unit_zero = texture;
+  }
+  CountStateChange();
+}
+
+void APIENTRY NullEnable(GLenum /*cap*/) { CountStateChange(); }
+void APIENTRY NullDisable(GLenum /*cap*/) { CountStateChange(); }
+void APIENTRY NullViewport(GLint /*x*/, GLint /*y*/, GLsizei /*width*/, GLsizei /*height*/) { CountStateChange(); }
+void APIENTRY NullScissor(GLint /*x*/, GLint /*y*/, GLsizei /*width*/, GLsizei /*height*/) { CountStateChange(); }
+void APIENTRY NullPolygonMode(GLenum /*face*/, GLenum /*mode*/) { CountStateChange(); }
+void APIENTRY NullBlendFunc(GLenum /*source*/, GLenum /*destination*/) { CountStateChange(); }
+void APIENTRY NullDepthFunc(GLenum /*func*/) { CountStateChange(); }
+void APIENTRY NullDepthMask(GLboolean /*flag*/) { CountStateChange(); }
+void APIENTRY NullCullFace(GLenum /*mode*/) { CountStateChange(); }
+void APIENTRY NullClearColor(GLfloat /*red*/, GLfloat /*green*/, GLfloat /*blue*/, GLfloat /*alpha*/)
+{
+  CountStateChange();
+}
+void APIENTRY NullPixelStorei(GLenum name, GLint value)
+{
+  CountStateChange();
+  if (name == GL_UNPACK_ALIGNMENT) {
+    GetState().unpack_alignment = value;
+  }
+}
+
+// Object configuration, counted as calls only.
+
+void APIENTRY NullClear(GLbitfield /*mask*/) { Count(); }
+void APIENTRY NullFlush() { Count(); }
+void APIENTRY NullFinish() { Count(); }
+void APIENTRY NullTexParameteri(GLenum /*target*/, GLenum /*name*/, GLint /*value*/) { Count(); }
+void APIENTRY NullGenerateMipmap(GLenum /*target*/) { Count(); }
+void APIENTRY NullEnableVertexAttribArray(GLuint /*index*/) { Count(); }
+void APIENTRY NullDisableVertexAttribArray(GLuint /*index*/) { Count(); }
+void APIENTRY NullVertexAttribDivisor(GLuint /*index*/, GLuint /*divisor*/) { Count(); }
+void APIENTRY NullVertexAttribPointer(GLuint /*index*/,
+  GLint /*size*/,
+  GLenum /*type*/,
+  GLboolean /*normalised*/,
+  GLsizei /*stride*/,
+  const void* /*pointer*/)
+{
+  Count();
+}
+void APIENTRY
+  NullVertexAttribIPointer(GLuint /*index*/, GLint /*size*/, GLenum /*type*/, GLsizei /*stride*/, const void* /*ptr*/)
+{
+  Count();
+}
+void APIENTRY NullAttachShader(GLuint /*program*/, GLuint /*shader*/) { Count(); }
+void APIENTRY NullShaderSource(GLuint /*shader*/,
+  GLsizei /*count*/,
+  const GLchar* const* /*strings*/,
+  const GLint* /*lengths*/)
+{
+  Count();
+}
+void APIENTRY NullCompileShader(GLuint /*shader*/) { Count(); }
+void APIENTRY NullLinkProgram(GLuint /*program*/) { Count(); }
+void APIENTRY NullUniformBlockBinding(GLuint /*program*/, GLuint /*index*/, GLuint /*binding*/) { Count(); }
+
+// Uploads.
+
+void APIENTRY NullBufferData(GLenum /*target*/, GLsizeiptr size, const void* data, GLenum /*usage*/)
+{
+  CountUpload(size, data);
+}
+
+void APIENTRY NullBufferSubData(GLenum /*target*/, GLintptr /*offset*/, GLsizeiptr size, const void* data)
+{
+  CountUpload(size, data);
+}
+
+void* APIENTRY NullMapBufferRange(GLenum target, GLintptr /*offset*/, GLsizeiptr length, GLbitfield access)
+{
+  NullBackendState& state = GetState();
+  ++state.stats.gl_calls;
+  if ((access & GL_MAP_WRITE_BIT) != 0) {
+    state.stats.bytes_uploaded += static_cast<size_t>(length);
+  }
+  std::vector<std::byte>& memory = state.mapped[target];
+  memory.resize(static_cast<size_t>(length));
+  return memory.data();
+}
+
+GLboolean APIENTRY NullUnmapBuffer(GLenum target)
+{
+  GetState().mapped.erase(target);
+  Count();
+  return GL_TRUE;
+}
+
+void APIENTRY NullTexImage2D(GLenum /*target*/,
+  GLint /*level*/,
+  GLint /*internal_format*/,
+  GLsizei width,
+  GLsizei height,
+  GLint /*border*/,
+  GLenum format,
+  GLenum type,
+  const void* pixels)
+{
+  CountTextureUpload(width, height, 1, format, type, pixels);
+}
+
+void APIENTRY NullTexImage3D(GLenum /*target*/,
+  GLint /*level*/,
+  GLint /*internal_format*/,
+  GLsizei width,
+  GLsizei height,
+  GLsizei depth,
+  GLint /*border*/,
+  GLenum format,
+  GLenum type,
+  const void* pixels)
+{
+  CountTextureUpload(width, height, depth, format, type, pixels);
+}
+
+void APIENTRY NullTexSubImage2D(GLenum /*target*/,
+  GLint /*level*/,
+  GLint /*x*/,
+  GLint /*y*/,
+  GLsizei width,
+  GLsizei height,
+  GLenum format,
+  GLenum type,
+  const void* pixels)
+{
+  CountTextureUpload(width, height, 1, format, type, pixels);
+}
+
+void APIENTRY NullTexSubImage3D(GLenum /*target*/,
+  GLint /*level*/,
+  GLint /*x*/,
+  GLint /*y*/,
+  GLint /*z*/,
+  GLsizei width,
+  GLsizei height,
+  GLsizei depth,
+  GLenum format,
+  GLenum type,
+  const void* pixels)
+{
+  CountTextureUpload(width, height, depth, format, type, pixels);
+}
+
+void APIENTRY NullCompressedTexImage2D(GLenum /*target*/,
+  GLint /*level*/,
+  GLenum /*internal_format*/,
+  GLsizei /*width*/,
+  GLsizei /*height*/,
+  GLint /*border*/,
+  GLsizei size,
+  const void* data)
+{
+  if (GetState().pixel_unpack_buffer != 0) {
+    Count();
+    return;
+  }
+  CountUpload(size, data);
+}
+
+// Uniforms.
+
+void APIENTRY NullUniform1i(GLint /*location*/, GLint /*value*/) { CountUniform(); }
+void APIENTRY NullUniform1f(GLint /*location*/, GLfloat /*value*/) { CountUniform(); }
+void APIENTRY NullUniform3f(GLint /*location*/, GLfloat /*x*/, GLfloat /*y*/, GLfloat /*z*/) { CountUniform(); }
+void APIENTRY NullUniform4f(GLint /*location*/, GLfloat /*x*/, GLfloat /*y*/, GLfloat /*z*/, GLfloat /*w*/)
+{
+  CountUniform();
+}
+void APIENTRY NullUniform3fv(GLint /*location*/, GLsizei /*count*/, const GLfloat* /*value*/) { CountUniform(); }
+void APIENTRY NullUniform4fv(GLint /*location*/, GLsizei /*count*/, const GLfloat* /*value*/) { CountUniform(); }
+void APIENTRY
+  NullUniformMatrix4fv(GLint /*location*/, GLsizei /*count*/, GLboolean /*transpose*/, const GLfloat* /*value*/)
+{
+  CountUniform();
+}
+
+// Draws.
+
+void APIENTRY NullDrawArrays(GLenum mode, GLint /*first*/, GLsizei count) { Draw(mode, count, 1, 1); }
+
+void APIENTRY NullDrawArraysInstanced(GLenum mode, GLint /*first*/, GLsizei count, GLsizei instances)
+{
+  Draw(mode, count, instances, 1);
+}
+
+void APIENTRY NullDrawElements(GLenum mode, GLsizei count, GLenum /*type*/, const void* /*indices*/)
+{
+  Draw(mode, count, 1, 1);
+}
+
+void APIENTRY
+  NullDrawElementsInstanced(GLenum mode, GLsizei count, GLenum /*type*/, const void* /*indices*/, GLsizei instances)
+{
+  Draw(mode, count, instances, 1);
+}
+
+void APIENTRY
+  NullDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum /*type*/, const void* /*indices*/, GLint /*base*/)
+{
+  Draw(mode, count, 1, 1);
+}
+
+void APIENTRY NullMultiDrawElementsBaseVertex(GLenum mode,
+  const GLsizei* counts,
+  GLenum /*type*/,
+  const void* const* /*indices*/,
+  GLsizei draw_count,
+  const GLint* /*base_vertices*/)
+{
+  GLsizei total = 0;
+  for (GLsizei i = 0; i < draw_count; ++i) {
+    total += counts[i];// NOLINT(*-pointer-arithmetic)
+  }
+  Draw(mode, total, 1, draw_count);
+}
+
+// Queries.
+
+GLenum APIENTRY NullGetError()
+{
+  Count();
+  return GL_NO_ERROR;
+}
+
+const GLubyte* APIENTRY NullGetString(GLenum name)
+{
+  Count();
+  const char* value = "";
+  switch (name) {
+  case GL_VERSION:
+    value = "3.3.0 Evie null render backend";
+    break;
+  case GL_SHADING_LANGUAGE_VERSION:
+    value = "3.30";
+    break;
+  case GL_VENDOR:
+  case GL_RENDERER:
+    value = "Evie null render backend";
+    break;
+  default:
+    break;
+  }
+  return reinterpret_cast<const GLubyte*>(value);// NOLINT(*-reinterpret-cast)
+}
+
+const GLubyte* APIENTRY NullGetStringi(GLenum name, GLuint index)
+{
+  Count();
+  if (name == GL_EXTENSIONS && index == 0) {
+    return reinterpret_cast<const GLubyte*>(ExtensionName.data());// NOLINT(*-reinterpret-cast)
+  }
+  return nullptr;
+}
+
+void APIENTRY NullGetIntegerv(GLenum name, GLint* value)
+{
+  Count();
+  // Enough for anything the engine asks about, the GL 3.3 minimums are lower.
+  constexpr GLint MaxTextureSize = 16384;
+  constexpr GLint MaxArrayTextureLayers = 2048;
+  constexpr GLint MaxUniformBufferBindings = 36;
+  switch (name) {
+  case GL_NUM_EXTENSIONS:
+    *value = 1;
+    break;
+  case GL_MAJOR_VERSION:
+    *value = 3;
+    break;
+  case GL_MINOR_VERSION:
+    *value = 3;
+    break;
+  case GL_MAX_TEXTURE_SIZE:
+    *value = MaxTextureSize;
+    break;
+  case GL_MAX_ARRAY_TEXTURE_LAYERS:
+    *value = MaxArrayTextureLayers;
+    break;
+  case GL_MAX_UNIFORM_BUFFER_BINDINGS:
+    *value = MaxUniformBufferBindings;
+    break;
+  case GL_UNPACK_ALIGNMENT:
+    *value = GetState().unpack_alignment;
+    break;
+  default:
+    *value = 0;
+    break;
+  }
+}
+
+void APIENTRY NullGetInteger64v(GLenum name, GLint64* value)
+{
+  Count();
+  *value = name == GL_TIMESTAMP ? static_cast<GLint64>(GpuTimestamp()) : 0;
+}
+
+void APIENTRY NullGetQueryObjectiv(GLuint /*query*/, GLenum name, GLint* value)
+{
+  Count();
+  *value = name == GL_QUERY_RESULT_AVAILABLE && GetState().query_results_available ? GL_TRUE : 0;
+}
+
+void APIENTRY NullGetQueryObjectui64v(GLuint query, GLenum /*name*/, GLuint64* value)
+{
+  NullBackendState& state = GetState();
+  ++state.stats.gl_calls;
+  const auto it = state.timestamps.find(query);
+  *value = it == state.timestamps.end() ? 0 : it->second;
+}
+
+void APIENTRY NullGetShaderiv(GLuint /*shader*/, GLenum name, GLint* value)
+{
+  Count();
+  *value = name == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+void APIENTRY NullGetProgramiv(GLuint /*program*/, GLenum name, GLint* value)
+{
+  Count();
+  *value = name == GL_LINK_STATUS ? GL_TRUE : 0;
+}
+
+void APIENTRY NullGetInfoLog(GLuint /*object*/, GLsizei size, GLsizei* length, GLchar* log)
+{
+  Count();
+  if (length != nullptr) {
+    *length = 0;
+  }
+  if (size > 0) {
+    log[0] = '\0';// NOLINT(*-pointer-arithmetic)
+  }
+}
+
+void APIENTRY NullGetActiveUniform(GLuint /*program*/,
+  GLuint /*index*/,
+  GLsizei size,
+  GLsizei* length,
+  GLint* /*uniform_size*/,
+  GLenum* /*type*/,
+  GLchar* name)
+{
+  NullGetInfoLog(0, size, length, name);
+}
+
+GLint APIENTRY NullGetUniformLocation(GLuint /*program*/, const GLchar* /*name*/)
+{
+  Count();
+  return -1;
+}
+
+GLuint APIENTRY NullGetUniformBlockIndex(GLuint /*program*/, const GLchar* /*name*/)
+{
+  Count();
+  return GL_INVALID_INDEX;
+}
+
+struct NullFunction
+{
+  std::string_view name;
+  void* function;
+};
+
+#define EVIE_NULL_GL(NAME) \
+  NullFunction { "gl" #NAME, reinterpret_cast<void*>(&Null##NAME) }// NOLINT(*-macro-usage, *-reinterpret-cast)
+
+const std::array NullFunctions = {
+  EVIE_NULL_GL(GenBuffers),
+  EVIE_NULL_GL(GenTextures),
+  EVIE_NULL_GL(GenVertexArrays),
+  EVIE_NULL_GL(DeleteBuffers),
+  EVIE_NULL_GL(DeleteTextures),
+  EVIE_NULL_GL(DeleteVertexArrays),
+  EVIE_NULL_GL(CreateShader),
+  EVIE_NULL_GL(CreateProgram),
+  EVIE_NULL_GL(DeleteShader),
+  EVIE_NULL_GL(DeleteProgram),
+  EVIE_NULL_GL(FenceSync),
+  EVIE_NULL_GL(DeleteSync),
+  EVIE_NULL_GL(ClientWaitSync),
+  EVIE_NULL_GL(GenQueries),
+  EVIE_NULL_GL(DeleteQueries),
+  EVIE_NULL_GL(QueryCounter),
+  EVIE_NULL_GL(UseProgram),
+  EVIE_NULL_GL(BindVertexArray),
+  EVIE_NULL_GL(BindBuffer),
+  EVIE_NULL_GL(BindBufferBase),
+  EVIE_NULL_GL(ActiveTexture),
+  EVIE_NULL_GL(BindTexture),
+  EVIE_NULL_GL(Enable),
+  EVIE_NULL_GL(Disable),
+  EVIE_NULL_GL(Viewport),
+  EVIE_NULL_GL(Scissor),
+  EVIE_NULL_GL(PolygonMode),
+  EVIE_NULL_GL(BlendFunc),
+  EVIE_NULL_GL(DepthFunc),
+  EVIE_NULL_GL(DepthMask),
+  EVIE_NULL_GL(CullFace),
+  EVIE_NULL_GL(ClearColor),
+  EVIE_NULL_GL(PixelStorei),
+  EVIE_NULL_GL(Clear),
+  EVIE_NULL_GL(Flush),
+  EVIE_NULL_GL(Finish),
+  EVIE_NULL_GL(TexParameteri),
+  EVIE_NULL_GL(GenerateMipmap),
+  EVIE_NULL_GL(EnableVertexAttribArray),
+  EVIE_NULL_GL(DisableVertexAttribArray),
+  EVIE_NULL_GL(VertexAttribDivisor),
+  EVIE_NULL_GL(VertexAttribPointer),
+  EVIE_NULL_GL(VertexAttribIPointer),
+  EVIE_NULL_GL(AttachShader),
+  EVIE_NULL_GL(ShaderSource),
+  EVIE_NULL_GL(CompileShader),
+  EVIE_NULL_GL(LinkProgram),
+  EVIE_NULL_GL(UniformBlockBinding),
+  EVIE_NULL_GL(BufferData),
+  EVIE_NULL_GL(BufferSubData),
+  EVIE_NULL_GL(MapBufferRange),
+  EVIE_NULL_GL(UnmapBuffer),
+  EVIE_NULL_GL(TexImage2D),
+  EVIE_NULL_GL(TexImage3D),
+  EVIE_NULL_GL(TexSubImage2D),
+  EVIE_NULL_GL(TexSubImage3D),
+  EVIE_NULL_GL(CompressedTexImage2D),
+  EVIE_NULL_GL(Uniform1i),
+  EVIE_NULL_GL(Uniform1f),
+  EVIE_NULL_GL(Uniform3f),
+  EVIE_NULL_GL(Uniform4f),
+  EVIE_NULL_GL(Uniform3fv),
+  EVIE_NULL_GL(Uniform4fv),
+  EVIE_NULL_GL(UniformMatrix4fv),
+  EVIE_NULL_GL(DrawArrays),
+  EVIE_NULL_GL(DrawArraysInstanced),
+  EVIE_NULL_GL(DrawElements),
+  EVIE_NULL_GL(DrawElementsInstanced),
+  EVIE_NULL_GL(DrawElementsBaseVertex),
+  EVIE_NULL_GL(MultiDrawElementsBaseVertex),
+  EVIE_NULL_GL(GetError),
+  EVIE_NULL_GL(GetString),
+  EVIE_NULL_GL(GetStringi),
+  EVIE_NULL_GL(GetIntegerv),
+  EVIE_NULL_GL(GetInteger64v),
+  EVIE_NULL_GL(GetQueryObjectiv),
+  EVIE_NULL_GL(GetQueryObjectui64v),
+  EVIE_NULL_GL(GetShaderiv),
+  EVIE_NULL_GL(GetProgramiv),
+  NullFunction{ "glGetShaderInfoLog", reinterpret_cast<void*>(&NullGetInfoLog) },// NOLINT(*-reinterpret-cast)
+  NullFunction{ "glGetProgramInfoLog", reinterpret_cast<void*>(&NullGetInfoLog) },// NOLINT(*-reinterpret-cast)
+  EVIE_NULL_GL(GetActiveUniform),
+  EVIE_NULL_GL(GetUniformLocation),
+  EVIE_NULL_GL(GetUniformBlockIndex),
+};
+
+#undef EVIE_NULL_GL
+
+// Anything not in the table is left null by glad, so calling a function the backend doesn't know about fails loudly.
+void* GetNullProcAddress(const char* name)
+{
+  for (const auto& function : NullFunctions) {
+    if (function.name == name) {
+      return function.function;
+    }
+  }
+  return nullptr;
+}
+
+}// namespace
+
+Error LoadNullRenderBackend(bool record_draws)
+{
+  NullBackendState& state = GetState();
+  state = {};
+  state.record_draws = record_draws;
+  if (gladLoadGLLoader(&GetNullProcAddress) == 0) {
+    return Error{ "Failed to load the null render backend" };
+  }
+  // Loading made queries of its own.
+  ResetNullRenderStats();
+  // Names start again from 1 so anything the cache remembers is meaningless.
+  GLStateCache::Get().Invalidate();
+  return Error::OK();
+}
+
+const NullRenderStats& GetNullRenderStats() { return GetState().stats; }
+
+std::span<const RecordedDraw> GetRecordedDraws() { return GetState().draws; }
+
+void SetNullQueryResultsAvailable(bool available) { GetState().query_results_available = available; }
+
+void ResetNullRenderStats()
+{
+  NullBackendState& state = GetState();
+  state.stats = {};
+  state.draws.clear();
+}
+
+}// namespace evie
@@ -0,0 +1,296 @@
+#include "evie/render_queue.h"
+#include "evie/logging.h"
+#include "evie/profiler.h"
+#include "evie/render_stats.h"
+#include "evie/uniform_blocks.h"
+#include "evie/vertex_array.h"
+#include "rendering/debug.h"
+#include "rendering/gl_state_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+
+#include <glm/gtc/matrix_inverse.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace evie {
+
+namespace {
+  constexpr int RadixBits = 8;
+  constexpr size_t RadixBuckets = size_t{ 1 } << RadixBits;
+  constexpr int RadixPasses = 64 / RadixBits;
+
+  constexpr uint64_t FieldMask(int bits) { return (uint64_t{ 1 } << bits) - 1; }
+
+  bool HasTexture(const DrawCommand& command) { return command.texture != nullptr || command.texture_array != nullptr; }
+}// namespace
+
+uint64_t RenderQueue::MakeSortKey(
+  uint32_t shader_program, uint32_t texture, uint32_t vertex_array, bool instanced, float depth)
+{
+  const float clamped_depth = std::clamp(depth, 0.0F, 1.0F);
+  const auto quantised_depth =
+    static_cast<uint64_t>(clamped_depth * static_cast<float>(FieldMask(DepthBits)));// NOLINT(*-narrowing-conversions)
+
+  uint64_t key = shader_program & FieldMask(ShaderProgramBits);
+  key = (key << TextureBits) | (texture & FieldMask(TextureBits));
+  key = (key << VertexArrayBits) | (vertex_array & FieldMask(VertexArrayBits));
+  key = (key << InstancedBits) | static_cast<uint64_t>(instanced);
+  key = (key << DepthBits) | quantised_depth;
+  return key;
+}
+
+void RenderQueue::Reserve(size_t count)
+{
+  commands_.reserve(count);
+  entries_.reserve(count);
+  scratch_.reserve(count);
+}
+
+void RenderQueue::Submit(const DrawCommand& command)
+{
+  if (command.shader_program == nullptr) {
+    EV_WARN("Ignoring a draw command without a shader program");
+    return;
+  }
+  const BoundState state = GetState(command);
+  entries_.push_back(
+    { MakeSortKey(state.shader_program, state.texture, state.vertex_array, command.instanced, command.depth),
+      static_cast<uint32_t>(commands_.size()) });
+  commands_.push_back(command);
+}
+
+void RenderQueue::Sort()
+{
+  EV_PROFILE_SCOPE("RenderQueue::Sort");
+  // LSD radix sort, a byte at a time. All the histograms are built in a single pass over the keys and any byte that is
+  // the same for every key is skipped, which is common for the upper bytes when only a few shaders are in use.
+  std::array<std::array<size_t, RadixBuckets>, RadixPasses> histograms{};
+  for (const auto& entry : entries_) {
+    for (int pass = 0; pass < RadixPasses; ++pass) {
+      const auto bucket = static_cast<size_t>((entry.key >> (pass * RadixBits)) & FieldMask(RadixBits));
+      ++histograms[static_cast<size_t>(pass)][bucket];// NOLINT(*-constant-array-index)
+    }
+  }
+
+  scratch_.resize(entries_.size());
+  for (int pass = 0; pass < RadixPasses; ++pass) {
+    auto& histogram = histograms[static_cast<size_t>(pass)];// NOLINT(*-constant-array-index)
+    const bool single_bucket = std::any_of(
+      histogram.begin(), histogram.end(), [this](const size_t count) { return count == entries_.size(); });
+    if (single_bucket) {
+      continue;
+    }
+
+    // Turn the counts into the offset of each bucket in the output.
+    size_t offset = 0;
+    for (auto& count : histogram) {
+      const size_t bucket_count = count;
+      count = offset;
+      offset += bucket_count;
+    }
+
+    for (const auto& entry : entries_) {
+      const auto bucket = static_cast<size_t>((entry.key >> (pass * RadixBits)) & FieldMask(RadixBits));
+      scratch_[histogram[bucket]++] = entry;// NOLINT(*-constant-array-index)
+    }
+    entries_.swap(scratch_);
+  }
+}
+
+void RenderQueue::Execute(const FrameUniforms& frame_uniforms)
+{
+  EV_PROFILE_SCOPE("RenderQueue::Execute");
+  BuildBatches();
+  GLStateCache& state_cache = GLStateCache::Get();
+
+  if (!frame_buffer_.IsInitialised()) {
+    Error err = frame_buffer_.Initialise<FrameBlock>(FrameBlockBinding);
+    if (err.Bad()) {
+      EV_ERROR("Failed to create the frame uniform buffer: {}", err.Message());
+    }
+  }
+  FrameBlock frame_block;
+  frame_block.view = frame_uniforms.view;
+  frame_block.projection = frame_uniforms.projection;
+  frame_block.inverse_transpose_view = glm::inverseTranspose(frame_uniforms.view);
+  frame_block.view_position = frame_uniforms.view_position;
+  frame_block.time = frame_uniforms.time;
+  frame_buffer_.Update(frame_block);
+  // Instance matrices are streamed into a ring of per frame regions so writing them never waits on last frame's draws.
+  size_t instance_offset = 0;
+  bool instances_written = false;
+  if (!instance_data_.empty()) {
+    const size_t instance_bytes = instance_data_.size() * sizeof(InstanceData);
+    if (instance_stream_.GetRegionSize() < instance_bytes) {
+      // Deleting a buffer the GPU is still reading is fine, the driver keeps it alive until the draws complete.
+      instance_stream_.Destroy();
+      Error err = instance_stream_.Initialise(GL_ARRAY_BUFFER, std::bit_ceil(instance_bytes));
+      if (err.Bad()) {
+        EV_ERROR("Failed to create the instance stream buffer: {}", err.Message());
+      }
+    }
+    instance_stream_.BeginFrame();
+    Result<size_t> offset = instance_stream_.Write(instance_data_.data(), instance_bytes, sizeof(vec4));
+    if (offset.Good()) {
+      instance_offset = *offset;
+      instances_written = true;
+    } else {
+      EV_ERROR("Failed to write instance data: {}", offset.Error().Message());
+    }
+  }
+
+  // A mat4 is passed as four vec4 attributes, followed by the layer.
+  static_assert(sizeof(InstanceData) == sizeof(float) * 17);
+  static const BufferLayout instance_layout{ 17, VertexDataType::Float, { 4, 4, 4, 4, 1 } };// NOLINT(*-magic-numbers)
+
+  last_state_changes_ = {};
+  bool first = true;
+  BoundState bound;
+  UniformHandle model_uniform;
+  UniformHandle layer_uniform;
+  for (const auto& batch : batches_) {
+    const DrawCommand& command = commands_[entries_[batch.first_entry].index];
+    const BoundState state = GetState(command);
+    const ShaderProgram& shader_program = *command.shader_program;
+
+    if (first || state.shader_program != bound.shader_program) {
+      shader_program.Use();
+      // View and projection come from the Frame block so only the per draw uniform needs resolving.
+      model_uniform = shader_program.GetUniformHandle("model");
+      layer_uniform = shader_program.GetUniformHandle("texture_layer");
+      ++last_state_changes_.shader_programs;
+    }
+    if (HasTexture(command) && (first || state.texture != bound.texture)) {
+      if (command.texture_array != nullptr) {
+        command.texture_array->SetSlot(0);
+      } else {
+        command.texture->SetSlot(0);
+      }
+      ++last_state_changes_.textures;
+    }
+    if (first || state.vertex_array != bound.vertex_array) {
+      state_cache.BindVertexArray(state.vertex_array);
+      ++last_state_changes_.vertex_arrays;
+    }
+    bound = state;
+    first = false;
+
+    if (command.instanced) {
+      if (!instances_written) {
+        continue;
+      }
+      // GL 3.3 has no base instance so point the instance attributes at this batch's matrices instead.
+      state_cache.BindBuffer(GL_ARRAY_BUFFER, instance_stream_.GetID());
+      Error err = SetVertexAttributePointers(
+        instance_layout, InstanceModelAttribute, instance_offset + batch.first_instance * sizeof(InstanceData), 1);
+      if (err.Bad()) {
+        EV_ERROR("Failed to set instance attributes: {}", err.Message());
+        continue;
+      }
+      CallOpenGL(glDrawArraysInstanced, GL_TRIANGLES, 0, command.vertex_count, static_cast<GLsizei>(batch.count));
+      CountDrawCall(batch.count);
+    } else {
+      shader_program.SetMat4(model_uniform, glm::value_ptr(command.model));
+      if (command.texture_array != nullptr) {
+        shader_program.SetInt(layer_uniform, static_cast<int>(command.texture_layer));
+      }
+      CallOpenGL(glDrawArrays, GL_TRIANGLES, 0, command.vertex_count);
+      CountDrawCall();
+    }
+    ++last_state_changes_.draw_calls;
+  }
+  if (instances_written) {
+    instance_stream_.EndFrame();
+  }
+}
+
+void RenderQueue::Clear()
+{
+  commands_.clear();
+  entries_.clear();
+}
+
+void RenderQueue::Destroy()
+{
+  instance_stream_.Destroy();
+  frame_buffer_.Destroy();
+}
+
+RenderStateChanges RenderQueue::CountStateChanges() const
+{
+  RenderStateChanges changes;
+  bool first = true;
+  bool previous_instanced = false;
+  BoundState bound;
+  for (const auto& entry : entries_) {
+    const DrawCommand& command = commands_[entry.index];
+    const BoundState state = GetState(command);
+    const bool batched = !first && command.instanced && previous_instanced && SameState(state, bound);
+    if (batched) {
+      continue;
+    }
+    if (first || state.shader_program != bound.shader_program) {
+      ++changes.shader_programs;
+    }
+    if (HasTexture(command) && (first || state.texture != bound.texture)) {
+      ++changes.textures;
+    }
+    if (first || state.vertex_array != bound.vertex_array) {
+      ++changes.vertex_arrays;
+    }
+    ++changes.draw_calls;
+    bound = state;
+    previous_instanced = command.instanced;
+    first = false;
+  }
+  return changes;
+}
+
+void RenderQueue::BuildBatches()
+{
+  batches_.clear();
+  instance_data_.clear();
+  bool previous_instanced = false;
+  BoundState previous;
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    const DrawCommand& command = commands_[entries_[i].index];
+    const BoundState state = GetState(command);
+    if (!batches_.empty() && command.instanced && previous_instanced && SameState(state, previous)) {
+      ++batches_.back().count;
+    } else {
+      batches_.push_back({ i, 1, instance_data_.size() });
+    }
+    if (command.instanced) {
+      instance_data_.push_back({ command.model, static_cast<float>(command.texture_layer) });
+    }
+    previous = state;
+    previous_instanced = command.instanced;
+  }
+}
+
+RenderQueue::BoundState RenderQueue::GetState(const DrawCommand& command)
+{
+  BoundState state;
+  if (command.shader_program != nullptr) {
+    if (auto shader_program_id = command.shader_program->GetID(); shader_program_id.Good()) {
+      state.shader_program = shader_program_id->Get();
+    }
+  }
+  if (command.texture_array != nullptr) {
+    state.texture = command.texture_array->GetID().Get();
+  } else if (command.texture != nullptr) {
+    state.texture = command.texture->GetID().Get();
+  }
+  state.vertex_array = command.vertex_array.Get();
+  return state;
+}
+
+bool RenderQueue::SameState(const BoundState& lhs, const BoundState& rhs)
+{
+  return lhs.shader_program == rhs.shader_program && lhs.texture == rhs.texture
+         && lhs.vertex_array == rhs.vertex_array;
+}
+
+}// namespace evie
@@ -0,0 +1,37 @@
+#include "evie/render_stats.h"
+#include "rendering/gl_state_cache.h"
+
+namespace evie {
+
+namespace {
+// Binds are counted by the GLStateCache, this only holds the draws.
+RenderStats& GetDrawStats()
+{
+  static RenderStats stats;
+  return stats;
+}
+}// namespace
+
+void CountDrawCall(size_t draws)
+{
+  RenderStats& stats = GetDrawStats();
+  ++stats.draw_calls;
+  stats.draws += draws;
+}
+
+RenderStats GetRenderStats()
+{
+  RenderStats stats = GetDrawStats();
+  const GLStateCacheStats& binds = GLStateCache::Get().GetStats();
+  stats.binds_issued = binds.issued;
+  stats.binds_elided = binds.elided;
+  return stats;
+}
+
+void ResetRenderStats()
+{
+  GetDrawStats() = {};
+  GLStateCache::Get().ResetStats();
+}
+
+}// namespace evie
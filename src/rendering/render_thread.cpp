@@ -0,0 +1,85 @@
+#include "evie/render_thread.h"
+
+#include <utility>
+
+namespace evie {
+
+void RenderThread::Start(std::function<void()> on_start, RenderFunction render, std::function<void()> on_stop)
+{
+  Stop();
+  on_start_ = std::move(on_start);
+  render_ = std::move(render);
+  on_stop_ = std::move(on_stop);
+  stopping_ = false;
+  thread_ = std::thread([this] { Run(); });
+}
+
+void RenderThread::Stop()
+{
+  if (!thread_.joinable()) {
+    return;
+  }
+  {
+    const std::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  changed_.notify_all();
+  thread_.join();
+}
+
+void RenderThread::Submit(const std::function<void()>& synchronised)
+{
+  std::unique_lock lock(mutex_);
+  changed_.wait(lock, [this] { return !frame_pending_; });
+  if (synchronised) {
+    synchronised_ = &synchronised;
+    changed_.notify_all();
+    changed_.wait(lock, [this] { return synchronised_ == nullptr; });
+  }
+  // The render thread has finished with the other list, so it's free to record the next frame into.
+  recording_ ^= 1U;
+  lists_[recording_].Clear();// NOLINT(*-constant-array-index)
+  frame_pending_ = true;
+  lock.unlock();
+  changed_.notify_all();
+}
+
+size_t RenderThread::GetFramesRendered() const
+{
+  const std::scoped_lock lock(mutex_);
+  return frames_rendered_;
+}
+
+void RenderThread::Run()
+{
+  if (on_start_) {
+    on_start_();
+  }
+  std::unique_lock lock(mutex_);
+  while (true) {
+    changed_.wait(lock, [this] { return stopping_ || frame_pending_ || synchronised_ != nullptr; });
+    if (synchronised_ != nullptr) {
+      (*synchronised_)();
+      synchronised_ = nullptr;
+      changed_.notify_all();
+      continue;
+    }
+    if (!frame_pending_) {
+      break;
+    }
+    // Submit() won't touch the list being rendered until frame_pending_ is cleared.
+    CommandList& list = lists_[recording_ ^ 1U];// NOLINT(*-constant-array-index)
+    lock.unlock();
+    render_(list);
+    lock.lock();
+    frame_pending_ = false;
+    ++frames_rendered_;
+    changed_.notify_all();
+  }
+  lock.unlock();
+  if (on_stop_) {
+    on_stop_();
+  }
+}
+
+}// namespace evie
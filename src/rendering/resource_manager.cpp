@@ -0,0 +1,120 @@
+#include "evie/resource_manager.h"
+#include "evie/error.h"
+#include "evie/shader.h"
+
+#include <string>
+
+namespace evie {
+
+Error ResourceManager::Initialise(size_t worker_count) { return texture_loader_.Initialise(worker_count); }
+
+Result<MeshHandle>
+  ResourceManager::LoadMesh(std::string_view key, const std::vector<float>& vertices, const BufferLayout& layout)
+{
+  return meshes_.Acquire(key, [&](MeshResource& mesh) {
+    Error err = mesh.vertex_buffer.Initialise(vertices, layout);
+    if (err.Good()) {
+      mesh.vertex_array.Initialise();
+      err = mesh.vertex_array.AssociateVertexBuffer(mesh.vertex_buffer);
+      if (err.Bad()) {
+        mesh.vertex_array.Destroy();
+      }
+    }
+    // The buffer is generated even if its initialisation fails.
+    if (err.Bad()) {
+      mesh.vertex_buffer.Destroy();
+    }
+    return err;
+  });
+}
+
+std::string ResourceManager::TextureKey(const std::string& path, bool flip, TextureWrapping wrapping)
+{
+  // The same image loaded with different settings is a different texture.
+  return path + '|' + std::to_string(static_cast<int>(flip)) + '|' + std::to_string(static_cast<int>(wrapping));
+}
+
+Result<TextureHandle> ResourceManager::LoadTexture(const std::string& path, bool flip, TextureWrapping wrapping)
+{
+  return textures_.Acquire(
+    TextureKey(path, flip, wrapping), [&](Texture2D& texture) { return texture.Initialise(path, flip, wrapping); });
+}
+
+Result<TextureHandle> ResourceManager::LoadTextureAsync(const std::string& path, bool flip, TextureWrapping wrapping)
+{
+  bool created = false;
+  Result<TextureHandle> handle = textures_.Acquire(TextureKey(path, flip, wrapping), [&](Texture2D& texture) {
+    texture = texture_loader_.GetPlaceholder();
+    created = true;
+    return Error::OK();
+  });
+  if (handle.Good() && created) {
+    // The callback holds a handle so the texture can't be collected while it's loading.
+    texture_loader_.Load(path, flip, wrapping, [texture = *handle](Result<Texture2D> loaded) {
+      if (loaded.Good() && texture.Valid()) {
+        *texture = *loaded;
+      } else if (loaded.Good()) {
+        // Destroyed while loading, e.g. by Destroy().
+        loaded->Destroy();
+      }
+    });
+  }
+  return handle;
+}
+
+Result<ShaderProgramHandle> ResourceManager::LoadShaderProgram(const std::string& vertex_path,
+  const std::string& fragment_path)
+{
+  const std::string key = vertex_path + '|' + fragment_path;
+  return shader_programs_.Acquire(key, [&](ShaderProgram& shader_program) {
+    // The shaders are deleted once linked, only the program is kept.
+    VertexShader vertex_shader;
+    FragmentShader fragment_shader;
+    Error err = vertex_shader.Initialise(vertex_path);
+    if (err.Good()) {
+      err = fragment_shader.Initialise(fragment_path);
+    }
+    if (err.Good()) {
+      err = shader_program.Initialise(&vertex_shader, &fragment_shader);
+    }
+    // Only left alive when something failed, the program destroys them once it has linked.
+    vertex_shader.Destroy();
+    fragment_shader.Destroy();
+    return err;
+  });
+}
+
+size_t ResourceManager::Update(std::chrono::microseconds budget) { return texture_loader_.Update(budget); }
+
+void ResourceManager::DestroyTexture(Texture2D& texture) const
+{
+  // Textures still loading share the placeholder, that's destroyed with the loader.
+  if (!texture_loader_.IsPlaceholder(texture)) {
+    texture.Destroy();
+  }
+}
+
+size_t ResourceManager::CollectGarbage()
+{
+  size_t destroyed = meshes_.Collect([](MeshResource& mesh) {
+    mesh.vertex_array.Destroy();
+    mesh.vertex_buffer.Destroy();
+  });
+  destroyed += textures_.Collect([this](Texture2D& texture) { DestroyTexture(texture); });
+  destroyed += shader_programs_.Collect([](ShaderProgram& shader_program) { shader_program.Destroy(); });
+  return destroyed;
+}
+
+void ResourceManager::Destroy()
+{
+  meshes_.Clear([](MeshResource& mesh) {
+    mesh.vertex_array.Destroy();
+    mesh.vertex_buffer.Destroy();
+  });
+  textures_.Clear([this](Texture2D& texture) { DestroyTexture(texture); });
+  shader_programs_.Clear([](ShaderProgram& shader_program) { shader_program.Destroy(); });
+  texture_arrays_.Destroy();
+  texture_loader_.Destroy();
+}
+
+}// namespace evie
@@ -3,35 +3,38 @@
 #include "evie/ids.h"
 #include "evie/logging.h"
 #include "evie/shader.h"
+#include "evie/uniform_blocks.h"
 #include "rendering/debug.h"
+#include "rendering/gl_state_cache.h"
 
 #include <array>
+#include <atomic>
+#include <string>
+#include <string_view>
 #include <evie/types.h>
 
 namespace evie {
 
+namespace {
+  // Programs can be linked from any thread that has a context.
+  std::atomic<uint64_t> next_generation{ 1 };
+}// namespace
+
 Error ShaderProgram::Initialise(VertexShader* vertex_shader, FragmentShader* fragment_shader)
 {
-  vertex_shader_ = vertex_shader;
-  fragment_shader_ = fragment_shader;
-  id_ = glCreateProgram();
-
-  // Attach the vertex shader
-  Result<ShaderID> vertex_id = vertex_shader_->GetID();
-  if (vertex_id.Good()) {
-    CallOpenGL(glAttachShader, id_, vertex_id->Get());
-  } else {
+  Result<ShaderID> vertex_id = vertex_shader->GetID();
+  if (vertex_id.Bad()) {
     return vertex_id.Error();
   }
-
-  // Attach the fragement shader
-  Result<ShaderID> fragment_id = fragment_shader_->GetID();
-  if (fragment_id.Good()) {
-    CallOpenGL(glAttachShader, id_, fragment_id->Get());
-  } else {
+  Result<ShaderID> fragment_id = fragment_shader->GetID();
+  if (fragment_id.Bad()) {
     return fragment_id.Error();
   }
 
+  id_ = glCreateProgram();
+  CallOpenGL(glAttachShader, id_, vertex_id->Get());
+  CallOpenGL(glAttachShader, id_, fragment_id->Get());
+
   // Link the shaders to the program
   CallOpenGL(glLinkProgram, id_);
   int success{ 0 };
@@ -42,48 +45,108 @@ Error ShaderProgram::Initialise(VertexShader* vertex_shader, FragmentShader* fra
     CallOpenGL(glGetProgramInfoLog, id_, log_length, nullptr, infoLog.data());
     EV_ERROR("ERROR::SHADER::FRAGMENT::COMPILATION_FAILED");
     EV_ERROR("{}", infoLog.data());
+    CallOpenGL(glDeleteProgram, id_);
+    id_ = 0;
     return Error{ "Failed to link shader program" };
   }
 
-  CallOpenGL(glDeleteShader, vertex_id->Get());
-  CallOpenGL(glDeleteShader, fragment_id->Get());
+  // The program keeps the compiled code, the shader objects are only needed to link.
+  vertex_shader->Destroy();
+  fragment_shader->Destroy();
 
+  BuildUniformTable();
+  BindUniformBlocks();
+  generation_ = next_generation++;
   initialised_ = true;
   return Error::OK();
 }
 
-void ShaderProgram::Use() const { CallOpenGL(glUseProgram, id_); }
+void ShaderProgram::BuildUniformTable()
+{
+  uniforms_.clear();
+  GLint uniform_count{ 0 };
+  GLint max_name_length{ 0 };
+  CallOpenGL(glGetProgramiv, id_, GL_ACTIVE_UNIFORMS, &uniform_count);
+  CallOpenGL(glGetProgramiv, id_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length);
+  std::string name(static_cast<size_t>(max_name_length), '\0');
+  for (GLint i = 0; i < uniform_count; ++i) {
+    GLsizei length{ 0 };
+    GLint size{ 0 };
+    GLenum type{ 0 };
+    CallOpenGL(
+      glGetActiveUniform, id_, static_cast<GLuint>(i), max_name_length, &length, &size, &type, name.data());
+    const std::string_view uniform_name(name.data(), static_cast<size_t>(length));
+    // Uniforms in blocks have no location.
+    const GLint location = glGetUniformLocation(id_, name.c_str());
+    if (location == -1) {
+      continue;
+    }
+    uniforms_.emplace(uniform_name, location);
+
+    // Arrays of basic types are reported once as "name[0]". Make "name" and every element addressable too.
+    const std::string_view array_suffix = "[0]";
+    if (uniform_name.ends_with(array_suffix)) {
+      const std::string_view base_name = uniform_name.substr(0, uniform_name.size() - array_suffix.size());
+      uniforms_.emplace(base_name, location);
+      for (GLint element = 1; element < size; ++element) {
+        const std::string element_name = std::string(base_name) + "[" + std::to_string(element) + "]";
+        const GLint element_location = glGetUniformLocation(id_, element_name.c_str());
+        if (element_location != -1) {
+          uniforms_.emplace(element_name, element_location);
+        }
+      }
+    }
+  }
+}
 
-void ShaderProgram::SetBool(const std::string& name, bool value) const
+void ShaderProgram::BindUniformBlocks() const
 {
-  CallOpenGL(glUniform1i, glGetUniformLocation(id_, name.c_str()), static_cast<int>(value));
+  for (const auto& block : UniformBlocks) {
+    const std::string name(block.name);
+    const GLuint block_index = glGetUniformBlockIndex(id_, name.c_str());
+    if (block_index != GL_INVALID_INDEX) {
+      CallOpenGL(glUniformBlockBinding, id_, block_index, block.binding);
+    }
+  }
 }
 
-void ShaderProgram::SetInt(const std::string& name, int value) const
+UniformHandle ShaderProgram::GetUniformHandle(std::string_view name) const
 {
-  CallOpenGL(glUniform1i, glGetUniformLocation(id_, name.c_str()), value);
+  const auto uniform = uniforms_.find(name);
+  if (uniform == uniforms_.end()) {
+    return UniformHandle{};
+  }
+  return UniformHandle{ uniform->second };
 }
 
-void ShaderProgram::SetFloat(const std::string& name, float value) const
+void ShaderProgram::Use() const { GLStateCache::Get().UseProgram(id_); }
+
+void ShaderProgram::SetBool(UniformHandle handle, bool value) const
 {
-  CallOpenGL(glUniform1f, glGetUniformLocation(id_, name.c_str()), value);
+  CallOpenGL(glUniform1i, handle.Location(), static_cast<int>(value));
 }
 
-void ShaderProgram::SetMat4(const std::string& name, float* first_element) const
+void ShaderProgram::SetInt(UniformHandle handle, int value) const { CallOpenGL(glUniform1i, handle.Location(), value); }
+
+void ShaderProgram::SetFloat(UniformHandle handle, float value) const
 {
-  CallOpenGL(glUniformMatrix4fv, glGetUniformLocation(id_, name.c_str()), 1, false, first_element);
+  CallOpenGL(glUniform1f, handle.Location(), value);
 }
 
-void ShaderProgram::SetVec3(const std::string& name, evie::vec3 vector) const
+void ShaderProgram::SetMat4(UniformHandle handle, const float* first_element) const
 {
-  CallOpenGL(glUniform3f, glGetUniformLocation(id_, name.c_str()), vector.x, vector.y, vector.z);
+  CallOpenGL(glUniformMatrix4fv, handle.Location(), 1, false, first_element);
 }
 
-bool ShaderProgram::HasVec3(const std::string& name) const
+void ShaderProgram::SetVec3(UniformHandle handle, evie::vec3 vector) const
 {
-  return glad_glGetUniformLocation(id_, name.c_str()) != -1;
+  CallOpenGL(glUniform3f, handle.Location(), vector.x, vector.y, vector.z);
 }
 
-void ShaderProgram::Destroy() const { CallOpenGL(glDeleteProgram, id_); }
+void ShaderProgram::Destroy() const
+{
+  CallOpenGL(glDeleteProgram, id_);
+  GLStateCache::Get().OnProgramDeleted(id_);
+}
 
 }// namespace evie
\ No newline at end of file
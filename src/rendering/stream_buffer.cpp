@@ -0,0 +1,96 @@
+#include "evie/stream_buffer.h"
+#include "evie/error.h"
+#include "evie/result.h"
+#include "rendering/debug.h"
+#include "rendering/gl_state_cache.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include "glad/glad.h"
+
+namespace evie {
+
+namespace {
+  // How long to block in glClientWaitSync before checking again. Only reached if the GPU is RegionCount frames behind.
+  constexpr GLuint64 FenceTimeoutNanoseconds = 1'000'000;
+}// namespace
+
+Error StreamBuffer::Initialise(unsigned int target, size_t region_size)
+{
+  target_ = target;
+  ring_ = StreamRingAllocator(region_size, RegionCount);
+  CallOpenGL(glGenBuffers, 1, &id_);
+  GLStateCache::Get().BindBuffer(target_, id_);
+  // GL 3.3 has no immutable storage so the buffer isn't persistently mapped. Instead each write maps its range
+  // unsynchronised and the fences stop the ring overwriting a region that is still being read.
+  CallOpenGL(glBufferData, target_, static_cast<GLsizeiptr>(region_size * RegionCount), nullptr, GL_STREAM_DRAW);
+  return Error::OK();
+}
+
+void StreamBuffer::BeginFrame()
+{
+  ring_.NextRegion();
+  auto& fence = fences_[ring_.CurrentRegion()];// NOLINT(*-constant-array-index)
+  if (fence == nullptr) {
+    return;
+  }
+  auto* sync = static_cast<GLsync>(fence);
+  GLenum status = glClientWaitSync(sync, 0, 0);
+  if (status == GL_TIMEOUT_EXPIRED) {
+    ++wait_count_;
+    while (status == GL_TIMEOUT_EXPIRED) {
+      status = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeoutNanoseconds);
+    }
+  }
+  CallOpenGL(glDeleteSync, sync);
+  fence = nullptr;
+}
+
+Result<size_t> StreamBuffer::Write(const void* data, size_t size, size_t alignment)
+{
+  const std::optional<size_t> offset = ring_.Allocate(size, alignment);
+  if (!offset.has_value()) {
+    return Error{ "Stream buffer region is full" };
+  }
+  GLStateCache::Get().BindBuffer(target_, id_);
+  // Unsynchronised because this region was fenced in BeginFrame() and nothing else this frame has written to the range.
+  void* mapped = glMapBufferRange(target_,
+    static_cast<GLintptr>(*offset),
+    static_cast<GLsizeiptr>(size),
+    GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+  if (mapped == nullptr) {
+    return Error{ "Failed to map stream buffer" };
+  }
+  std::memcpy(mapped, data, size);
+  if (glUnmapBuffer(target_) == GL_FALSE) {
+    return Error{ "Stream buffer contents were lost while mapped" };
+  }
+  return *offset;
+}
+
+void StreamBuffer::EndFrame()
+{
+  auto& fence = fences_[ring_.CurrentRegion()];// NOLINT(*-constant-array-index)
+  if (fence != nullptr) {
+    CallOpenGL(glDeleteSync, static_cast<GLsync>(fence));
+  }
+  fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void StreamBuffer::Destroy()
+{
+  for (auto& fence : fences_) {
+    if (fence != nullptr) {
+      CallOpenGL(glDeleteSync, static_cast<GLsync>(fence));
+      fence = nullptr;
+    }
+  }
+  if (id_ != 0) {
+    CallOpenGL(glDeleteBuffers, 1, &id_);
+    GLStateCache::Get().OnBufferDeleted(id_);
+    id_ = 0;
+  }
+}
+
+}// namespace evie
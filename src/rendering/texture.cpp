@@ -1,10 +1,15 @@
+#include <cstring>
 #include <iostream>
 #include <string>
 
+#include "evie/baked_texture.h"
 #include "evie/ids.h"
+#include "evie/logging.h"
 #include "evie/result.h"
 #include "evie/texture.h"
 #include "rendering/debug.h"
+#include "rendering/gl_state_cache.h"
+#include "rendering/pixel_store.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb/stb_image.h"
@@ -25,21 +30,70 @@ constexpr int GetOpenGLTextureWrapping(evie::TextureWrapping wrapping)
   }
 }
 
+// From EXT_texture_compression_s3tc, which the loader isn't generated with.
+constexpr GLenum CompressedRGBS3TCDXT1 = 0x83F0;
+constexpr GLenum CompressedRGBAS3TCDXT5 = 0x83F3;
+
+bool SupportsS3TC()
+{
+  static const bool supported = [] {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+      const auto* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));// NOLINT
+      if (name != nullptr && std::strcmp(name, "GL_EXT_texture_compression_s3tc") == 0) {
+        return true;
+      }
+    }
+    return false;
+  }();
+  return supported;
+}
+
 }// namespace
 
 namespace evie {
 
+void ImageFree::operator()(unsigned char* pixels) const { stbi_image_free(pixels); }
+
+Result<DecodedImage> DecodeImage(const std::string& filename, bool flip)
+{
+  // Set per thread so decodes on different workers don't change each other's setting.
+  stbi_set_flip_vertically_on_load_thread(flip ? 1 : 0);
+  DecodedImage image;
+  image.pixels.reset(stbi_load(filename.c_str(), &image.info.width, &image.info.height, &image.info.channels, 0));
+  if (!image.pixels) {
+    return Error{ "Failed to load texture" };
+  }
+  return image;
+}
+
 Error Texture2D::Initialise(const std::string& filename, bool flip, TextureWrapping wrapping)
 {
-  Error err = Error::OK();
-  if (flip) {
-    stbi_set_flip_vertically_on_load(1);
+  if (IsBakedTexture(filename)) {
+    Result<BakedTexture> baked = BakedTexture::Open(filename);
+    if (baked.Bad()) {
+      return baked.Error();
+    }
+    if (baked->IsFlipped() != flip) {
+      EV_WARN("Baked texture {} wasn't flipped the way it was asked for, rebake it with or without --flip", filename);
+    }
+    return Initialise(*baked, filename, wrapping);
+  }
+  Result<DecodedImage> image = DecodeImage(filename, flip);
+  if (image.Bad()) {
+    return image.Error();
   }
-  unsigned char* data = nullptr;
+  return Initialise(image->info, image->pixels.get(), filename, wrapping);
+}
 
-  data = stbi_load(filename.c_str(), &width_, &height_, &number_of_channels_, 0);
+Error Texture2D::Initialise(const ImageInfo& info,
+  const void* pixels,
+  const std::string& name,
+  TextureWrapping wrapping)
+{
   GLenum ogl_format = 0;
-  switch (number_of_channels_) {
+  switch (info.channels) {
   case 2:
     ogl_format = GL_RG;
     break;
@@ -52,41 +106,112 @@ Error Texture2D::Initialise(const std::string& filename, bool flip, TextureWrapp
   default:
     return Error{ "Unsupported conversion" };
   }
-  name_ = filename;
-
-  if (data) {
-    // Generate the texture
-    unsigned int id;
-    CallOpenGL(glGenTextures, 1, &id);
-    // Update the ID
-    id_ = TextureID(id);
-    // Bind the texture in openGL state machine
-    this->Bind();
-    // Set wrapping parameters. This is the default for now. Will extend the class
-    // in the future to allow customisation of this.
-    CallOpenGL(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GetOpenGLTextureWrapping(wrapping));
-    CallOpenGL(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GetOpenGLTextureWrapping(wrapping));
-    CallOpenGL(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    CallOpenGL(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-    // Generate the 2D Texture Image in openGL
-    CallOpenGL(glTexImage2D, GL_TEXTURE_2D, 0, ogl_format, width_, height_, 0, ogl_format, GL_UNSIGNED_BYTE, data);
-    // Get openGL to generate the MipMap of the texture for us.
-    CallOpenGL(glGenerateMipmap, GL_TEXTURE_2D);
-    stbi_image_free(data);
-  } else {
-    err = Error{ "Failed to load texture" };
+  name_ = name;
+  width_ = info.width;
+  height_ = info.height;
+  number_of_channels_ = info.channels;
+
+  CreateTexture(wrapping);
+  // Decoded rows are tightly packed, the default expects them padded to 4 bytes.
+  const ScopedUnpackAlignment unpack_alignment(1);
+  // Generate the 2D Texture Image in openGL
+  CallOpenGL(glTexImage2D, GL_TEXTURE_2D, 0, ogl_format, width_, height_, 0, ogl_format, GL_UNSIGNED_BYTE, pixels);
+  // Get openGL to generate the MipMap of the texture for us.
+  CallOpenGL(glGenerateMipmap, GL_TEXTURE_2D);
+  return Error::OK();
+}
+
+Error Texture2D::Initialise(const BakedTexture& baked, const std::string& name, TextureWrapping wrapping)
+{
+  GLenum ogl_format = 0;
+  switch (baked.GetFormat()) {
+  case BakedTextureFormat::RGB8:
+    ogl_format = GL_RGB;
+    number_of_channels_ = 3;
+    break;
+  case BakedTextureFormat::RGBA8:
+    ogl_format = GL_RGBA;
+    number_of_channels_ = 4;
+    break;
+  case BakedTextureFormat::BC1:
+    ogl_format = CompressedRGBS3TCDXT1;
+    number_of_channels_ = 3;
+    break;
+  case BakedTextureFormat::BC3:
+    ogl_format = CompressedRGBAS3TCDXT5;
+    number_of_channels_ = 4;
+    break;
+  }
+  if (IsCompressed(baked.GetFormat()) && !SupportsS3TC()) {
+    return Error{ "Baked texture is BC compressed but the driver doesn't support S3TC" };
   }
-  return err;
+  name_ = name;
+  width_ = static_cast<int>(baked.GetWidth());
+  height_ = static_cast<int>(baked.GetHeight());
+
+  CreateTexture(wrapping);
+  CallOpenGL(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(baked.GetMipCount() - 1));
+  const ScopedUnpackAlignment unpack_alignment(1);
+  // The level data is read straight out of the mapped file.
+  for (size_t level = 0; level < baked.GetMipCount(); ++level) {
+    const BakedMipLevel& mip = baked.GetMip(level);
+    const auto gl_level = static_cast<GLint>(level);
+    const auto width = static_cast<GLsizei>(mip.width);
+    const auto height = static_cast<GLsizei>(mip.height);
+    if (IsCompressed(baked.GetFormat())) {
+      CallOpenGL(glCompressedTexImage2D,
+        GL_TEXTURE_2D,
+        gl_level,
+        ogl_format,
+        width,
+        height,
+        0,
+        static_cast<GLsizei>(mip.size),
+        baked.GetMipData(level));
+    } else {
+      CallOpenGL(glTexImage2D,
+        GL_TEXTURE_2D,
+        gl_level,
+        static_cast<GLint>(ogl_format),
+        width,
+        height,
+        0,
+        ogl_format,
+        GL_UNSIGNED_BYTE,
+        baked.GetMipData(level));
+    }
+  }
+  return Error::OK();
+}
+
+void Texture2D::CreateTexture(TextureWrapping wrapping)
+{
+  // Generate the texture
+  unsigned int id;
+  CallOpenGL(glGenTextures, 1, &id);
+  // Update the ID
+  id_ = TextureID(id);
+  // Bind the texture in openGL state machine
+  this->Bind();
+  // Set wrapping parameters. This is the default for now. Will extend the class
+  // in the future to allow customisation of this.
+  CallOpenGL(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GetOpenGLTextureWrapping(wrapping));
+  CallOpenGL(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GetOpenGLTextureWrapping(wrapping));
+  CallOpenGL(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  CallOpenGL(glTexParameteri, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 }
 
 void Texture2D::SetSlot(int slot)
 {
-  CallOpenGL(glActiveTexture, GL_TEXTURE0 + slot);
+  GLStateCache::Get().ActiveTexture(GL_TEXTURE0 + slot);
   this->Bind();
 }
 
-void Texture2D::Bind() { CallOpenGL(glBindTexture, GL_TEXTURE_2D, id_.Get()); }
+void Texture2D::Bind() { GLStateCache::Get().BindTexture(GL_TEXTURE_2D, id_.Get()); }
 
-void Texture2D::Destroy() { CallOpenGL(glDeleteTextures, 1, &id_.Get()); }
+void Texture2D::Destroy()
+{
+  CallOpenGL(glDeleteTextures, 1, &id_.Get());
+  GLStateCache::Get().OnTextureDeleted(id_.Get());
+}
 }// namespace evie
@@ -0,0 +1,210 @@
+#include "evie/texture_array.h"
+#include "evie/logging.h"
+#include "rendering/debug.h"
+#include "rendering/gl_state_cache.h"
+#include "rendering/pixel_store.h"
+
+#include <algorithm>
+
+namespace evie {
+
+namespace {
+struct OpenGLFormat
+{
+  GLint internal_format{ 0 };
+  GLenum format{ 0 };
+};
+
+Result<OpenGLFormat> GetOpenGLFormat(int channels)
+{
+  switch (channels) {
+  case 2:
+    return OpenGLFormat{ GL_RG8, GL_RG };
+  case 3:
+    return OpenGLFormat{ GL_RGB8, GL_RGB };
+  case 4:
+    return OpenGLFormat{ GL_RGBA8, GL_RGBA };
+  default:
+    return Error{ "Unsupported conversion" };
+  }
+}
+}// namespace
+
+TextureLayerAllocator::Allocation TextureLayerAllocator::Allocate(const TextureArrayFormat& format)
+{
+  for (size_t i = 0; i < arrays_.size(); ++i) {
+    ArrayState& array = arrays_[i];
+    if (array.format != format) {
+      continue;
+    }
+    if (!array.free_layers.empty()) {
+      const uint32_t layer = array.free_layers.back();
+      array.free_layers.pop_back();
+      return { i, layer, false };
+    }
+    if (array.used < layers_per_array_) {
+      return { i, array.used++, false };
+    }
+  }
+  arrays_.push_back({ format, 1, {} });
+  return { arrays_.size() - 1, 0, true };
+}
+
+void TextureLayerAllocator::Free(size_t array, uint32_t layer) { arrays_[array].free_layers.push_back(layer); }
+
+Error TextureArray::Initialise(const TextureArrayFormat& format, uint32_t layers)
+{
+  Result<OpenGLFormat> gl_format = GetOpenGLFormat(format.channels);
+  if (gl_format.Bad()) {
+    return gl_format.Error();
+  }
+  GLint max_layers = 0;
+  CallOpenGL(glGetIntegerv, GL_MAX_ARRAY_TEXTURE_LAYERS, &max_layers);
+  if (layers == 0 || layers > static_cast<uint32_t>(max_layers)) {
+    return Error{ "Texture array has more layers than the driver supports" };
+  }
+  format_ = format;
+  layers_ = layers;
+
+  unsigned int id = 0;
+  CallOpenGL(glGenTextures, 1, &id);
+  id_ = TextureID(id);
+  Bind();
+  CallOpenGL(glTexParameteri, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  CallOpenGL(glTexParameteri, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  // Sample the mipmaps SetSlot() generates when minified, walls and floors seen at a distance shimmer without them.
+  CallOpenGL(glTexParameteri, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+  CallOpenGL(glTexParameteri, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  CallOpenGL(glTexImage3D,
+    GL_TEXTURE_2D_ARRAY,
+    0,
+    gl_format->internal_format,
+    format.width,
+    format.height,
+    static_cast<GLsizei>(layers),
+    0,
+    gl_format->format,
+    GL_UNSIGNED_BYTE,
+    nullptr);
+  return Error::OK();
+}
+
+Error TextureArray::Upload(uint32_t layer, const void* pixels)
+{
+  if (layer >= layers_) {
+    return Error{ "Texture array layer is out of range" };
+  }
+  Result<OpenGLFormat> gl_format = GetOpenGLFormat(format_.channels);
+  if (gl_format.Bad()) {
+    return gl_format.Error();
+  }
+  Bind();
+  // Decoded rows are tightly packed, the default expects them padded to 4 bytes.
+  const ScopedUnpackAlignment unpack_alignment(1);
+  CallOpenGL(glTexSubImage3D,
+    GL_TEXTURE_2D_ARRAY,
+    0,
+    0,
+    0,
+    static_cast<GLint>(layer),
+    format_.width,
+    format_.height,
+    1,
+    gl_format->format,
+    GL_UNSIGNED_BYTE,
+    pixels);
+  // Mipmaps cover every layer, so several uploads in a frame only regenerate them once.
+  mipmaps_dirty_ = true;
+  return Error::OK();
+}
+
+void TextureArray::SetSlot(int slot)
+{
+  GLStateCache::Get().ActiveTexture(GL_TEXTURE0 + slot);
+  Bind();
+  if (mipmaps_dirty_) {
+    CallOpenGL(glGenerateMipmap, GL_TEXTURE_2D_ARRAY);
+    mipmaps_dirty_ = false;
+  }
+}
+
+void TextureArray::Bind() { GLStateCache::Get().BindTexture(GL_TEXTURE_2D_ARRAY, id_.Get()); }
+
+void TextureArray::Destroy()
+{
+  CallOpenGL(glDeleteTextures, 1, &id_.Get());
+  GLStateCache::Get().OnTextureDeleted(id_.Get());
+}
+
+Result<TextureLayer> TextureArrayManager::Load(const std::string& path, bool flip)
+{
+  if (auto it = loaded_.find(path); it != loaded_.end()) {
+    return it->second;
+  }
+  Result<DecodedImage> image = DecodeImage(path, flip);
+  if (image.Bad()) {
+    return image.Error();
+  }
+  Result<TextureLayer> layer = Add(image->info, image->pixels.get());
+  if (layer.Good()) {
+    loaded_.emplace(path, *layer);
+  }
+  return layer;
+}
+
+Result<TextureLayer> TextureArrayManager::Add(const ImageInfo& info, const void* pixels)
+{
+  if (info.width <= 0 || info.height <= 0 || GetOpenGLFormat(info.channels).Bad()) {
+    return Error{ "Texture can't be stored in a texture array" };
+  }
+  const TextureArrayFormat format{ info.width, info.height, info.channels };
+  const TextureLayerAllocator::Allocation allocation = allocator_.Allocate(format);
+  if (allocation.new_array) {
+    // Keep the allocator and arrays in step.
+    arrays_.push_back(std::make_unique<TextureArray>());
+  }
+  TextureArray& array = *arrays_[allocation.array];
+  // An array that failed to initialise is retried by the next texture of its format rather than left unusable.
+  if (array.GetID().Get() == 0) {
+    if (Error err = array.Initialise(format, layers_per_array_); err.Bad()) {
+      allocator_.Free(allocation.array, allocation.layer);
+      return err;
+    }
+  }
+  if (Error err = array.Upload(allocation.layer, pixels); err.Bad()) {
+    allocator_.Free(allocation.array, allocation.layer);
+    return err;
+  }
+  return TextureLayer{ &array, allocation.layer };
+}
+
+void TextureArrayManager::Remove(const TextureLayer& layer)
+{
+  const auto it = std::find_if(
+    arrays_.begin(), arrays_.end(), [&](const auto& array) { return array.get() == layer.array; });
+  if (it == arrays_.end()) {
+    EV_WARN("Removing a layer from a texture array this manager doesn't own");
+    return;
+  }
+  allocator_.Free(static_cast<size_t>(it - arrays_.begin()), layer.layer);
+}
+
+void TextureArrayManager::Unload(const std::string& path)
+{
+  if (auto it = loaded_.find(path); it != loaded_.end()) {
+    Remove(it->second);
+    loaded_.erase(it);
+  }
+}
+
+void TextureArrayManager::Destroy()
+{
+  for (auto& array : arrays_) {
+    array->Destroy();
+  }
+  arrays_.clear();
+  loaded_.clear();
+  allocator_ = TextureLayerAllocator(layers_per_array_);
+}
+
+}// namespace evie
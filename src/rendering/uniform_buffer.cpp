@@ -0,0 +1,45 @@
+#include "evie/uniform_buffer.h"
+#include "evie/error.h"
+#include "rendering/debug.h"
+#include "rendering/gl_state_cache.h"
+
+#include "glad/glad.h"
+
+namespace evie {
+
+Error UniformBuffer::Initialise(size_t size, unsigned int binding)
+{
+  GLint max_bindings{ 0 };
+  CallOpenGL(glGetIntegerv, GL_MAX_UNIFORM_BUFFER_BINDINGS, &max_bindings);
+  if (binding >= static_cast<unsigned int>(max_bindings)) {
+    return Error{ "Uniform buffer binding point is larger than GL_MAX_UNIFORM_BUFFER_BINDINGS" };
+  }
+
+  CallOpenGL(glGenBuffers, 1, &id_);
+  binding_ = binding;
+  size_ = size;
+  GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, id_);
+  CallOpenGL(glBufferData, GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_DRAW);
+  // The binding point keeps the buffer attached so nothing needs binding again when drawing. This also binds the
+  // generic GL_UNIFORM_BUFFER target to the same buffer which is what the state cache already has.
+  CallOpenGL(glBindBufferBase, GL_UNIFORM_BUFFER, binding_, id_);
+  return Error::OK();
+}
+
+void UniformBuffer::Update(const void* data, size_t size, size_t offset) const
+{
+  GLStateCache::Get().BindBuffer(GL_UNIFORM_BUFFER, id_);
+  CallOpenGL(glBufferSubData, GL_UNIFORM_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+}
+
+void UniformBuffer::Destroy()
+{
+  if (id_ == 0) {
+    return;
+  }
+  CallOpenGL(glDeleteBuffers, 1, &id_);
+  GLStateCache::Get().OnBufferDeleted(id_);
+  id_ = 0;
+}
+
+}// namespace evie
@@ -3,6 +3,7 @@
 #include "evie/input_manager.h"
 #include "evie/key_events.h"
 #include "evie/mouse_events.h"
+#include "evie/profiler.h"
 #include "window/layer_queue.h"
 #include <memory>
 
@@ -16,6 +17,7 @@ EventManager::~EventManager() {}
 
 void EventManager::OnEvent(Event& event)
 {
+  EV_PROFILE_SCOPE("EventManager::OnEvent");
   // The input manager needs visibility on all events to store the state of the event.
   input_manager_->RegisterInput(event);
 
@@ -0,0 +1,39 @@
+#include "evie/fixed_timestep.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace evie {
+
+FixedTimestep::FixedTimestep(double tick_rate, uint32_t max_steps_per_frame)
+  : step_(1.0 / tick_rate), max_steps_per_frame_(std::max(max_steps_per_frame, 1U))
+{}
+
+uint32_t FixedTimestep::Advance(double frame_seconds)
+{
+  accumulator_ += std::max(frame_seconds, 0.0);
+  uint32_t steps = 0;
+  while (accumulator_ >= step_ && steps < max_steps_per_frame_) {
+    accumulator_ -= step_;
+    ++steps;
+  }
+  // Keep what's left of a partial step so alpha still means something, drop the whole steps that didn't fit.
+  if (accumulator_ >= step_) {
+    const double kept = std::fmod(accumulator_, step_);
+    dropped_ += accumulator_ - kept;
+    accumulator_ = kept;
+  }
+  ticks_ += steps;
+  return steps;
+}
+
+void FixedTimestep::SetTickRate(double tick_rate) { step_ = 1.0 / tick_rate; }
+
+void FixedTimestep::SetMaxStepsPerFrame(uint32_t max_steps_per_frame)
+{
+  max_steps_per_frame_ = std::max(max_steps_per_frame, 1U);
+}
+
+float FixedTimestep::GetAlpha() const { return static_cast<float>(std::clamp(accumulator_ / step_, 0.0, 1.0)); }
+
+}// namespace evie
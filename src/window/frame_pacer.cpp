@@ -0,0 +1,110 @@
+#include "evie/frame_pacer.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace evie {
+
+namespace {
+// Bounds on how early to stop sleeping. Below the lower bound the scheduler can't be relied on, above the upper the
+// spin costs more than an uncapped frame would.
+constexpr FramePacer::Clock::duration MinSpinMargin = std::chrono::microseconds(200);
+constexpr FramePacer::Clock::duration MaxSpinMargin = std::chrono::milliseconds(4);
+}// namespace
+
+void FrameTimeHistory::Push(float seconds)
+{
+  if (times_.empty()) {
+    return;
+  }
+  times_[next_] = seconds;
+  next_ = (next_ + 1) % times_.size();
+  size_ = std::min(size_ + 1, times_.size());
+}
+
+void FrameTimeHistory::Clear()
+{
+  next_ = 0;
+  size_ = 0;
+}
+
+float FrameTimeHistory::operator[](size_t index) const
+{
+  // Also covers a capacity of zero, which never holds a frame.
+  if (index >= size_) {
+    return 0.0F;
+  }
+  const size_t oldest = (next_ + times_.size() - size_) % times_.size();
+  return times_[(oldest + index) % times_.size()];
+}
+
+float FrameTimeHistory::Average() const
+{
+  if (size_ == 0) {
+    return 0.0F;
+  }
+  float total = 0.0F;
+  for (size_t i = 0; i < size_; ++i) {
+    total += (*this)[i];
+  }
+  return total / static_cast<float>(size_);
+}
+
+float FrameTimeHistory::Max() const
+{
+  float max = 0.0F;
+  for (size_t i = 0; i < size_; ++i) {
+    max = std::max(max, (*this)[i]);
+  }
+  return max;
+}
+
+float FrameTimeHistory::Percentile(float fraction) const
+{
+  if (size_ == 0) {
+    return 0.0F;
+  }
+  std::vector<float> sorted(size_);
+  for (size_t i = 0; i < size_; ++i) {
+    sorted[i] = (*this)[i];
+  }
+  const auto rank = static_cast<size_t>(std::clamp(fraction, 0.0F, 1.0F) * static_cast<float>(size_ - 1) + 0.5F);
+  std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(rank), sorted.end());
+  return sorted[rank];
+}
+
+void FramePacer::SetTargetFrameRate(double frames_per_second)
+{
+  target_frame_rate_ = std::max(frames_per_second, 0.0);
+  period_ = target_frame_rate_ > 0.0
+              ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / target_frame_rate_))
+              : Clock::duration{ 0 };
+}
+
+void FramePacer::EndFrame()
+{
+  if (last_frame_ && period_ > Clock::duration{ 0 }) {
+    WaitUntil(*last_frame_ + period_);
+  }
+  const Clock::time_point now = Clock::now();
+  if (last_frame_) {
+    history_.Push(std::chrono::duration<float>(now - *last_frame_).count());
+  }
+  last_frame_ = now;
+}
+
+void FramePacer::WaitUntil(Clock::time_point deadline)
+{
+  const Clock::time_point wake = deadline - spin_margin_;
+  if (Clock::now() < wake) {
+    std::this_thread::sleep_until(wake);
+    // Wake earlier straight away after a late sleep, and creep back towards sleeping longer while sleeps are punctual.
+    const Clock::duration overshoot = Clock::now() - wake;
+    spin_margin_ = std::clamp(std::max(overshoot * 2, spin_margin_ - spin_margin_ / 16), MinSpinMargin, MaxSpinMargin);
+  }
+  while (Clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+}
+
+}// namespace evie
@@ -31,7 +31,10 @@ namespace {
     WindowDimensions dimensions{ width, height };
     static_cast<GLFWWindow*>(glfwGetWindowUserPointer(window))->UpdateWindowDimensions(dimensions);
     EV_INFO("Resize {} {}", width, height);
-    glViewport(0, 0, width, height);
+    // With a render thread the context is current there instead, and it sets the viewport each frame.
+    if (glfwGetCurrentContext() == window) {
+      glViewport(0, 0, width, height);
+    }
   }
 
   EventManager* GetEventManager(GLFWwindow* window)
@@ -171,6 +174,10 @@ Error GLFWWindow::Initialise(const WindowProperties& props)
 #ifdef EVIE_PLATFORM_APPLE
   glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
+#ifndef NDEBUG
+  // Debug contexts are required for the driver to report through KHR_debug.
+  glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
 
   window_ = glfwCreateWindow(
     properties_.dimensions.width, properties_.dimensions.height, properties_.name.c_str(), nullptr, nullptr);
@@ -188,7 +195,7 @@ Error GLFWWindow::Initialise(const WindowProperties& props)
   glViewport(0, 0, properties_.dimensions.width, properties_.dimensions.height);
   glfwSetFramebufferSizeCallback(window_, framebuffer_size_callback);
 
-  SetVSync(true);
+  SetVSync(properties_.vsync);
   // Setup the user window pointer
   glfwSetWindowUserPointer(window_, static_cast<void*>(this));
   SetupInputCallbacks();
@@ -211,6 +218,10 @@ void GLFWWindow::PollEvents() { glfwPollEvents(); }
 
 void GLFWWindow::SwapBuffers() { glfwSwapBuffers(window_); }
 
+void GLFWWindow::MakeContextCurrent() { glfwMakeContextCurrent(window_); }
+
+void GLFWWindow::ReleaseContext() { glfwMakeContextCurrent(nullptr); }
+
 Error GLFWWindow::RegisterEventManager(EventManager& event_manager)
 {
   if (event_manager_ == nullptr) {
@@ -221,14 +232,26 @@ Error GLFWWindow::RegisterEventManager(EventManager& event_manager)
   return Error::OK();
 };
 
-void GLFWWindow::SetVSync(bool enabled)
+void GLFWWindow::SetVSync(VSyncMode mode)
 {
-  if (enabled) {
-    glfwSwapInterval(1);
-  } else {
+  if (mode == VSyncMode::Adaptive && glfwExtensionSupported("WGL_EXT_swap_control_tear") == GLFW_FALSE
+      && glfwExtensionSupported("GLX_EXT_swap_control_tear") == GLFW_FALSE) {
+    EV_WARN("Adaptive vsync isn't supported, using vsync instead");
+    mode = VSyncMode::On;
+  }
+  switch (mode) {
+  case VSyncMode::Off:
     glfwSwapInterval(0);
+    break;
+  case VSyncMode::On:
+    glfwSwapInterval(1);
+    break;
+  case VSyncMode::Adaptive:
+    // A negative interval is how swap_control_tear asks for late swaps to go straight through.
+    glfwSwapInterval(-1);
+    break;
   }
-  vsync_enabled_ = enabled;
+  properties_.vsync = mode;
 }
 
 void* GLFWWindow::GetNativeWindow() { return static_cast<void*>(window_); }
@@ -25,10 +25,12 @@ public:
   void Destroy() override;
   void PollEvents() override;
   void SwapBuffers() override;
+  void MakeContextCurrent() override;
+  void ReleaseContext() override;
   [[nodiscard]] Error RegisterEventManager(EventManager& event_manager) override;
   void* GetNativeWindow() override;
   EventManager* GetEventManager();
-  void SetVSync(bool enabled);
+  void SetVSync(VSyncMode mode) override;
   void DisableCursor() override;
   void EnableCursor() override;
 
@@ -42,7 +44,6 @@ private:
   GLFWwindow* window_{ nullptr };
   WindowProperties properties_;
   EventManager* event_manager_{ nullptr };
-  bool vsync_enabled_{ false };
 };
 
 }// namespace evie
@@ -0,0 +1,55 @@
+#ifndef EVIE_TEST_BAKED_FILE_TESTS_H_
+#define EVIE_TEST_BAKED_FILE_TESTS_H_
+
+#include <doctest/doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// NOLINTBEGIN
+
+// Helpers shared by the tests of the baked file formats.
+
+inline std::string WriteTempFile(const std::string& name, const std::vector<unsigned char>& bytes)
+{
+  const std::string path = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  return path;
+}
+
+/**
+ * Subcases that every baked format has to reject: a bad magic, a file cut short and a file that isn't there. Call it
+ * from a TEST_CASE with a good file and the format's Open().
+ *
+ * @param extension Used for the temporary files, e.g. ".evtex".
+ */
+template<typename Open>
+void CheckCorruptFilesAreRejected(const std::vector<unsigned char>& bytes, const std::string& extension, Open open)
+{
+  SUBCASE("Bad magic")
+  {
+    std::vector<unsigned char> corrupt = bytes;
+    corrupt[0] = 'X';
+    const std::string path = WriteTempFile("baked_magic" + extension, corrupt);
+    CHECK(open(path).Bad());
+    std::filesystem::remove(path);
+  }
+  SUBCASE("Truncated")
+  {
+    std::vector<unsigned char> corrupt(bytes.begin(), bytes.end() - 1);
+    const std::string path = WriteTempFile("baked_truncated" + extension, corrupt);
+    CHECK(open(path).Bad());
+    std::filesystem::remove(path);
+  }
+  SUBCASE("Missing")
+  {
+    CHECK(open("does_not_exist" + extension).Bad());
+  }
+}
+
+// NOLINTEND
+
+#endif// !EVIE_TEST_BAKED_FILE_TESTS_H_
@@ -0,0 +1,108 @@
+#include <doctest/doctest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "baked_file_tests.h"
+#include "evie/baked_mesh.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+namespace {
+BakedVertex MakeVertex(float x, float y, float z) { return BakedVertex{ { x, y, z }, { 0.0F, 0.0F, 1.0F }, { x, y } }; }
+
+// Two submeshes, a triangle and a quad, sharing one textured material.
+MeshSource MakeSource()
+{
+  MeshSource source;
+  source.submeshes.push_back(
+    { { MakeVertex(0, 0, 0), MakeVertex(1, 0, 0), MakeVertex(0, 1, 0) }, { 0, 1, 2 }, 0 });
+  source.submeshes.push_back(
+    { { MakeVertex(-2, -2, 1), MakeVertex(2, -2, 1), MakeVertex(2, 2, 1), MakeVertex(-2, 2, 1) },
+      { 0, 1, 2, 0, 2, 3 },
+      0 });
+  source.materials.push_back(
+    { 32.0F, { { TextureType::Diffuse, "diffuse.png" }, { TextureType::Specular, "specular.png" } } });
+  return source;
+}
+}// namespace
+
+TEST_CASE("Baked meshes round trip through a file")
+{
+  Result<std::vector<unsigned char>> bytes = BakeMesh(MakeSource());
+  REQUIRE(bytes.Good());
+  const std::string path = WriteTempFile("baked_mesh_tests.evmesh", *bytes);
+  CHECK(IsBakedMesh(path));
+
+  {
+    Result<BakedMesh> mesh = BakedMesh::Open(path);
+    REQUIRE(mesh.Good());
+    CHECK(mesh->GetHeader().vertex_count == 7);
+    CHECK(mesh->GetHeader().index_count == 9);
+
+    REQUIRE(mesh->GetSubmeshes().size() == 2);
+    const BakedSubmesh& quad = mesh->GetSubmeshes()[1];
+    CHECK(quad.base_vertex == 3);
+    CHECK(quad.first_index == 3);
+    // Indices stay relative to the submesh so each one can be uploaded on its own.
+    const auto indices = mesh->GetIndices(quad);
+    CHECK(std::vector<uint32_t>(indices.begin(), indices.end()) == std::vector<uint32_t>{ 0, 1, 2, 0, 2, 3 });
+    CHECK(mesh->GetVertices(quad)[2].position == std::array<float, 3>{ 2.0F, 2.0F, 1.0F });
+
+    REQUIRE(mesh->GetMaterials().size() == 1);
+    CHECK(mesh->GetMaterials()[0].shininess == 32.0F);
+    REQUIRE(mesh->GetTextures().size() == 2);
+    CHECK(mesh->GetTextures()[1].type == TextureType::Specular);
+    CHECK(mesh->GetTexturePath(mesh->GetTextures()[0]) == "diffuse.png");
+    CHECK(mesh->GetTexturePath(mesh->GetTextures()[1]) == "specular.png");
+  }
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Meshes that can't be drawn aren't baked")
+{
+  SUBCASE("No triangles")
+  {
+    MeshSource source;
+    source.materials.emplace_back();
+    CHECK(BakeMesh(source).Bad());
+  }
+  SUBCASE("Missing material")
+  {
+    MeshSource source = MakeSource();
+    source.submeshes[0].material = 3;
+    CHECK(BakeMesh(source).Bad());
+  }
+  SUBCASE("Index out of range")
+  {
+    MeshSource source = MakeSource();
+    source.submeshes[0].indices[2] = 3;
+    CHECK(BakeMesh(source).Bad());
+  }
+}
+
+TEST_CASE("Corrupt baked meshes are rejected")
+{
+  Result<std::vector<unsigned char>> bytes = BakeMesh(MakeSource());
+  REQUIRE(bytes.Good());
+
+  CheckCorruptFilesAreRejected(*bytes, std::string(BakedMeshExtension), BakedMesh::Open);
+
+  SUBCASE("Index out of range")
+  {
+    std::vector<unsigned char> corrupt = *bytes;
+    // The first index sits right after the 7 vertices, 16 byte aligned.
+    const size_t indices = (sizeof(BakedMeshHeader) + 15) / 16 * 16 + 7 * sizeof(BakedVertex);
+    const uint32_t bad_index = 100;
+    std::memcpy(corrupt.data() + (indices + 15) / 16 * 16, &bad_index, sizeof(bad_index));
+    const std::string path = WriteTempFile("baked_mesh_index.evmesh", corrupt);
+    CHECK(BakedMesh::Open(path).Bad());
+    std::filesystem::remove(path);
+  }
+}
+
+// NOLINTEND
@@ -0,0 +1,191 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "baked_file_tests.h"
+#include "evie/baked_texture.h"
+#include "evie/mapped_file.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+namespace {
+// Decode one channel of a BC1 colour block for pixel i, enough to check the encoder.
+std::array<int, 3> DecodeBC1Pixel(const unsigned char* block, int i)
+{
+  const auto unpack = [](int packed) {
+    const int r = (packed >> 11) & 0x1F;
+    const int g = (packed >> 5) & 0x3F;
+    const int b = packed & 0x1F;
+    return std::array<int, 3>{ (r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2) };
+  };
+  const int colour0 = block[0] | (block[1] << 8);
+  const int colour1 = block[2] | (block[3] << 8);
+  const uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+  const auto c0 = unpack(colour0);
+  const auto c1 = unpack(colour1);
+  std::array<int, 3> out{};
+  for (int c = 0; c < 3; ++c) {
+    switch ((indices >> (i * 2)) & 3) {
+    case 0:
+      out[c] = c0[c];
+      break;
+    case 1:
+      out[c] = c1[c];
+      break;
+    case 2:
+      out[c] = (2 * c0[c] + c1[c]) / 3;
+      break;
+    default:
+      out[c] = (c0[c] + 2 * c1[c]) / 3;
+      break;
+    }
+  }
+  return out;
+}
+}// namespace
+
+TEST_CASE("A solid colour block compresses exactly")
+{
+  std::array<unsigned char, 64> pixels{};
+  for (size_t i = 0; i < 16; ++i) {
+    // Representable in 565 so there's no quantisation error.
+    pixels[i * 4] = 255;
+    pixels[i * 4 + 1] = 0;
+    pixels[i * 4 + 2] = 255;
+    pixels[i * 4 + 3] = 255;
+  }
+  std::array<unsigned char, 8> block{};
+  CompressBC1Block(pixels.data(), block.data());
+  for (int i = 0; i < 16; ++i) {
+    CHECK(DecodeBC1Pixel(block.data(), i) == std::array<int, 3>{ 255, 0, 255 });
+  }
+}
+
+TEST_CASE("A gradient block stays close to the source")
+{
+  std::array<unsigned char, 64> pixels{};
+  for (int i = 0; i < 16; ++i) {
+    const auto value = static_cast<unsigned char>(i * 16);
+    pixels[i * 4] = value;
+    pixels[i * 4 + 1] = value;
+    pixels[i * 4 + 2] = value;
+    pixels[i * 4 + 3] = 255;
+  }
+  std::array<unsigned char, 8> block{};
+  CompressBC1Block(pixels.data(), block.data());
+  // Four levels across 0..240 can be at most a sixth of the range out, plus rounding.
+  for (int i = 0; i < 16; ++i) {
+    const auto decoded = DecodeBC1Pixel(block.data(), i);
+    for (int c = 0; c < 3; ++c) {
+      CHECK(std::abs(decoded[c] - i * 16) <= 44);
+    }
+  }
+}
+
+TEST_CASE("BC3 keeps the alpha range")
+{
+  std::array<unsigned char, 64> pixels{};
+  for (int i = 0; i < 16; ++i) {
+    pixels[i * 4 + 3] = i < 8 ? 0 : 255;
+  }
+  std::array<unsigned char, 16> block{};
+  CompressBC3Block(pixels.data(), block.data());
+  CHECK(block[0] == 255);
+  CHECK(block[1] == 0);
+  // Opaque pixels use alpha0 (index 0) and transparent ones alpha1 (index 1).
+  uint64_t indices = 0;
+  for (int i = 0; i < 6; ++i) {
+    indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+  }
+  for (int i = 0; i < 16; ++i) {
+    CHECK(((indices >> (i * 3)) & 7) == (i < 8 ? 1U : 0U));
+  }
+}
+
+TEST_CASE("Level sizes")
+{
+  CHECK(BakedMipSize(BakedTextureFormat::RGB8, 3, 2) == 18);
+  CHECK(BakedMipSize(BakedTextureFormat::RGBA8, 3, 2) == 24);
+  // Partial blocks still take a whole block.
+  CHECK(BakedMipSize(BakedTextureFormat::BC1, 1, 1) == 8);
+  CHECK(BakedMipSize(BakedTextureFormat::BC1, 8, 5) == 32);
+  CHECK(BakedMipSize(BakedTextureFormat::BC3, 8, 8) == 64);
+}
+
+TEST_CASE("Baked textures round trip through a file")
+{
+  // 4x2 RGB image, left half black and right half white.
+  const std::vector<unsigned char> pixels = { 0, 0, 0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0, 0, 0, 255,
+    255, 255, 255, 255, 255 };
+  Result<std::vector<unsigned char>> bytes =
+    BakeTexture(ImageInfo{ 4, 2, 3 }, pixels.data(), BakedTextureFormat::RGBA8);
+  REQUIRE(bytes.Good());
+  const std::string path = WriteTempFile("baked_texture_tests.evtex", *bytes);
+  CHECK(IsBakedTexture(path));
+
+  {
+    Result<BakedTexture> baked = BakedTexture::Open(path);
+    REQUIRE(baked.Good());
+    CHECK(baked->GetFormat() == BakedTextureFormat::RGBA8);
+    CHECK_FALSE(baked->IsFlipped());
+    CHECK(baked->GetWidth() == 4);
+    CHECK(baked->GetHeight() == 2);
+    // 4x2, 2x1, 1x1
+    REQUIRE(baked->GetMipCount() == 3);
+    CHECK(baked->GetMip(1).width == 2);
+    CHECK(baked->GetMip(1).height == 1);
+    CHECK(baked->GetMip(2).width == 1);
+    CHECK(baked->GetMip(2).height == 1);
+
+    // Level 1 averages each 2x2 quarter so stays black then white, level 2 is the mid grey.
+    const unsigned char* level1 = baked->GetMipData(1);
+    CHECK(level1[0] == 0);
+    CHECK(level1[3] == 255);
+    CHECK(level1[4] == 255);
+    const unsigned char* level2 = baked->GetMipData(2);
+    CHECK(level2[0] == 128);
+    CHECK(level2[3] == 255);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Baked textures remember whether they were flipped")
+{
+  const std::vector<unsigned char> pixels(4, 255);
+  Result<std::vector<unsigned char>> bytes =
+    BakeTexture(ImageInfo{ 1, 1, 4 }, pixels.data(), BakedTextureFormat::RGBA8, true);
+  REQUIRE(bytes.Good());
+  const std::string path = WriteTempFile("baked_texture_flipped.evtex", *bytes);
+  {
+    Result<BakedTexture> baked = BakedTexture::Open(path);
+    REQUIRE(baked.Good());
+    CHECK(baked->IsFlipped());
+  }
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Corrupt baked textures are rejected")
+{
+  const std::vector<unsigned char> pixels(16 * 16 * 4, 200);
+  Result<std::vector<unsigned char>> bytes =
+    BakeTexture(ImageInfo{ 16, 16, 4 }, pixels.data(), BakedTextureFormat::BC3);
+  REQUIRE(bytes.Good());
+  CheckCorruptFilesAreRejected(*bytes, std::string(BakedTextureExtension), BakedTexture::Open);
+}
+
+TEST_CASE("Images without pixels can't be baked")
+{
+  CHECK(BakeTexture(ImageInfo{ 0, 0, 4 }, nullptr, BakedTextureFormat::RGBA8).Bad());
+  const std::vector<unsigned char> pixels(4, 0);
+  CHECK(BakeTexture(ImageInfo{ 1, 1, 5 }, pixels.data(), BakedTextureFormat::RGBA8).Bad());
+}
+
+// NOLINTEND
@@ -1,5 +1,9 @@
 #include "doctest/doctest.h"
 
+#include <chrono>
+#include <thread>
+#include <typeinfo>
+
 #include "evie/ecs/ecs_controller.hpp"
 
 using namespace evie;
@@ -146,4 +150,46 @@ TEST_CASE("Test ECS Controller")
 
   REQUIRE_EQ(ecs.EntityCount(), 0);
 }
+
+TEST_CASE("Systems and component types can be walked without knowing their types")
+{
+  struct Position
+  {
+    float x;
+  };
+  struct Velocity
+  {
+    float x;
+  };
+  struct SlowSystem : public System
+  {
+    void Update(const float& delta_time) override
+    {
+      std::ignore = delta_time;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  };
+  ECSController ecs;
+  auto position_id = ecs.RegisterComponent<Position>();
+  std::ignore = ecs.RegisterComponent<Velocity>();
+  SystemSignature signature;
+  signature.SetComponent(position_id);
+  auto system_id = ecs.RegisterSystem<SlowSystem>(signature);
+
+  auto entity = ecs.CreateEntity();
+  REQUIRE(entity);
+  REQUIRE(entity->AddComponent(position_id, { 1.0F }));
+
+  REQUIRE_EQ(ecs.ComponentTypeCount(), 2);
+  CHECK_EQ(ecs.GetComponentArray(0).Size(), 1);
+  CHECK_EQ(ecs.GetComponentArray(1).Size(), 0);
+  CHECK(ecs.GetComponentArray(0).GetType() == typeid(Position));
+  CHECK(ecs.GetComponentArray(1).GetType() == typeid(Velocity));
+
+  REQUIRE_EQ(ecs.SystemCount(), 1);
+  CHECK_EQ(ecs.GetSystemAt(0).GetLastUpdateTime(), 0);
+  ecs.GetSystem(system_id).UpdateSystem(0.0F);
+  CHECK(ecs.GetSystemAt(0).GetLastUpdateTime() >= 1'000'000);
+  CHECK(typeid(ecs.GetSystemAt(0)) == typeid(SlowSystem));
+}
 // NOLINTEND
\ No newline at end of file
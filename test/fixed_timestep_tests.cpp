@@ -0,0 +1,64 @@
+#include <doctest/doctest.h>
+
+#include "evie/fixed_timestep.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+TEST_CASE("Time carries over between frames")
+{
+  FixedTimestep timestep(10.0);
+  CHECK(timestep.Advance(0.05) == 0);
+  CHECK(timestep.GetAlpha() == doctest::Approx(0.5));
+  CHECK(timestep.Advance(0.06) == 1);
+  CHECK(timestep.GetAlpha() == doctest::Approx(0.1));
+  CHECK(timestep.Advance(0.25) == 2);
+  CHECK(timestep.GetAlpha() == doctest::Approx(0.6));
+  CHECK(timestep.GetTickCount() == 3);
+  CHECK(timestep.GetDroppedTime() == 0.0);
+}
+
+TEST_CASE("Simulating below the frame rate runs a step every few frames")
+{
+  FixedTimestep timestep(30.0);
+  uint32_t steps = 0;
+  for (int frame = 0; frame < 120; ++frame) {
+    const uint32_t frame_steps = timestep.Advance(1.0 / 120.0);
+    CHECK(frame_steps <= 1);
+    CHECK(timestep.GetAlpha() >= 0.0F);
+    CHECK(timestep.GetAlpha() < 1.0F);
+    steps += frame_steps;
+  }
+  // One second at 30 ticks a second, give or take rounding on the last frame.
+  CHECK(steps >= 29);
+  CHECK(steps <= 30);
+}
+
+TEST_CASE("A long frame is clamped rather than spiralling")
+{
+  FixedTimestep timestep(100.0, 4);
+  CHECK(timestep.Advance(1.005) == 4);
+  CHECK(timestep.GetDroppedTime() == doctest::Approx(0.96));
+  CHECK(timestep.GetAlpha() == doctest::Approx(0.5));
+  // Back to normal on the next frame.
+  CHECK(timestep.Advance(0.01) == 1);
+}
+
+TEST_CASE("Changing the tick rate keeps accumulated time")
+{
+  FixedTimestep timestep(10.0);
+  CHECK(timestep.Advance(0.05) == 0);
+  timestep.SetTickRate(40.0);
+  CHECK(timestep.GetStep() == doctest::Approx(0.025));
+  CHECK(timestep.Advance(0.0) == 2);
+}
+
+TEST_CASE("Negative frame times are ignored")
+{
+  FixedTimestep timestep(10.0);
+  CHECK(timestep.Advance(-1.0) == 0);
+  CHECK(timestep.GetAlpha() == 0.0F);
+}
+
+// NOLINTEND
@@ -0,0 +1,82 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+
+#include "evie/frame_pacer.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+TEST_CASE("Frame time history keeps the newest frames in order")
+{
+  FrameTimeHistory history(4);
+  CHECK(history.Empty());
+  for (const float time : { 1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F }) {
+    history.Push(time);
+  }
+  REQUIRE(history.Size() == 4);
+  CHECK(history[0] == 3.0F);
+  CHECK(history[3] == 6.0F);
+  CHECK(history.Latest() == 6.0F);
+  CHECK(history.Average() == doctest::Approx(4.5F));
+  CHECK(history.Max() == 6.0F);
+
+  history.Clear();
+  CHECK(history.Empty());
+  CHECK(history.Average() == 0.0F);
+  CHECK(history.Latest() == 0.0F);
+}
+
+TEST_CASE("A history without capacity stays empty")
+{
+  FrameTimeHistory history(0);
+  history.Push(1.0F);
+  CHECK(history.Empty());
+  CHECK(history.Latest() == 0.0F);
+  CHECK(history[0] == 0.0F);
+  CHECK(history.Max() == 0.0F);
+}
+
+TEST_CASE("Percentiles pick from the sorted frame times")
+{
+  FrameTimeHistory history(100);
+  for (int i = 100; i > 0; --i) {
+    history.Push(static_cast<float>(i));
+  }
+  CHECK(history.Percentile(0.0F) == 1.0F);
+  CHECK(history.Percentile(0.5F) == doctest::Approx(51.0F));
+  CHECK(history.Percentile(0.99F) == 99.0F);
+  CHECK(history.Percentile(1.0F) == 100.0F);
+}
+
+TEST_CASE("A capped frame rate holds frames to the target")
+{
+  FramePacer pacer;
+  pacer.SetTargetFrameRate(200.0);
+  const auto start = FramePacer::Clock::now();
+  for (int frame = 0; frame <= 20; ++frame) {
+    pacer.EndFrame();
+  }
+  const auto elapsed = std::chrono::duration<double>(FramePacer::Clock::now() - start).count();
+
+  const FrameTimeHistory& history = pacer.GetHistory();
+  REQUIRE(history.Size() == 20);
+  for (size_t i = 0; i < history.Size(); ++i) {
+    CHECK(history[i] >= 0.005F);
+  }
+  // No upper bound, a busy machine can make any frame late.
+  CHECK(elapsed >= 0.1);
+}
+
+TEST_CASE("An uncapped pacer doesn't wait")
+{
+  FramePacer pacer;
+  for (int frame = 0; frame <= 10; ++frame) {
+    pacer.EndFrame();
+  }
+  REQUIRE(pacer.GetHistory().Size() == 10);
+  CHECK(pacer.GetHistory().Max() < 0.005F);
+}
+
+// NOLINTEND
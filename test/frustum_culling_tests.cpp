@@ -0,0 +1,107 @@
+#include <doctest/doctest.h>
+
+#include <vector>
+
+#include "evie/default_models.h"
+#include "evie/frustum_culling.h"
+#include "evie/types.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+namespace {
+Frustum MakeFrustum()
+{
+  // Camera at the origin looking down -z.
+  const mat4 view = glm::lookAt(vec3{ 0.0F, 0.0F, 0.0F }, vec3{ 0.0F, 0.0F, -1.0F }, vec3{ 0.0F, 1.0F, 0.0F });
+  const mat4 projection = glm::perspective(glm::radians(45.0F), 16.0F / 9.0F, 0.1F, 100.0F);
+  return Frustum::FromViewProjection(projection * view);
+}
+}// namespace
+
+TEST_CASE("Calculate bounding volume of the default cube")
+{
+  const auto& cube = default_models::cube;
+  BoundingVolume volume = CalculateBoundingVolume(cube.data(), cube.size(), 5);
+  REQUIRE(volume.aabb.min.x == doctest::Approx(-0.5));
+  REQUIRE(volume.aabb.min.y == doctest::Approx(-0.5));
+  REQUIRE(volume.aabb.min.z == doctest::Approx(-0.5));
+  REQUIRE(volume.aabb.max.x == doctest::Approx(0.5));
+  REQUIRE(volume.aabb.max.y == doctest::Approx(0.5));
+  REQUIRE(volume.aabb.max.z == doctest::Approx(0.5));
+  REQUIRE(volume.sphere.centre.x == doctest::Approx(0.0));
+  REQUIRE(volume.sphere.radius == doctest::Approx(0.8660254));
+}
+
+TEST_CASE("Calculate bounding volume handles empty data")
+{
+  BoundingVolume volume = CalculateBoundingVolume(nullptr, 0, 3);
+  REQUIRE(volume.sphere.radius == doctest::Approx(0.0));
+}
+
+TEST_CASE("Transform bounding sphere uses the largest scale")
+{
+  BoundingSphere sphere{ vec3{ 0.0F }, 1.0F };
+  mat4 model = glm::translate(mat4(1.0F), vec3{ 1.0F, 2.0F, 3.0F });
+  model = glm::scale(model, vec3{ 1.0F, 4.0F, 2.0F });
+  BoundingSphere world = TransformBoundingSphere(sphere, model);
+  REQUIRE(world.centre.x == doctest::Approx(1.0));
+  REQUIRE(world.centre.y == doctest::Approx(2.0));
+  REQUIRE(world.centre.z == doctest::Approx(3.0));
+  REQUIRE(world.radius == doctest::Approx(4.0));
+}
+
+TEST_CASE("Frustum intersects spheres")
+{
+  const Frustum frustum = MakeFrustum();
+  // In front of the camera
+  REQUIRE(frustum.Intersects({ vec3{ 0.0F, 0.0F, -10.0F }, 1.0F }));
+  // Behind the camera
+  REQUIRE_FALSE(frustum.Intersects({ vec3{ 0.0F, 0.0F, 10.0F }, 1.0F }));
+  // Behind the camera but large enough to overlap the near plane
+  REQUIRE(frustum.Intersects({ vec3{ 0.0F, 0.0F, 5.0F }, 6.0F }));
+  // Past the far plane
+  REQUIRE_FALSE(frustum.Intersects({ vec3{ 0.0F, 0.0F, -200.0F }, 1.0F }));
+  // Way off to the side
+  REQUIRE_FALSE(frustum.Intersects({ vec3{ 100.0F, 0.0F, -10.0F }, 1.0F }));
+}
+
+TEST_CASE("FrustumCuller outputs a compact visible list")
+{
+  const Frustum frustum = MakeFrustum();
+  FrustumCuller culler;
+  // Use a count that isn't a multiple of the batch size so the scalar tail is covered too.
+  std::vector<BoundingSphere> spheres;
+  for (int i = 0; i < 23; ++i) {
+    const float z = (i % 2 == 0) ? -5.0F - static_cast<float>(i) : 5.0F + static_cast<float>(i);
+    spheres.push_back({ vec3{ 0.0F, 0.0F, z }, 0.5F });
+  }
+  culler.Reserve(spheres.size());
+  for (const auto& sphere : spheres) {
+    culler.Add(sphere);
+  }
+  REQUIRE_EQ(culler.Size(), spheres.size());
+  culler.Cull(frustum);
+
+  std::vector<uint32_t> expected;
+  for (uint32_t i = 0; i < spheres.size(); ++i) {
+    if (frustum.Intersects(spheres[i])) {
+      expected.push_back(i);
+    }
+  }
+  REQUIRE_EQ(expected.size(), 12);
+  REQUIRE(culler.GetVisible() == expected);
+
+  SUBCASE("Clear empties the culler")
+  {
+    culler.Clear();
+    culler.Cull(frustum);
+    REQUIRE(culler.GetVisible().empty());
+    REQUIRE_EQ(culler.Size(), 0);
+  }
+}
+
+// NOLINTEND
@@ -0,0 +1,91 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "evie/geometry_pool.h"
+#include "evie/null_render_backend.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+TEST_CASE("Ranges are allocated first fit")
+{
+  RangeAllocator allocator(100);
+  REQUIRE_EQ(allocator.Allocate(10).value(), 0);
+  REQUIRE_EQ(allocator.Allocate(20).value(), 10);
+  REQUIRE_EQ(allocator.Allocate(30).value(), 30);
+  REQUIRE_EQ(allocator.FreeCount(), 40);
+  REQUIRE_FALSE(allocator.Allocate(41).has_value());
+  REQUIRE_FALSE(allocator.Allocate(0).has_value());
+
+  SUBCASE("A freed range is reused by something that fits")
+  {
+    allocator.Free(10, 20);
+    REQUIRE_EQ(allocator.Allocate(15).value(), 10);
+    REQUIRE_EQ(allocator.Allocate(5).value(), 25);
+    REQUIRE_EQ(allocator.Allocate(40).value(), 60);
+    REQUIRE_EQ(allocator.FreeCount(), 0);
+  }
+
+  SUBCASE("Neighbouring free ranges merge")
+  {
+    allocator.Free(0, 10);
+    allocator.Free(30, 30);
+    REQUIRE_EQ(allocator.LargestFree(), 70);
+    // Joins the ranges either side into everything.
+    allocator.Free(10, 20);
+    REQUIRE_EQ(allocator.LargestFree(), 100);
+    REQUIRE_EQ(allocator.Allocate(100).value(), 0);
+  }
+}
+
+TEST_CASE("Draw lists hold what glMultiDrawElementsBaseVertex takes")
+{
+  GeometryDrawList draws;
+  draws.Add({ 0, 36, 0, 24 });
+  draws.Add({ 36, 6, 24, 4 });
+  REQUIRE_EQ(draws.Size(), 2);
+  REQUIRE_EQ(draws.GetCounts()[1], 6);
+  REQUIRE_EQ(reinterpret_cast<uintptr_t>(draws.GetOffsets()[1]), 36 * sizeof(uint32_t));
+  REQUIRE_EQ(draws.GetBaseVertices()[1], 24);
+
+  draws.Clear();
+  REQUIRE(draws.Empty());
+}
+
+TEST_CASE("The vertex size must match the layout")
+{
+  REQUIRE(LoadNullRenderBackend().Good());
+  const BufferLayout layout{ 5, VertexDataType::Float, { 3, 2 } };
+  GeometryPool pool;
+  SUBCASE("Mismatched")
+  {
+    CHECK(pool.Initialise(layout, 3 * sizeof(float), 64, 64).Bad());
+    CHECK(GetNullRenderStats().objects_created == 0);
+  }
+  SUBCASE("Matching")
+  {
+    REQUIRE(pool.Initialise(layout, 5 * sizeof(float), 64, 64).Good());
+    pool.Destroy();
+  }
+}
+
+TEST_CASE("Empty meshes can't be added")
+{
+  REQUIRE(LoadNullRenderBackend().Good());
+  const BufferLayout layout{ 3, VertexDataType::Float, { 3 } };
+  GeometryPool pool;
+  // Room for exactly one triangle.
+  REQUIRE(pool.Initialise(layout, 3 * sizeof(float), 3, 3).Good());
+  const std::vector<float> vertices(9, 0.0F);
+  const std::vector<uint32_t> indices = { 0, 1, 2 };
+  CHECK(pool.Add(vertices.data(), 0, indices).Bad());
+  CHECK(pool.Add(vertices.data(), 3, {}).Bad());
+  // Neither took any space.
+  REQUIRE(pool.Add(vertices.data(), 3, indices).Good());
+  pool.Destroy();
+}
+
+// NOLINTEND
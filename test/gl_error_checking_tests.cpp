@@ -0,0 +1,62 @@
+#include <doctest/doctest.h>
+
+#include <vector>
+
+#include "rendering/debug.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+namespace {
+std::vector<bool> CheckedFrames(int frames)
+{
+  std::vector<bool> checked;
+  for (int i = 0; i < frames; ++i) {
+    GLErrorCheckNewFrame();
+    checked.push_back(ShouldCheckGLErrors());
+  }
+  return checked;
+}
+}// namespace
+
+TEST_CASE("Per call checking checks every frame")
+{
+  REQUIRE(SetGLErrorCheckMode(GLErrorCheckMode::PerCall).Good());
+  REQUIRE_EQ(GetGLErrorCheckMode(), GLErrorCheckMode::PerCall);
+  REQUIRE(CheckedFrames(4) == std::vector<bool>{ true, true, true, true });
+}
+
+TEST_CASE("Off never checks")
+{
+  REQUIRE(SetGLErrorCheckMode(GLErrorCheckMode::Off).Good());
+  REQUIRE(CheckedFrames(4) == std::vector<bool>{ false, false, false, false });
+}
+
+TEST_CASE("Sampled checks every Nth frame")
+{
+  SetGLErrorSampleInterval(3);
+  REQUIRE(SetGLErrorCheckMode(GLErrorCheckMode::Sampled).Good());
+  const std::vector<bool> checked = CheckedFrames(9);
+  int count = 0;
+  for (const bool check : checked) {
+    count += check ? 1 : 0;
+  }
+  REQUIRE_EQ(count, 3);
+
+  SUBCASE("An interval of 0 checks every frame")
+  {
+    SetGLErrorSampleInterval(0);
+    REQUIRE(CheckedFrames(3) == std::vector<bool>{ true, true, true });
+  }
+}
+
+TEST_CASE("Debug callback falls back to sampled without KHR_debug")
+{
+  // No context so InitialiseGLErrorChecking() hasn't found the entry points.
+  REQUIRE(SetGLErrorCheckMode(GLErrorCheckMode::DebugCallback).Bad());
+  REQUIRE_EQ(GetGLErrorCheckMode(), GLErrorCheckMode::Sampled);
+  REQUIRE(SetGLErrorCheckMode(GLErrorCheckMode::PerCall).Good());
+}
+
+// NOLINTEND
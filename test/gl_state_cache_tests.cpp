@@ -0,0 +1,146 @@
+#include <doctest/doctest.h>
+
+#include <vector>
+
+#include "rendering/gl_state_cache.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+namespace {
+enum class Call { UseProgram, BindVertexArray, BindBuffer, ActiveTexture, BindTexture };
+
+struct RecordedCall
+{
+  Call call;
+  GLenum target;
+  GLuint value;
+};
+
+std::vector<RecordedCall> calls;
+
+GLFunctions MockFunctions()
+{
+  calls.clear();
+  GLFunctions functions;
+  functions.use_program = [](GLuint program) { calls.push_back({ Call::UseProgram, 0, program }); };
+  functions.bind_vertex_array = [](GLuint vertex_array) {
+    calls.push_back({ Call::BindVertexArray, 0, vertex_array });
+  };
+  functions.bind_buffer = [](GLenum target, GLuint buffer) { calls.push_back({ Call::BindBuffer, target, buffer }); };
+  functions.active_texture = [](GLenum unit) { calls.push_back({ Call::ActiveTexture, 0, unit }); };
+  functions.bind_texture = [](GLenum target, GLuint texture) {
+    calls.push_back({ Call::BindTexture, target, texture });
+  };
+  return functions;
+}
+}// namespace
+
+TEST_CASE("Redundant program binds are elided")
+{
+  GLStateCache cache(MockFunctions());
+  cache.UseProgram(1);
+  cache.UseProgram(1);
+  cache.UseProgram(2);
+  cache.UseProgram(2);
+  cache.UseProgram(1);
+  REQUIRE_EQ(calls.size(), 3);
+  REQUIRE_EQ(calls[2].value, 1);
+  REQUIRE_EQ(cache.GetStats().issued, 3);
+  REQUIRE_EQ(cache.GetStats().elided, 2);
+
+  SUBCASE("Invalidate forces the next bind")
+  {
+    cache.Invalidate();
+    cache.UseProgram(1);
+    REQUIRE_EQ(calls.size(), 4);
+  }
+
+  SUBCASE("Deleting a program forgets it")
+  {
+    cache.OnProgramDeleted(1);
+    cache.UseProgram(1);
+    REQUIRE_EQ(calls.size(), 4);
+  }
+}
+
+TEST_CASE("Buffers are tracked per target")
+{
+  GLStateCache cache(MockFunctions());
+  cache.BindBuffer(GL_ARRAY_BUFFER, 5);
+  cache.BindBuffer(GL_UNIFORM_BUFFER, 5);
+  cache.BindBuffer(GL_ARRAY_BUFFER, 5);
+  cache.BindBuffer(GL_UNIFORM_BUFFER, 5);
+  REQUIRE_EQ(calls.size(), 2);
+
+  // Targets that aren't tracked are always passed through.
+  cache.BindBuffer(GL_COPY_READ_BUFFER, 5);
+  cache.BindBuffer(GL_COPY_READ_BUFFER, 5);
+  REQUIRE_EQ(calls.size(), 4);
+
+  // Deleting a bound buffer resets the binding to 0.
+  cache.OnBufferDeleted(5);
+  cache.BindBuffer(GL_ARRAY_BUFFER, 0);
+  REQUIRE_EQ(calls.size(), 4);
+  REQUIRE_EQ(cache.GetStats().issued, 4);
+  REQUIRE_EQ(cache.GetStats().elided, 3);
+}
+
+TEST_CASE("Element array buffer binding belongs to the vertex array")
+{
+  GLStateCache cache(MockFunctions());
+  cache.BindVertexArray(1);
+  cache.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 7);
+  cache.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 7);
+  REQUIRE_EQ(calls.size(), 2);
+
+  cache.BindVertexArray(2);
+  cache.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 7);
+  REQUIRE_EQ(calls.size(), 4);
+
+  // Rebinding the same vertex array keeps the element array buffer.
+  cache.BindVertexArray(2);
+  cache.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 7);
+  REQUIRE_EQ(calls.size(), 4);
+
+  // Deleting the bound vertex array goes back to the default vertex array.
+  cache.OnVertexArrayDeleted(2);
+  cache.BindVertexArray(0);
+  REQUIRE_EQ(calls.size(), 4);
+}
+
+TEST_CASE("Textures are tracked per unit")
+{
+  GLStateCache cache(MockFunctions());
+  // Nothing is known about the active unit yet so the bind can't be elided.
+  cache.BindTexture(GL_TEXTURE_2D, 3);
+  cache.BindTexture(GL_TEXTURE_2D, 3);
+  REQUIRE_EQ(calls.size(), 2);
+
+  cache.ActiveTexture(GL_TEXTURE0);
+  cache.BindTexture(GL_TEXTURE_2D, 3);
+  cache.BindTexture(GL_TEXTURE_2D, 3);
+  REQUIRE_EQ(calls.size(), 4);
+
+  cache.ActiveTexture(GL_TEXTURE1);
+  cache.BindTexture(GL_TEXTURE_2D, 3);
+  cache.BindTexture(GL_TEXTURE_2D_ARRAY, 3);
+  REQUIRE_EQ(calls.size(), 7);
+
+  cache.ActiveTexture(GL_TEXTURE0);
+  cache.BindTexture(GL_TEXTURE_2D, 3);
+  REQUIRE_EQ(calls.size(), 8);
+  REQUIRE_EQ(calls.back().call, Call::ActiveTexture);
+
+  cache.OnTextureDeleted(3);
+  cache.BindTexture(GL_TEXTURE_2D, 3);
+  REQUIRE_EQ(calls.size(), 9);
+  REQUIRE_EQ(calls.back().call, Call::BindTexture);
+
+  cache.ResetStats();
+  REQUIRE_EQ(cache.GetStats().issued, 0);
+  REQUIRE_EQ(cache.GetStats().elided, 0);
+}
+
+// NOLINTEND
@@ -0,0 +1,149 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "evie/gpu_profiler.h"
+#include "evie/null_render_backend.h"
+#include "evie/profiler.h"
+
+// NOLINTBEGIN
+
+// Zones are made directly rather than through EV_PROFILE_GPU_SCOPE, which is empty when Evie_ENABLE_PROFILING is off.
+
+using namespace evie;
+
+namespace {
+struct NullBackend
+{
+  NullBackend()
+  {
+    REQUIRE(LoadNullRenderBackend().Good());
+    SetNullQueryResultsAvailable(true);
+  }
+  ~NullBackend() { SetNullQueryResultsAvailable(true); }
+};
+}// namespace
+
+TEST_CASE("Zones are read back once the GPU has finished the frame")
+{
+  const NullBackend backend;
+  GpuProfiler profiler;
+  REQUIRE(profiler.Initialise(3, 16).Good());
+
+  profiler.BeginFrame();
+  {
+    const GpuProfileScope outer(profiler, "Frame");
+    {
+      const GpuProfileScope inner(profiler, "Pass");
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  profiler.EndFrame();
+  CHECK(profiler.GetLastFrame().empty());
+
+  profiler.BeginFrame();
+  profiler.EndFrame();
+  CHECK(profiler.GetResolvedFrameCount() == 1);
+  const auto frame = profiler.GetLastFrame();
+  REQUIRE(frame.size() == 2);
+  CHECK(std::string(frame[0].name) == "Frame");
+  CHECK(frame[0].depth == 0);
+  CHECK(std::string(frame[1].name) == "Pass");
+  CHECK(frame[1].depth == 1);
+  CHECK(frame[1].milliseconds >= 1.0);
+  CHECK(frame[0].milliseconds >= frame[1].milliseconds);
+  CHECK(frame[1].start_ms >= 0.0);
+  profiler.Destroy();
+}
+
+TEST_CASE("Frames the GPU hasn't finished are dropped rather than waited for")
+{
+  const NullBackend backend;
+  GpuProfiler profiler;
+  REQUIRE(profiler.Initialise(2, 16).Good());
+  SetNullQueryResultsAvailable(false);
+
+  for (int i = 0; i < 4; ++i) {
+    profiler.BeginFrame();
+    profiler.BeginZone("Frame");
+    profiler.EndZone();
+    profiler.EndFrame();
+  }
+  CHECK(profiler.GetResolvedFrameCount() == 0);
+  // The first two frames had their slots reused before their results were ready.
+  CHECK(profiler.GetDroppedFrameCount() == 2);
+
+  SetNullQueryResultsAvailable(true);
+  profiler.BeginFrame();
+  profiler.EndFrame();
+  CHECK(profiler.GetResolvedFrameCount() == 2);
+  CHECK(profiler.GetDroppedFrameCount() == 2);
+  profiler.Destroy();
+}
+
+TEST_CASE("Zones past the per frame limit aren't timed and don't unbalance nesting")
+{
+  const NullBackend backend;
+  GpuProfiler profiler;
+  REQUIRE(profiler.Initialise(2, 2).Good());
+
+  profiler.BeginFrame();
+  profiler.BeginZone("A");
+  profiler.BeginZone("B");
+  profiler.BeginZone("C");
+  profiler.EndZone();
+  profiler.EndZone();
+  profiler.EndZone();
+  profiler.BeginFrame();
+  profiler.EndFrame();
+
+  CHECK(profiler.GetDroppedZoneCount() == 1);
+  const auto frame = profiler.GetLastFrame();
+  REQUIRE(frame.size() == 2);
+  CHECK(std::string(frame[1].name) == "B");
+  CHECK(frame[1].depth == 1);
+  profiler.Destroy();
+}
+
+TEST_CASE("Zones outside a frame are ignored")
+{
+  const NullBackend backend;
+  GpuProfiler profiler;
+  REQUIRE(profiler.Initialise().Good());
+  ResetNullRenderStats();
+  {
+    const GpuProfileScope zone(profiler, "Ignored");
+  }
+  CHECK(GetNullRenderStats().gl_calls == 0);
+  profiler.Destroy();
+}
+
+TEST_CASE("Resolved zones go onto the GPU track of a capture")
+{
+  const NullBackend backend;
+  GpuProfiler profiler;
+  REQUIRE(profiler.Initialise().Good());
+  Profiler::Get().Clear();
+  Profiler::Get().BeginCapture();
+
+  profiler.BeginFrame();
+  {
+    const GpuProfileScope zone(profiler, "Shadow Pass");
+  }
+  profiler.BeginFrame();
+  profiler.EndFrame();
+
+  Profiler::Get().EndCapture();
+  std::ostringstream trace;
+  Profiler::Get().WriteChromeTrace(trace);
+  const std::string json = trace.str();
+  CHECK(json.find(R"("args":{"name":"GPU"})") != std::string::npos);
+  CHECK(json.find(R"("name":"Shadow Pass")") != std::string::npos);
+  Profiler::Get().Clear();
+  profiler.Destroy();
+}
+
+// NOLINTEND
@@ -0,0 +1,105 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "evie/mesh_optimiser.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+namespace {
+// A size x size grid of quads, triangles ordered one column after another which is poor for the cache.
+void MakeGrid(uint32_t size, std::vector<BakedVertex>& vertices, std::vector<uint32_t>& indices)
+{
+  const uint32_t row = size + 1;
+  for (uint32_t y = 0; y <= size; ++y) {
+    for (uint32_t x = 0; x <= size; ++x) {
+      const float fx = static_cast<float>(x);
+      const float fy = static_cast<float>(y);
+      vertices.push_back(BakedVertex{ { fx, fy, 0.0F }, { 0.0F, 0.0F, 1.0F }, { fx, fy } });
+    }
+  }
+  for (uint32_t x = 0; x < size; ++x) {
+    for (uint32_t y = 0; y < size; ++y) {
+      const uint32_t corner = y * row + x;
+      indices.insert(indices.end(), { corner, corner + 1, corner + row + 1, corner, corner + row + 1, corner + row });
+    }
+  }
+}
+
+using Triangle = std::array<std::array<float, 3>, 3>;
+
+// Each triangle's positions rotated so the smallest comes first, which keeps the winding but not the start corner.
+std::vector<Triangle> Triangles(const std::vector<BakedVertex>& vertices, const std::vector<uint32_t>& indices)
+{
+  std::vector<Triangle> triangles;
+  for (size_t i = 0; i < indices.size(); i += 3) {
+    Triangle triangle = {
+      vertices[indices[i]].position, vertices[indices[i + 1]].position, vertices[indices[i + 2]].position
+    };
+    std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+    triangles.push_back(triangle);
+  }
+  std::sort(triangles.begin(), triangles.end());
+  return triangles;
+}
+}// namespace
+
+TEST_CASE("Deduplication merges identical vertices")
+{
+  const std::vector<BakedVertex> vertices = { BakedVertex{ { 0, 0, 0 } },
+    BakedVertex{ { 1, 0, 0 } },
+    BakedVertex{ { 0, 0, 0 } },
+    BakedVertex{ { 1, 0, 0 }, { 0, 1, 0 } } };
+  std::vector<uint32_t> remap;
+  REQUIRE(GenerateDeduplicationRemap(vertices.data(), vertices.size(), sizeof(BakedVertex), remap) == 3);
+  CHECK(remap == std::vector<uint32_t>{ 0, 1, 0, 2 });
+}
+
+TEST_CASE("Vertex fetch remap orders by first use and drops unused vertices")
+{
+  const std::vector<uint32_t> indices = { 3, 1, 4, 4, 1, 0 };
+  std::vector<uint32_t> remap;
+  REQUIRE(GenerateVertexFetchRemap(indices, 6, remap) == 4);
+  CHECK(remap == std::vector<uint32_t>{ 3, 1, UnusedVertex, 0, 2, UnusedVertex });
+}
+
+TEST_CASE("Optimising a mesh lowers cache misses and keeps every triangle")
+{
+  std::vector<BakedVertex> vertices;
+  std::vector<uint32_t> indices;
+  MakeGrid(32, vertices, indices);
+  const float before = AverageCacheMissRatio(indices, vertices.size());
+  const auto triangles = Triangles(vertices, indices);
+
+  OptimiseMesh(vertices, indices);
+
+  CHECK(AverageCacheMissRatio(indices, vertices.size()) < before * 0.75F);
+  CHECK(Triangles(vertices, indices) == triangles);
+  // The fetch remap leaves vertices in the order they're first used.
+  uint32_t next = 0;
+  for (const uint32_t index : indices) {
+    REQUIRE(index <= next);
+    next = std::max(next, index + 1);
+  }
+  CHECK(next == vertices.size());
+}
+
+TEST_CASE("Overdraw optimisation keeps every triangle")
+{
+  std::vector<BakedVertex> vertices;
+  std::vector<uint32_t> indices;
+  MakeGrid(32, vertices, indices);
+  OptimiseVertexCache(indices, vertices.size());
+  const auto triangles = Triangles(vertices, indices);
+
+  OptimiseOverdraw(indices, vertices.front().position.data(), vertices.size(), sizeof(BakedVertex) / sizeof(float));
+
+  CHECK(Triangles(vertices, indices) == triangles);
+}
+
+// NOLINTEND
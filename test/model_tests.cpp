@@ -0,0 +1,145 @@
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "evie/null_render_backend.h"
+#include "evie/render_stats.h"
+#include "evie/shader.h"
+#include "evie/shader_program.h"
+#include "evie/thread_pool.h"
+#include "rendering/model.hpp"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+namespace {
+// Two single triangle meshes. The first uses a texture that decodes, the second one that's missing.
+std::string WriteModel()
+{
+  const auto directory = std::filesystem::temp_directory_path() / "evie_model_tests";
+  std::filesystem::create_directories(directory);
+  std::ofstream(directory / "model.obj") << "mtllib model.mtl\n"
+                                            "o first\n"
+                                            "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+                                            "vt 0 0\nvt 1 0\nvt 0 1\n"
+                                            "vn 0 0 1\n"
+                                            "usemtl textured\n"
+                                            "f 1/1/1 2/2/1 3/3/1\n"
+                                            "o second\n"
+                                            "v 0 0 1\nv 1 0 1\nv 0 1 1\n"
+                                            "usemtl missing\n"
+                                            "f 4/1/1 5/2/1 6/3/1\n";
+  std::ofstream(directory / "model.mtl") << "newmtl textured\nmap_Kd texture.ppm\n"
+                                            "newmtl missing\nmap_Kd missing.png\n";
+  // A 2x2 binary PPM.
+  std::ofstream(directory / "texture.ppm", std::ios::binary) << "P6\n2 2\n255\n" << std::string(12, '\x7f');
+  return (directory / "model.obj").string();
+}
+
+std::string WriteShaderFile(const std::string& name)
+{
+  const auto path = std::filesystem::temp_directory_path() / name;
+  std::ofstream(path) << "#version 330 core\nvoid main() {}\n";
+  return path.string();
+}
+
+struct NullProgram
+{
+  VertexShader vertex_shader;
+  FragmentShader fragment_shader;
+  ShaderProgram program;
+
+  NullProgram()
+  {
+    REQUIRE(vertex_shader.Initialise(WriteShaderFile("evie_model_tests.vs")).Good());
+    REQUIRE(fragment_shader.Initialise(WriteShaderFile("evie_model_tests.fs")).Good());
+    REQUIRE(program.Initialise(&vertex_shader, &fragment_shader).Good());
+  }
+};
+
+// Load the model and draw it once, returning what reached the backend.
+NullRenderStats LoadAndDraw(ThreadPool* workers)
+{
+  REQUIRE(LoadNullRenderBackend(true).Good());
+  NullProgram shader;
+  Model model(WriteModel());
+  REQUIRE(model.Initialise(workers).Good());
+  model.Draw(shader.program);
+  return GetNullRenderStats();
+}
+
+// Sets the flag when it goes out of scope, so a failed REQUIRE doesn't leave a job spinning while the pool joins it.
+struct ReleaseOnExit
+{
+  std::atomic<bool>& release;
+  ~ReleaseOnExit() { release = true; }
+};
+}// namespace
+
+TEST_CASE("Models load the same with and without workers")
+{
+  const NullRenderStats serial = LoadAndDraw(nullptr);
+  ThreadPool pool(2);
+  const NullRenderStats parallel = LoadAndDraw(&pool);
+
+  CHECK(serial.draw_calls == 2);
+  CHECK(parallel.draw_calls == serial.draw_calls);
+  CHECK(parallel.objects_created == serial.objects_created);
+  CHECK(parallel.bytes_uploaded == serial.bytes_uploaded);
+}
+
+TEST_CASE("A texture that fails to decode doesn't fail the model")
+{
+  ThreadPool pool(2);
+  const NullRenderStats stats = LoadAndDraw(&pool);
+  // Both meshes are drawn, the second without its missing texture.
+  CHECK(stats.draw_calls == 2);
+  const auto draws = GetRecordedDraws();
+  REQUIRE(draws.size() == 2);
+  CHECK(draws[0].vertex_array != draws[1].vertex_array);
+}
+
+TEST_CASE("Loading doesn't wait for other jobs on a shared pool")
+{
+  ThreadPool pool(1);
+  std::atomic<bool> release{ false };
+  // Would never finish if the load waited for the whole pool.
+  pool.Submit([&release] {
+    while (!release) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  const ReleaseOnExit guard{ release };
+  const NullRenderStats stats = LoadAndDraw(&pool);
+  CHECK(stats.draw_calls == 2);
+}
+
+TEST_CASE("Drawing a model binds each mesh's vertex array and texture")
+{
+  REQUIRE(LoadNullRenderBackend(true).Good());
+  NullProgram shader;
+  Model model(WriteModel());
+  REQUIRE(model.Initialise(nullptr).Good());
+  model.Draw(shader.program);
+  ResetNullRenderStats();
+  ResetRenderStats();
+
+  model.Draw(shader.program);
+  // The mesh whose texture failed to load draws with none bound, so both meshes swap both.
+  CHECK(GetRenderStats().binds_issued == 4);
+  CHECK(GetRenderStats().draw_calls == 2);
+  CHECK(GetNullRenderStats().draw_calls == 2);
+  const auto draws = GetRecordedDraws();
+  REQUIRE(draws.size() == 2);
+  CHECK(draws[0].texture != 0);
+  CHECK(draws[1].texture == 0);
+  CHECK(draws[0].count == 3);
+}
+
+// NOLINTEND
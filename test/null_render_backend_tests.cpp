@@ -0,0 +1,312 @@
+#include <doctest/doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "evie/geometry_pool.h"
+#include "evie/indices_array.h"
+#include "evie/null_render_backend.h"
+#include "evie/render_queue.h"
+#include "evie/render_stats.h"
+#include "evie/shader_program.h"
+#include "evie/texture.h"
+#include "evie/texture_array.h"
+#include "evie/vertex_array.h"
+#include "evie/vertex_buffer.h"
+#include "rendering/mesh.hpp"
+
+#include "glad/glad.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+namespace {
+// The null backend never compiles anything but the shader classes still read their files.
+std::string WriteShaderFile(const std::string& name)
+{
+  const auto path = std::filesystem::temp_directory_path() / name;
+  std::ofstream(path) << "#version 330 core\nvoid main() {}\n";
+  return path.string();
+}
+
+struct NullProgram
+{
+  VertexShader vertex_shader;
+  FragmentShader fragment_shader;
+  ShaderProgram program;
+
+  NullProgram()
+  {
+    REQUIRE(vertex_shader.Initialise(WriteShaderFile("evie_null_backend.vs")).Good());
+    REQUIRE(fragment_shader.Initialise(WriteShaderFile("evie_null_backend.fs")).Good());
+    REQUIRE(program.Initialise(&vertex_shader, &fragment_shader).Good());
+  }
+};
+}// namespace
+
+TEST_CASE("Objects get names without a context")
+{
+  REQUIRE(LoadNullRenderBackend().Good());
+
+  const std::vector<float> vertices(9, 1.0F);
+  VertexBuffer<float> vertex_buffer;
+  REQUIRE(vertex_buffer.Initialise(std::span<const float>(vertices), BufferLayout{ 3, VertexDataType::Float, { 3 } })
+            .Good());
+  VertexArray<float> vertex_array;
+  vertex_array.Initialise();
+  REQUIRE(vertex_array.AssociateVertexBuffer(vertex_buffer).Good());
+
+  CHECK(vertex_array.GetID().Get() != 0);
+  const NullRenderStats& stats = GetNullRenderStats();
+  CHECK(stats.objects_created == 2);
+  CHECK(stats.bytes_uploaded == vertices.size() * sizeof(float));
+  CHECK(stats.draw_calls == 0);
+
+  vertex_array.Destroy();
+  vertex_buffer.Destroy();
+  CHECK(stats.objects_deleted == 2);
+}
+
+TEST_CASE("Vertex buffers count their vertices and only keep a copy when retained")
+{
+  REQUIRE(LoadNullRenderBackend().Good());
+  const std::vector<float> vertices(12, 1.0F);
+  const std::span<const float> data(vertices);
+
+  SUBCASE("Released")
+  {
+    VertexBuffer<float> buffer;
+    REQUIRE(buffer.Initialise(data, BufferLayout{ 3, VertexDataType::Float, { 3 } }).Good());
+    CHECK(buffer.GetVertexCount() == 4);
+    CHECK(buffer.GetSizeInBytes() == vertices.size() * sizeof(float));
+    CHECK(buffer.GetRetention() == BufferRetention::Release);
+    CHECK(buffer.GetBuffer().empty());
+    // Released or not, everything still goes to the GPU.
+    CHECK(GetNullRenderStats().bytes_uploaded == vertices.size() * sizeof(float));
+    buffer.Destroy();
+  }
+  SUBCASE("Retained")
+  {
+    VertexBuffer<float> buffer;
+    REQUIRE(buffer.Initialise(data, BufferLayout{ 3, VertexDataType::Float, { 3 } }, BufferRetention::Retain).Good());
+    CHECK(buffer.GetVertexCount() == 4);
+    CHECK(buffer.GetBuffer() == vertices);
+    buffer.Destroy();
+  }
+  SUBCASE("Mixed layouts count in bytes")
+  {
+    // A float position and four normalised bytes, 16 bytes a vertex.
+    const BufferLayout layout({ { 3, VertexDataType::Float }, { 4, VertexDataType::UnsignedByte, true } });
+    VertexBuffer<float> buffer;
+    REQUIRE(buffer.Initialise(data, layout).Good());
+    CHECK(buffer.GetVertexCount() == 3);
+    buffer.Destroy();
+  }
+}
+
+TEST_CASE("Index arrays keep their count after releasing their copy")
+{
+  REQUIRE(LoadNullRenderBackend().Good());
+  const std::vector<unsigned int> indices = { 0, 1, 2, 2, 3, 0 };
+
+  IndicesArray released;
+  released.Initialise(indices);
+  CHECK(released.GetCount() == indices.size());
+  CHECK(released.GetIndices().empty());
+
+  IndicesArray retained;
+  retained.Initialise(indices, BufferRetention::Retain);
+  CHECK(retained.GetCount() == indices.size());
+  CHECK(retained.GetIndices() == indices);
+  CHECK(GetNullRenderStats().bytes_uploaded == 2 * indices.size() * sizeof(unsigned int));
+  released.Destroy();
+  retained.Destroy();
+}
+
+TEST_CASE("Meshes drop their vertices and indices once uploaded unless retained")
+{
+  REQUIRE(LoadNullRenderBackend().Good());
+  const std::vector<Vertex> vertices(4);
+  const std::vector<unsigned int> indices = { 0, 1, 2, 2, 3, 0 };
+
+  Mesh<> released(vertices, indices, {});
+  REQUIRE(released.Initialise().Good());
+  CHECK(released.vertices.empty());
+  CHECK(released.indices.empty());
+  CHECK(released.GetIndexCount() == indices.size());
+
+  Mesh<> retained(vertices, indices, {}, BufferRetention::Retain);
+  REQUIRE(retained.Initialise().Good());
+  CHECK(retained.vertices.size() == vertices.size());
+  CHECK(retained.indices == indices);
+  CHECK(retained.GetIndexCount() == indices.size());
+}
+
+TEST_CASE("A program linked under a reused name gets a new generation")
+{
+  REQUIRE(LoadNullRenderBackend().Good());
+  NullProgram first;
+  const unsigned int first_id = first.program.GetID()->Get();
+  const uint64_t first_generation = first.program.GetGeneration();
+  CHECK(first_generation != 0);
+  first.program.Destroy();
+
+  // Reloading restarts the backend's names, like a driver handing out a deleted program's name again.
+  REQUIRE(LoadNullRenderBackend().Good());
+  NullProgram second;
+  CHECK(second.program.GetID()->Get() == first_id);
+  CHECK(second.program.GetGeneration() != first_generation);
+  CHECK(ShaderProgram{}.GetGeneration() == 0);
+}
+
+TEST_CASE("The render queue batches instances into one draw call")
+{
+  REQUIRE(LoadNullRenderBackend(true).Good());
+  NullProgram shader;
+  ResetNullRenderStats();
+
+  RenderQueue queue;
+  for (int i = 0; i < 10; ++i) {
+    DrawCommand command;
+    command.shader_program = &shader.program;
+    command.vertex_array = VertexArrayID(7);
+    command.vertex_count = 36;
+    command.instanced = true;
+    queue.Submit(command);
+  }
+  DrawCommand single;
+  single.shader_program = &shader.program;
+  single.vertex_array = VertexArrayID(8);
+  single.vertex_count = 6;
+  queue.Submit(single);
+  queue.Sort();
+  queue.Execute(FrameUniforms{});
+
+  const NullRenderStats& stats = GetNullRenderStats();
+  CHECK(stats.draw_calls == 2);
+  CHECK(stats.draws == 11);
+  // The frame block and every instance's matrix.
+  CHECK(stats.bytes_uploaded >= 10 * sizeof(mat4));
+  const auto draws = GetRecordedDraws();
+  REQUIRE(draws.size() == 2);
+  const RecordedDraw& instanced = draws[0].instances == 10 ? draws[0] : draws[1];
+  CHECK(instanced.instances == 10);
+  CHECK(instanced.count == 36);
+  CHECK(instanced.vertex_array == 7);
+  CHECK(instanced.program == draws[0].program);
+  CHECK(draws[0].program == draws[1].program);
+  queue.Destroy();
+}
+
+TEST_CASE("Binds skipped by the state cache never reach the backend")
+{
+  REQUIRE(LoadNullRenderBackend().Good());
+  NullProgram shader;
+  ResetNullRenderStats();
+  ResetRenderStats();
+
+  for (int i = 0; i < 5; ++i) {
+    shader.program.Use();
+  }
+  CHECK(GetNullRenderStats().state_changes == 1);
+  CHECK(GetRenderStats().binds_issued == 1);
+  CHECK(GetRenderStats().binds_elided == 4);
+}
+
+TEST_CASE("A geometry pool draw is one call with a draw per mesh")
+{
+  REQUIRE(LoadNullRenderBackend(true).Good());
+  GeometryPool pool;
+  REQUIRE(pool.Initialise(BufferLayout{ 3, VertexDataType::Float, { 3 } }, sizeof(float) * 3, 64, 64).Good());
+  const std::vector<float> triangle = { 0, 0, 0, 1, 0, 0, 0, 1, 0 };
+  const std::vector<uint32_t> indices = { 0, 1, 2 };
+  GeometryDrawList draws;
+  for (int i = 0; i < 4; ++i) {
+    auto range = pool.Add(triangle.data(), 3, indices);
+    REQUIRE(range.Good());
+    draws.Add(*range);
+  }
+  ResetNullRenderStats();
+  ResetRenderStats();
+
+  pool.Draw(draws);
+
+  CHECK(GetNullRenderStats().draw_calls == 1);
+  CHECK(GetNullRenderStats().draws == 4);
+  // The engine's own counters agree with what reached GL.
+  CHECK(GetRenderStats().draw_calls == 1);
+  CHECK(GetRenderStats().draws == 4);
+  REQUIRE(GetRecordedDraws().size() == 1);
+  CHECK(GetRecordedDraws()[0].sub_draws == 4);
+  CHECK(GetRecordedDraws()[0].count == 12);
+  pool.Destroy();
+}
+
+TEST_CASE("Drawing meshes binds only what changed between them")
+{
+  REQUIRE(LoadNullRenderBackend(true).Good());
+  NullProgram shader;
+  const ImageInfo info{ 2, 2, 4 };
+  const std::vector<unsigned char> pixels(info.Size(), 0);
+  Texture2D first_texture;
+  Texture2D second_texture;
+  REQUIRE(first_texture.Initialise(info, pixels.data(), "first").Good());
+  REQUIRE(second_texture.Initialise(info, pixels.data(), "second").Good());
+  const std::vector<Vertex> vertices(4);
+  const std::vector<unsigned int> indices = { 0, 1, 2, 2, 3, 0 };
+  Mesh<> first(vertices, indices, { first_texture });
+  Mesh<> second(vertices, indices, { second_texture });
+  REQUIRE(first.Initialise().Good());
+  REQUIRE(second.Initialise().Good());
+  // The first draw also sets the active texture unit, which then stays the same.
+  first.Draw(shader.program);
+  ResetNullRenderStats();
+  ResetRenderStats();
+
+  second.Draw(shader.program);
+  first.Draw(shader.program);
+  // Each draw swaps the vertex array and the texture.
+  CHECK(GetRenderStats().binds_issued == 4);
+  // Nothing changes so every bind is skipped.
+  first.Draw(shader.program);
+  CHECK(GetRenderStats().binds_issued == 4);
+
+  CHECK(GetRenderStats().draw_calls == 3);
+  CHECK(GetNullRenderStats().draw_calls == 3);
+  CHECK(GetNullRenderStats().state_changes == GetRenderStats().binds_issued);
+  const auto draws = GetRecordedDraws();
+  REQUIRE(draws.size() == 3);
+  CHECK(draws[0].count == 6);
+  CHECK(draws[0].texture == second_texture.GetID().Get());
+  CHECK(draws[1].texture == first_texture.GetID().Get());
+  CHECK(draws[0].vertex_array != draws[1].vertex_array);
+  CHECK(draws[1].vertex_array == draws[2].vertex_array);
+  first_texture.Destroy();
+  second_texture.Destroy();
+}
+
+TEST_CASE("Texture uploads put back the unpack alignment they found")
+{
+  REQUIRE(LoadNullRenderBackend().Good());
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 2);
+  const ImageInfo info{ 3, 1, 3 };
+  const std::vector<unsigned char> pixels(info.Size(), 0);
+  Texture2D texture;
+  REQUIRE(texture.Initialise(info, pixels.data(), "odd").Good());
+  GLint alignment = 0;
+  glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+  CHECK(alignment == 2);
+
+  TextureArray array;
+  REQUIRE(array.Initialise({ 3, 1, 3 }, 2).Good());
+  REQUIRE(array.Upload(1, pixels.data()).Good());
+  glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+  CHECK(alignment == 2);
+  array.Destroy();
+  texture.Destroy();
+}
+
+// NOLINTEND
@@ -0,0 +1,151 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "evie/profiler.h"
+
+// NOLINTBEGIN
+
+// Zones are made directly rather than through the EV_PROFILE macros, which are empty when Evie_ENABLE_PROFILING is off.
+
+using namespace evie;
+
+namespace {
+struct ProfiledType
+{
+  virtual ~ProfiledType() = default;
+};
+
+struct DerivedProfiledType : ProfiledType
+{
+};
+
+const ProfileEvent* FindEvent(const std::vector<ProfileEvent>& events, const std::string& name)
+{
+  const auto it = std::find_if(events.begin(), events.end(), [&name](const ProfileEvent& event) {
+    return !event.type_name && name == event.name;
+  });
+  return it == events.end() ? nullptr : &*it;
+}
+
+// Each test starts from an empty capture.
+struct Capture
+{
+  Capture()
+  {
+    Profiler::Get().Clear();
+    Profiler::Get().BeginCapture();
+  }
+  ~Capture()
+  {
+    Profiler::Get().EndCapture();
+    Profiler::Get().Clear();
+  }
+};
+}// namespace
+
+TEST_CASE("Nothing is recorded outside a capture")
+{
+  Profiler::Get().EndCapture();
+  Profiler::Get().Clear();
+  {
+    const ProfileScope zone("Ignored");
+  }
+  CHECK(Profiler::Get().GetEvents().empty());
+}
+
+TEST_CASE("Nested zones record their depth and contain each other")
+{
+  const Capture capture;
+  {
+    const ProfileScope outer("Outer");
+    {
+      const ProfileScope inner("Inner");
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  const std::vector<ProfileEvent> events = Profiler::Get().GetEvents();
+  REQUIRE(events.size() == 2);
+  const ProfileEvent* outer = FindEvent(events, "Outer");
+  const ProfileEvent* inner = FindEvent(events, "Inner");
+  REQUIRE(outer != nullptr);
+  REQUIRE(inner != nullptr);
+  CHECK(outer->depth == 0);
+  CHECK(inner->depth == 1);
+  CHECK(inner->duration_ns >= 1'000'000);
+  CHECK(outer->start_ns <= inner->start_ns);
+  CHECK(outer->start_ns + outer->duration_ns >= inner->start_ns + inner->duration_ns);
+}
+
+TEST_CASE("Zones from other threads get their own thread id")
+{
+  const Capture capture;
+  {
+    const ProfileScope zone("Main");
+  }
+  std::thread worker([] {
+    Profiler::Get().SetThreadName("Worker");
+    const ProfileScope zone("Work");
+  });
+  worker.join();
+
+  const std::vector<ProfileEvent> events = Profiler::Get().GetEvents();
+  const ProfileEvent* main = FindEvent(events, "Main");
+  const ProfileEvent* work = FindEvent(events, "Work");
+  REQUIRE(main != nullptr);
+  REQUIRE(work != nullptr);
+  CHECK(main->thread != work->thread);
+
+  std::ostringstream trace;
+  Profiler::Get().WriteChromeTrace(trace);
+  CHECK(trace.str().find(R"("args":{"name":"Worker"})") != std::string::npos);
+}
+
+TEST_CASE("A full ring drops new events rather than overwriting")
+{
+  ProfileEventRing ring(3);
+  REQUIRE(ring.Capacity() == 4);
+  for (uint64_t i = 0; i < 4; ++i) {
+    CHECK(ring.Push(ProfileEvent{ .start_ns = i }));
+  }
+  CHECK_FALSE(ring.Push(ProfileEvent{ .start_ns = 4 }));
+
+  std::vector<ProfileEvent> events;
+  ring.Drain(events);
+  REQUIRE(events.size() == 4);
+  CHECK(events.front().start_ns == 0);
+  CHECK(events.back().start_ns == 3);
+
+  // Draining frees the slots again.
+  CHECK(ring.Push(ProfileEvent{ .start_ns = 5 }));
+  events.clear();
+  ring.Drain(events);
+  REQUIRE(events.size() == 1);
+  CHECK(events[0].start_ns == 5);
+}
+
+TEST_CASE("Chrome traces contain escaped names and readable type names")
+{
+  const Capture capture;
+  {
+    const ProfileScope zone("Quote \" and backslash \\");
+    const DerivedProfiledType derived;
+    const ProfiledType& base = derived;
+    const ProfileScope type_zone(typeid(base));
+  }
+
+  std::ostringstream trace;
+  Profiler::Get().WriteChromeTrace(trace);
+  const std::string json = trace.str();
+  CHECK(json.starts_with(R"({"displayTimeUnit":"ms","traceEvents":[)"));
+  CHECK(json.find(R"("name":"Quote \" and backslash \\")") != std::string::npos);
+  // The dynamic type, not the static one.
+  CHECK(json.find("DerivedProfiledType") != std::string::npos);
+  CHECK(json.find(R"("ph":"X")") != std::string::npos);
+}
+
+// NOLINTEND
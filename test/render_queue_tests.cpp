@@ -0,0 +1,181 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "evie/ids.h"
+#include "evie/render_queue.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+namespace {
+// Never initialised, so it has no ID and every command using it sorts as shader program 0.
+ShaderProgram program;
+}// namespace
+
+TEST_CASE("Sort key orders by shader program, then texture, then vertex array, then instancing, then depth")
+{
+  REQUIRE(RenderQueue::MakeSortKey(1, 0, 0, false, 0.0F) > RenderQueue::MakeSortKey(0, 9, 9, true, 1.0F));
+  REQUIRE(RenderQueue::MakeSortKey(1, 1, 0, false, 0.0F) > RenderQueue::MakeSortKey(1, 0, 9, true, 1.0F));
+  REQUIRE(RenderQueue::MakeSortKey(1, 1, 1, false, 0.0F) > RenderQueue::MakeSortKey(1, 1, 0, true, 1.0F));
+  REQUIRE(RenderQueue::MakeSortKey(1, 1, 1, true, 0.0F) > RenderQueue::MakeSortKey(1, 1, 1, false, 1.0F));
+  REQUIRE(RenderQueue::MakeSortKey(1, 1, 1, false, 0.5F) > RenderQueue::MakeSortKey(1, 1, 1, false, 0.25F));
+  // Depth is clamped into range rather than overflowing into the instanced bit.
+  REQUIRE(RenderQueue::MakeSortKey(1, 1, 1, false, 2.0F) == RenderQueue::MakeSortKey(1, 1, 1, false, 1.0F));
+  REQUIRE(RenderQueue::MakeSortKey(1, 1, 1, false, -1.0F) == RenderQueue::MakeSortKey(1, 1, 1, false, 0.0F));
+}
+
+TEST_CASE("Sort matches a stable sort of the keys")
+{
+  RenderQueue queue;
+  std::mt19937 generator(1234);
+  std::uniform_int_distribution<uint32_t> vertex_arrays(1, 300);
+  std::uniform_real_distribution<float> depths(0.0F, 1.0F);
+  std::vector<uint64_t> expected;
+  for (int i = 0; i < 1000; ++i) {
+    DrawCommand command;
+    command.shader_program = &program;
+    command.vertex_array = VertexArrayID(vertex_arrays(generator));
+    command.depth = depths(generator);
+    command.vertex_count = i;
+    queue.Submit(command);
+    expected.push_back(RenderQueue::MakeSortKey(0, 0, command.vertex_array.Get(), false, command.depth));
+  }
+  std::stable_sort(expected.begin(), expected.end());
+
+  queue.Sort();
+  REQUIRE_EQ(queue.Size(), expected.size());
+  for (size_t i = 0; i < queue.Size(); ++i) {
+    REQUIRE_EQ(queue.GetSortKey(i), expected[i]);
+    REQUIRE_EQ(queue.GetCommand(i).vertex_array.Get() & 0xFFFF, (expected[i] >> 16) & 0xFFFF);
+  }
+  // Equal keys keep their submission order.
+  for (size_t i = 1; i < queue.Size(); ++i) {
+    if (queue.GetSortKey(i) == queue.GetSortKey(i - 1)) {
+      REQUIRE(queue.GetCommand(i).vertex_count > queue.GetCommand(i - 1).vertex_count);
+    }
+  }
+}
+
+TEST_CASE("Sorting reduces state changes")
+{
+  RenderQueue queue;
+  // Interleave two meshes so that every draw would need a new vertex array bound.
+  for (int i = 0; i < 10; ++i) {
+    DrawCommand command;
+    command.shader_program = &program;
+    command.vertex_array = VertexArrayID(i % 2 == 0 ? 1U : 2U);
+    command.depth = static_cast<float>(i) / 10.0F;
+    queue.Submit(command);
+  }
+  REQUIRE_EQ(queue.CountStateChanges().vertex_arrays, 10);
+  queue.Sort();
+  const RenderStateChanges changes = queue.CountStateChanges();
+  REQUIRE_EQ(changes.vertex_arrays, 2);
+  REQUIRE_EQ(changes.shader_programs, 1);
+  REQUIRE_EQ(changes.textures, 0);
+  REQUIRE_EQ(changes.Total(), 3);
+  REQUIRE_EQ(changes.draw_calls, 10);
+
+  // Within the same state draws are front to back.
+  for (size_t i = 1; i < 5; ++i) {
+    REQUIRE(queue.GetCommand(i).depth > queue.GetCommand(i - 1).depth);
+  }
+
+  SUBCASE("Clear empties the queue")
+  {
+    queue.Clear();
+    queue.Sort();
+    REQUIRE_EQ(queue.Size(), 0);
+    REQUIRE_EQ(queue.CountStateChanges().Total(), 0);
+  }
+}
+
+TEST_CASE("Instanced commands with the same state share a draw call")
+{
+  RenderQueue queue;
+  for (int i = 0; i < 8; ++i) {
+    DrawCommand command;
+    command.shader_program = &program;
+    // Six instances of one mesh and two draws of a non instanced mesh.
+    command.instanced = i < 6;
+    command.vertex_array = VertexArrayID(command.instanced ? 1U : 2U);
+    command.depth = static_cast<float>(8 - i) / 10.0F;
+    queue.Submit(command);
+  }
+  queue.Sort();
+  const RenderStateChanges changes = queue.CountStateChanges();
+  REQUIRE_EQ(changes.draw_calls, 3);
+  REQUIRE_EQ(changes.vertex_arrays, 2);
+
+  SUBCASE("A different vertex array splits the batch")
+  {
+    DrawCommand command;
+    command.shader_program = &program;
+    command.instanced = true;
+    command.vertex_array = VertexArrayID(3U);
+    queue.Submit(command);
+    queue.Sort();
+    REQUIRE_EQ(queue.CountStateChanges().draw_calls, 4);
+  }
+}
+
+TEST_CASE("Depth doesn't interleave instanced and non instanced draws of the same mesh")
+{
+  RenderQueue queue;
+  for (int i = 0; i < 8; ++i) {
+    DrawCommand command;
+    command.shader_program = &program;
+    // Alternate so that sorting on depth alone would split the instances into four batches.
+    command.instanced = i % 2 == 0;
+    command.vertex_array = VertexArrayID(1U);
+    command.depth = static_cast<float>(i) / 10.0F;
+    queue.Submit(command);
+  }
+  queue.Sort();
+  REQUIRE_EQ(queue.CountStateChanges().draw_calls, 5);
+  for (size_t i = 0; i < queue.Size(); ++i) {
+    REQUIRE_EQ(queue.GetCommand(i).instanced, i >= 4);
+  }
+}
+
+TEST_CASE("Instanced commands using different layers of a texture array share a draw call")
+{
+  RenderQueue queue;
+  TextureArray array;
+  for (uint32_t i = 0; i < 4; ++i) {
+    DrawCommand command;
+    command.shader_program = &program;
+    command.instanced = true;
+    command.vertex_array = VertexArrayID(1U);
+    command.texture_array = &array;
+    command.texture_layer = i;
+    queue.Submit(command);
+  }
+  queue.Sort();
+  const RenderStateChanges changes = queue.CountStateChanges();
+  REQUIRE_EQ(changes.draw_calls, 1);
+  REQUIRE_EQ(changes.textures, 1);
+  // Each command keeps its own layer.
+  for (size_t i = 0; i < queue.Size(); ++i) {
+    REQUIRE_EQ(queue.GetCommand(i).texture_layer, i);
+  }
+}
+
+TEST_CASE("Commands without a shader program are dropped")
+{
+  RenderQueue queue;
+  DrawCommand command;
+  queue.Submit(command);
+  REQUIRE_EQ(queue.Size(), 0);
+
+  command.shader_program = &program;
+  queue.Submit(command);
+  REQUIRE_EQ(queue.Size(), 1);
+}
+
+// NOLINTEND
@@ -0,0 +1,105 @@
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "evie/render_thread.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+namespace {
+DrawCommand CommandWithCount(int count)
+{
+  DrawCommand command;
+  command.vertex_count = count;
+  return command;
+}
+}// namespace
+
+TEST_CASE("Recorded frames are rendered in order")
+{
+  std::vector<int> rendered;
+  std::thread::id render_thread_id;
+  RenderThread render_thread;
+  render_thread.Start(
+    [&] { render_thread_id = std::this_thread::get_id(); },
+    [&](CommandList& commands) {
+      for (const auto& command : commands.draws) {
+        rendered.push_back(command.vertex_count);
+      }
+    },
+    {});
+  for (int frame = 0; frame < 5; ++frame) {
+    CommandList& commands = render_thread.GetRecordingList();
+    // Lists are handed back empty.
+    REQUIRE(commands.draws.empty());
+    commands.Submit(CommandWithCount(frame));
+    commands.Submit(CommandWithCount(frame * 10));
+    render_thread.Submit();
+  }
+  render_thread.Stop();
+  REQUIRE_EQ(render_thread.GetFramesRendered(), 5);
+  REQUIRE(rendered == std::vector<int>{ 0, 0, 1, 10, 2, 20, 3, 30, 4, 40 });
+  REQUIRE(render_thread_id != std::this_thread::get_id());
+}
+
+TEST_CASE("Submit returns while the frame is still rendering")
+{
+  std::atomic<bool> recording_next{ false };
+  std::atomic<bool> overlapped{ false };
+  RenderThread render_thread;
+  render_thread.Start(
+    {},
+    [&](CommandList&) {
+      // Wait for the simulation thread to get on with the next frame, giving up rather than hanging the test.
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (!recording_next && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+      }
+      overlapped = recording_next.load();
+    },
+    {});
+  render_thread.Submit();
+  render_thread.GetRecordingList().Submit(CommandWithCount(1));
+  recording_next = true;
+  render_thread.Stop();
+  REQUIRE(overlapped);
+}
+
+TEST_CASE("Synchronised work runs on the render thread between frames")
+{
+  std::atomic<bool> rendering{ false };
+  std::atomic<int> overlaps{ 0 };
+  std::atomic<int> synchronised_count{ 0 };
+  std::thread::id render_thread_id;
+  std::thread::id synchronised_id;
+  RenderThread render_thread;
+  render_thread.Start(
+    [&] { render_thread_id = std::this_thread::get_id(); },
+    [&](CommandList&) {
+      rendering = true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      rendering = false;
+    },
+    {});
+  const std::function<void()> synchronised = [&] {
+    synchronised_id = std::this_thread::get_id();
+    if (rendering) {
+      ++overlaps;
+    }
+    ++synchronised_count;
+  };
+  for (int frame = 0; frame < 10; ++frame) {
+    render_thread.Submit(synchronised);
+  }
+  render_thread.Stop();
+  REQUIRE_EQ(synchronised_count, 10);
+  REQUIRE_EQ(overlaps, 0);
+  REQUIRE(synchronised_id == render_thread_id);
+}
+
+// NOLINTEND
@@ -0,0 +1,193 @@
+#include <doctest/doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "evie/async_texture_loader.h"
+#include "evie/ecs/component_array.hpp"
+#include "evie/error.h"
+#include "evie/ids.h"
+#include "evie/null_render_backend.h"
+#include "evie/resource_manager.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+namespace {
+struct TestResource
+{
+  int value{ 0 };
+};
+
+// Records the values that have been destroyed.
+struct Destroyer
+{
+  std::vector<int>* destroyed;
+  void operator()(TestResource& resource) const { destroyed->push_back(resource.value); }
+};
+}// namespace
+
+TEST_CASE("Resources are shared by key")
+{
+  ResourcePool<TestResource> pool;
+  int creates = 0;
+  auto create = [&](TestResource& resource) {
+    resource.value = ++creates;
+    return Error::OK();
+  };
+
+  Result<ResourceHandle<TestResource>> first = pool.Acquire("cube", create);
+  REQUIRE(first.Good());
+  Result<ResourceHandle<TestResource>> second = pool.Acquire("cube", create);
+  REQUIRE(second.Good());
+  REQUIRE_EQ(creates, 1);
+  REQUIRE(*first == *second);
+  REQUIRE_EQ((*second)->value, 1);
+  REQUIRE_EQ(pool.RefCount(*first), 2);
+
+  // Copies are only a count.
+  std::vector<ResourceHandle<TestResource>> copies(10, *first);
+  REQUIRE_EQ(pool.RefCount(*first), 12);
+  copies.clear();
+  REQUIRE_EQ(pool.RefCount(*first), 2);
+
+  REQUIRE(pool.Acquire("sphere", create).Good());
+  REQUIRE_EQ(creates, 2);
+  REQUIRE(pool.Find("cube").Valid());
+  REQUIRE_FALSE(pool.Find("plane").Valid());
+}
+
+TEST_CASE("Resources are destroyed by Collect once unreferenced")
+{
+  ResourcePool<TestResource> pool;
+  std::vector<int> destroyed;
+  auto create = [](TestResource& resource) {
+    resource.value = 7;
+    return Error::OK();
+  };
+
+  Result<ResourceHandle<TestResource>> handle = pool.Acquire("cube", create);
+  REQUIRE(handle.Good());
+  ResourceHandle<TestResource> copy = *handle;
+  handle->Reset();
+  REQUIRE_EQ(pool.Collect(Destroyer{ &destroyed }), 0);
+  REQUIRE(copy.Valid());
+
+  // Dropping the last handle only queues the resource.
+  copy.Reset();
+  REQUIRE_EQ(pool.Size(), 1);
+  REQUIRE(destroyed.empty());
+
+  SUBCASE("Acquiring again before Collect reuses it")
+  {
+    int creates = 0;
+    Result<ResourceHandle<TestResource>> again = pool.Acquire("cube", [&](TestResource&) {
+      ++creates;
+      return Error::OK();
+    });
+    REQUIRE(again.Good());
+    REQUIRE_EQ(pool.Collect(Destroyer{ &destroyed }), 0);
+    REQUIRE_EQ(creates, 0);
+    REQUIRE_EQ((*again)->value, 7);
+  }
+
+  SUBCASE("Collect destroys it")
+  {
+    REQUIRE_EQ(pool.Collect(Destroyer{ &destroyed }), 1);
+    REQUIRE_EQ(destroyed, std::vector<int>{ 7 });
+    REQUIRE_EQ(pool.Size(), 0);
+    REQUIRE_FALSE(pool.Find("cube").Valid());
+    // Queued once is destroyed once.
+    REQUIRE_EQ(pool.Collect(Destroyer{ &destroyed }), 0);
+  }
+}
+
+TEST_CASE("Failed creation doesn't add a resource")
+{
+  ResourcePool<TestResource> pool;
+  Result<ResourceHandle<TestResource>> handle =
+    pool.Acquire("missing.png", [](TestResource&) { return Error{ "File doesn't exist" }; });
+  REQUIRE(handle.Bad());
+  REQUIRE_EQ(pool.Size(), 0);
+  REQUIRE_FALSE(pool.Find("missing.png").Valid());
+}
+
+TEST_CASE("Clear invalidates outstanding handles")
+{
+  ResourcePool<TestResource> pool;
+  std::vector<int> destroyed;
+  Result<ResourceHandle<TestResource>> handle = pool.Acquire("cube", [](TestResource&) { return Error::OK(); });
+  REQUIRE(handle.Good());
+  pool.Clear(Destroyer{ &destroyed });
+  REQUIRE_EQ(destroyed.size(), 1);
+  REQUIRE_FALSE(handle->Valid());
+  // Releasing a handle to a cleared resource does nothing.
+  handle->Reset();
+  REQUIRE_EQ(pool.Collect(Destroyer{ &destroyed }), 0);
+}
+
+TEST_CASE("Removing a component releases its handles")
+{
+  struct HandleComponent
+  {
+    ResourceHandle<TestResource> resource;
+  };
+  ResourcePool<TestResource> pool;
+  Result<ResourceHandle<TestResource>> handle = pool.Acquire("cube", [](TestResource&) { return Error::OK(); });
+  REQUIRE(handle.Good());
+
+  ComponentArray<HandleComponent> components(ComponentID<HandleComponent>(0));
+  for (uint64_t i = 1; i <= 3; ++i) {
+    components.AddComponent(EntityID(i), { *handle });
+  }
+  REQUIRE_EQ(pool.RefCount(*handle), 4);
+  components.RemoveComponent(EntityID(1));
+  components.RemoveComponent(EntityID(3));
+  REQUIRE_EQ(pool.RefCount(*handle), 2);
+}
+
+TEST_CASE("Loading a shader program leaves no shader objects behind")
+{
+  REQUIRE(LoadNullRenderBackend().Good());
+  const auto vertex_path = std::filesystem::temp_directory_path() / "evie_resource_manager.vs";
+  std::ofstream(vertex_path) << "#version 330 core\nvoid main() {}\n";
+  const NullRenderStats& stats = GetNullRenderStats();
+  ResourceManager resources;
+
+  SUBCASE("Linked programs only keep the program")
+  {
+    REQUIRE(resources.LoadShaderProgram(vertex_path.string(), vertex_path.string()).Good());
+    CHECK(stats.objects_created == 3);
+    CHECK(stats.objects_deleted == 2);
+  }
+
+  SUBCASE("A shader that fails to load doesn't leak the one that compiled")
+  {
+    REQUIRE(resources.LoadShaderProgram(vertex_path.string(), "missing.fs").Bad());
+    CHECK(stats.objects_created == 1);
+    CHECK(stats.objects_deleted == 1);
+  }
+  resources.Destroy();
+  CHECK(stats.objects_created == stats.objects_deleted);
+}
+
+TEST_CASE("A loader without workers decodes on the calling thread")
+{
+  AsyncTextureLoader loader;
+  bool loaded = false;
+  bool failed = false;
+  loader.Load("missing.png", false, TextureWrapping::Repeat, [&](Result<Texture2D> texture) {
+    loaded = true;
+    failed = texture.Bad();
+  });
+  CHECK(loader.GetPendingCount() == 1);
+  CHECK(loader.Update() == 1);
+  CHECK(loaded);
+  CHECK(failed);
+  CHECK(loader.GetPendingCount() == 0);
+}
+
+// NOLINTEND
@@ -0,0 +1,41 @@
+#include <doctest/doctest.h>
+
+#include "evie/stream_buffer.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+TEST_CASE("Allocations are bump allocated within a region")
+{
+  StreamRingAllocator ring(256, 3);
+  REQUIRE_EQ(ring.Allocate(10).value(), 0);
+  // Aligned up from 10.
+  REQUIRE_EQ(ring.Allocate(16, 16).value(), 16);
+  REQUIRE_EQ(ring.Used(), 32);
+
+  SUBCASE("A full region refuses the allocation")
+  {
+    REQUIRE_FALSE(ring.Allocate(225).has_value());
+    // The failed allocation doesn't use anything.
+    REQUIRE_EQ(ring.Used(), 32);
+    REQUIRE_EQ(ring.Allocate(224).value(), 32);
+  }
+}
+
+TEST_CASE("Each frame writes to the next region and wraps around")
+{
+  StreamRingAllocator ring(256, 3);
+  REQUIRE_EQ(ring.Allocate(8).value(), 0);
+  ring.NextRegion();
+  REQUIRE_EQ(ring.CurrentRegion(), 1);
+  REQUIRE_EQ(ring.Used(), 0);
+  REQUIRE_EQ(ring.Allocate(8).value(), 256);
+  ring.NextRegion();
+  REQUIRE_EQ(ring.Allocate(8).value(), 512);
+  ring.NextRegion();
+  REQUIRE_EQ(ring.CurrentRegion(), 0);
+  REQUIRE_EQ(ring.Allocate(8).value(), 0);
+}
+
+// NOLINTEND
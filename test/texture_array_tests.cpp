@@ -0,0 +1,94 @@
+#include <doctest/doctest.h>
+
+#include <string>
+#include <vector>
+
+#include "evie/null_render_backend.h"
+#include "evie/texture_array.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+TEST_CASE("Layers of the same format share an array until it's full")
+{
+  TextureLayerAllocator allocator(2);
+  const TextureArrayFormat format{ 64, 64, 4 };
+
+  auto first = allocator.Allocate(format);
+  REQUIRE(first.new_array);
+  REQUIRE_EQ(first.array, 0);
+  REQUIRE_EQ(first.layer, 0);
+
+  auto second = allocator.Allocate(format);
+  REQUIRE_FALSE(second.new_array);
+  REQUIRE_EQ(second.array, 0);
+  REQUIRE_EQ(second.layer, 1);
+
+  auto third = allocator.Allocate(format);
+  REQUIRE(third.new_array);
+  REQUIRE_EQ(third.array, 1);
+  REQUIRE_EQ(third.layer, 0);
+  REQUIRE_EQ(allocator.GetArrayCount(), 2);
+
+  SUBCASE("A freed layer is reused before anything new")
+  {
+    allocator.Free(0, 1);
+    auto reused = allocator.Allocate(format);
+    REQUIRE_FALSE(reused.new_array);
+    REQUIRE_EQ(reused.array, 0);
+    REQUIRE_EQ(reused.layer, 1);
+    REQUIRE_EQ(allocator.GetArrayCount(), 2);
+  }
+}
+
+TEST_CASE("Different formats never share an array")
+{
+  TextureLayerAllocator allocator(4);
+  REQUIRE(allocator.Allocate({ 64, 64, 4 }).new_array);
+  REQUIRE(allocator.Allocate({ 64, 64, 3 }).new_array);
+  REQUIRE(allocator.Allocate({ 128, 64, 4 }).new_array);
+  auto same = allocator.Allocate({ 64, 64, 3 });
+  REQUIRE_FALSE(same.new_array);
+  REQUIRE_EQ(same.array, 1);
+  REQUIRE_EQ(allocator.GetUsedLayers(1), 2);
+}
+
+TEST_CASE("A texture array that fails to initialise is retried by the next texture")
+{
+  REQUIRE(LoadNullRenderBackend().Good());
+  // More layers than the null backend allows, so every Initialise fails.
+  TextureArrayManager manager(4096);
+  const ImageInfo info{ 2, 2, 4 };
+  const std::vector<unsigned char> pixels(info.Size(), 0);
+
+  auto first = manager.Add(info, pixels.data());
+  REQUIRE(first.Bad());
+  // The second add reuses the first's array and layer, it mustn't upload into the uninitialised array.
+  auto second = manager.Add(info, pixels.data());
+  REQUIRE(second.Bad());
+  CHECK(std::string(second.Error().Message()) == std::string(first.Error().Message()));
+  CHECK(manager.GetArrayCount() == 1);
+  CHECK(GetNullRenderStats().objects_created == 0);
+  manager.Destroy();
+}
+
+TEST_CASE("Textures of the same format share an array")
+{
+  REQUIRE(LoadNullRenderBackend().Good());
+  TextureArrayManager manager(2);
+  const ImageInfo info{ 2, 2, 4 };
+  const std::vector<unsigned char> pixels(info.Size(), 0);
+
+  auto first = manager.Add(info, pixels.data());
+  auto second = manager.Add(info, pixels.data());
+  REQUIRE(first.Good());
+  REQUIRE(second.Good());
+  CHECK(first->array == second->array);
+  CHECK(first->layer != second->layer);
+  CHECK(manager.GetArrayCount() == 1);
+  CHECK(GetNullRenderStats().objects_created == 1);
+  manager.Destroy();
+}
+
+// NOLINTEND
@@ -0,0 +1,110 @@
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "evie/thread_pool.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+TEST_CASE("Every submitted job runs")
+{
+  ThreadPool pool(4);
+  CHECK(pool.WorkerCount() == 4);
+  std::atomic<int> count{ 0 };
+  for (int i = 0; i < 100; ++i) {
+    pool.Submit([&count] { ++count; });
+  }
+  pool.Wait();
+  CHECK(count == 100);
+}
+
+TEST_CASE("A single worker runs jobs in submission order")
+{
+  ThreadPool pool(1);
+  std::mutex mutex;
+  std::vector<int> order;
+  for (int i = 0; i < 10; ++i) {
+    pool.Submit([&, i] {
+      const std::scoped_lock lock(mutex);
+      order.push_back(i);
+    });
+  }
+  pool.Wait();
+  REQUIRE(order.size() == 10);
+  for (int i = 0; i < 10; ++i) {
+    CHECK(order[i] == i);
+  }
+}
+
+TEST_CASE("Wait returns straight away with nothing submitted")
+{
+  ThreadPool pool(2);
+  pool.Wait();
+  CHECK(pool.WorkerCount() == 2);
+}
+
+TEST_CASE("There is always at least one worker")
+{
+  ThreadPool pool(0);
+  CHECK(pool.WorkerCount() == 1);
+  CHECK(ThreadPool::DefaultWorkerCount() >= 1);
+}
+
+TEST_CASE("A task group only waits for its own jobs")
+{
+  ThreadPool pool(1);
+  std::atomic<bool> release{ false };
+  // Keeps the only worker busy until the group is done.
+  pool.Submit([&release] {
+    while (!release) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  std::atomic<int> count{ 0 };
+  {
+    TaskGroup group(&pool);
+    for (int i = 0; i < 10; ++i) {
+      group.Submit([&count] { ++count; });
+    }
+    group.Wait();
+    CHECK(count == 10);
+  }
+  release = true;
+  pool.Wait();
+  CHECK(count == 10);
+}
+
+TEST_CASE("A task group can be waited on from one of the pool's workers")
+{
+  ThreadPool pool(1);
+  std::atomic<int> count{ 0 };
+  pool.Submit([&] {
+    TaskGroup group(&pool);
+    for (int i = 0; i < 5; ++i) {
+      group.Submit([&count] { ++count; });
+    }
+    group.Wait();
+  });
+  pool.Wait();
+  CHECK(count == 5);
+}
+
+TEST_CASE("A task group without a pool runs its jobs when waited on")
+{
+  std::vector<int> order;
+  TaskGroup group(nullptr);
+  for (int i = 0; i < 3; ++i) {
+    group.Submit([&order, i] { order.push_back(i); });
+  }
+  CHECK(order.empty());
+  group.Wait();
+  CHECK(order == std::vector<int>{ 0, 1, 2 });
+}
+
+// NOLINTEND
@@ -0,0 +1,108 @@
+#include <doctest/doctest.h>
+
+#include <cstddef>
+
+#include "evie/uniform_blocks.h"
+#include "evie/uniform_buffer.h"
+
+// NOLINTBEGIN
+
+using namespace evie;
+
+namespace {
+// Lay out the GLSL light structs member by member, returning the offset of the struct.
+size_t AddDirectionalLight(Std140Layout& layout)
+{
+  const size_t offset = layout.BeginStruct();
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3) - offset, offsetof(DirectionalLightData, direction));
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3) - offset, offsetof(DirectionalLightData, ambient));
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3) - offset, offsetof(DirectionalLightData, diffuse));
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3) - offset, offsetof(DirectionalLightData, specular));
+  layout.EndStruct();
+  return offset;
+}
+
+size_t AddPointLight(Std140Layout& layout)
+{
+  const size_t offset = layout.BeginStruct();
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3) - offset, offsetof(PointLightData, position));
+  REQUIRE_EQ(layout.Add(Std140Type::Float) - offset, offsetof(PointLightData, constant));
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3) - offset, offsetof(PointLightData, ambient));
+  REQUIRE_EQ(layout.Add(Std140Type::Float) - offset, offsetof(PointLightData, linear));
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3) - offset, offsetof(PointLightData, diffuse));
+  REQUIRE_EQ(layout.Add(Std140Type::Float) - offset, offsetof(PointLightData, quadratic));
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3) - offset, offsetof(PointLightData, specular));
+  layout.EndStruct();
+  return offset;
+}
+
+size_t AddSpotLight(Std140Layout& layout)
+{
+  const size_t offset = layout.BeginStruct();
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3) - offset, offsetof(SpotLightData, position));
+  REQUIRE_EQ(layout.Add(Std140Type::Float) - offset, offsetof(SpotLightData, cut_off));
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3) - offset, offsetof(SpotLightData, direction));
+  REQUIRE_EQ(layout.Add(Std140Type::Float) - offset, offsetof(SpotLightData, outer_cut_off));
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3) - offset, offsetof(SpotLightData, ambient));
+  REQUIRE_EQ(layout.Add(Std140Type::Float) - offset, offsetof(SpotLightData, constant));
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3) - offset, offsetof(SpotLightData, diffuse));
+  REQUIRE_EQ(layout.Add(Std140Type::Float) - offset, offsetof(SpotLightData, linear));
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3) - offset, offsetof(SpotLightData, specular));
+  REQUIRE_EQ(layout.Add(Std140Type::Float) - offset, offsetof(SpotLightData, quadratic));
+  layout.EndStruct();
+  return offset;
+}
+}// namespace
+
+TEST_CASE("Std140 alignment rules")
+{
+  Std140Layout layout;
+  REQUIRE_EQ(layout.Add(Std140Type::Float), 0);
+  // vec2 aligns to 8 bytes.
+  REQUIRE_EQ(layout.Add(Std140Type::Vec2), 8);
+  // vec3 aligns to 16 bytes.
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3), 16);
+  // A scalar after a vec3 packs into its padding.
+  REQUIRE_EQ(layout.Add(Std140Type::Float), 28);
+  REQUIRE_EQ(layout.Add(Std140Type::Mat4), 32);
+  REQUIRE_EQ(layout.Add(Std140Type::Int), 96);
+  // Array elements are aligned and strided to a vec4 even for scalars.
+  REQUIRE_EQ(layout.Add(Std140Type::Float, 3), 112);
+  REQUIRE_EQ(layout.Add(Std140Type::Float), 160);
+  REQUIRE_EQ(layout.Size(), 176);
+
+  SUBCASE("Structs are aligned and padded to a vec4")
+  {
+    const size_t offset = layout.BeginStruct();
+    REQUIRE_EQ(offset, 176);
+    REQUIRE_EQ(layout.Add(Std140Type::Float), 176);
+    layout.EndStruct();
+    REQUIRE_EQ(layout.Add(Std140Type::Float), 192);
+  }
+}
+
+TEST_CASE("Frame block matches its std140 layout")
+{
+  Std140Layout layout;
+  REQUIRE_EQ(layout.Add(Std140Type::Mat4), offsetof(FrameBlock, view));
+  REQUIRE_EQ(layout.Add(Std140Type::Mat4), offsetof(FrameBlock, projection));
+  REQUIRE_EQ(layout.Add(Std140Type::Mat4), offsetof(FrameBlock, inverse_transpose_view));
+  REQUIRE_EQ(layout.Add(Std140Type::Vec3), offsetof(FrameBlock, view_position));
+  REQUIRE_EQ(layout.Add(Std140Type::Float), offsetof(FrameBlock, time));
+  REQUIRE_EQ(layout.Size(), sizeof(FrameBlock));
+}
+
+TEST_CASE("Lights block matches its std140 layout")
+{
+  Std140Layout layout;
+  REQUIRE_EQ(AddDirectionalLight(layout), offsetof(LightsBlock, directional_light));
+  REQUIRE_EQ(sizeof(DirectionalLightData), 64);
+  REQUIRE_EQ(AddPointLight(layout), offsetof(LightsBlock, point_lights));
+  for (size_t i = 1; i < MaxPointLights; ++i) {
+    REQUIRE_EQ(AddPointLight(layout), offsetof(LightsBlock, point_lights) + i * sizeof(PointLightData));
+  }
+  REQUIRE_EQ(AddSpotLight(layout), offsetof(LightsBlock, spot_light));
+  REQUIRE_EQ(layout.Size(), sizeof(LightsBlock));
+}
+
+// NOLINTEND
@@ -0,0 +1,70 @@
+// Converts a model Assimp can import into a baked mesh, so loading it at runtime needs no Assimp.
+//
+// Usage: mesh_baker [--no-optimise] <input model> <output.evmesh>
+//
+// Each submesh is deduplicated and reordered for the vertex cache, overdraw and vertex fetch unless --no-optimise is
+// given. Texture paths are kept relative, put the baked mesh next to the model's textures.
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "evie/baked_mesh.h"
+#include "evie/logging.h"
+#include "evie/mesh_optimiser.h"
+
+int main(int argc, char** argv)
+{
+  evie::LoggingManager::Init();
+  const std::vector<std::string> args(argv + 1, argv + argc);// NOLINT
+  bool optimise = true;
+  std::vector<std::string> paths;
+  for (const auto& arg : args) {
+    if (arg == "--no-optimise") {
+      optimise = false;
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  if (paths.size() != 2) {
+    APP_ERROR("Usage: mesh_baker [--no-optimise] <input model> <output{}>", evie::BakedMeshExtension);
+    return 1;
+  }
+  const std::string& input = paths[0];
+  const std::string& output = paths[1];
+
+  evie::Result<evie::MeshSource> source = evie::ImportMesh(input);
+  if (source.Bad()) {
+    APP_ERROR("Failed to import {}: {}", input, source.Error().Message());
+    return 1;
+  }
+  if (optimise) {
+    for (auto& submesh : source->submeshes) {
+      const float before = evie::AverageCacheMissRatio(submesh.indices, submesh.vertices.size());
+      evie::OptimiseMesh(submesh.vertices, submesh.indices);
+      APP_INFO("Submesh of {} vertices, cache misses per triangle {:.3f} -> {:.3f}",
+        submesh.vertices.size(),
+        before,
+        evie::AverageCacheMissRatio(submesh.indices, submesh.vertices.size()));
+    }
+  }
+  evie::Result<std::vector<unsigned char>> baked = evie::BakeMesh(*source);
+  if (baked.Bad()) {
+    APP_ERROR("Failed to bake {}: {}", input, baked.Error().Message());
+    return 1;
+  }
+
+  std::ofstream file(output, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(baked->data()), static_cast<std::streamsize>(baked->size()));// NOLINT
+  if (!file) {
+    APP_ERROR("Failed to write {}", output);
+    return 1;
+  }
+  APP_INFO("Baked {} ({} submeshes, {} materials) to {}, {} bytes",
+    input,
+    source->submeshes.size(),
+    source->materials.size(),
+    output,
+    baked->size());
+  return 0;
+}
@@ -0,0 +1,124 @@
+// Converts an image into a baked texture with its mip chain built in, optionally block compressed.
+//
+// Usage: texture_baker [--format rgb8|rgba8|bc1|bc3] [--flip] <input image> <output.evtex>
+//
+// Without --format, opaque images are baked as BC1 and images with alpha as BC3.
+
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "evie/baked_texture.h"
+#include "evie/logging.h"
+#include "evie/texture.h"
+
+namespace {
+
+struct Options
+{
+  std::optional<evie::BakedTextureFormat> format;
+  bool flip{ false };
+  std::string input;
+  std::string output;
+};
+
+std::optional<evie::BakedTextureFormat> ParseFormat(std::string_view name)
+{
+  if (name == "rgb8") {
+    return evie::BakedTextureFormat::RGB8;
+  }
+  if (name == "rgba8") {
+    return evie::BakedTextureFormat::RGBA8;
+  }
+  if (name == "bc1") {
+    return evie::BakedTextureFormat::BC1;
+  }
+  if (name == "bc3") {
+    return evie::BakedTextureFormat::BC3;
+  }
+  return std::nullopt;
+}
+
+std::optional<Options> ParseArguments(const std::vector<std::string_view>& args)
+{
+  Options options;
+  std::vector<std::string_view> paths;
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (args[i] == "--flip") {
+      options.flip = true;
+    } else if (args[i] == "--format" && i + 1 < args.size()) {
+      options.format = ParseFormat(args[++i]);
+      if (!options.format) {
+        return std::nullopt;
+      }
+    } else {
+      paths.push_back(args[i]);
+    }
+  }
+  if (paths.size() != 2) {
+    return std::nullopt;
+  }
+  options.input = paths[0];
+  options.output = paths[1];
+  return options;
+}
+
+bool HasAlpha(const evie::DecodedImage& image)
+{
+  if (image.info.channels != 2 && image.info.channels != 4) {
+    return false;
+  }
+  const size_t pixels = static_cast<size_t>(image.info.width) * static_cast<size_t>(image.info.height);
+  const auto channels = static_cast<size_t>(image.info.channels);
+  for (size_t i = 0; i < pixels; ++i) {
+    if (image.pixels.get()[i * channels + channels - 1] != 255) {// NOLINT
+      return true;
+    }
+  }
+  return false;
+}
+
+}// namespace
+
+int main(int argc, char** argv)
+{
+  evie::LoggingManager::Init();
+  const std::vector<std::string_view> args(argv + 1, argv + argc);// NOLINT
+  const std::optional<Options> options = ParseArguments(args);
+  if (!options) {
+    APP_ERROR("Usage: texture_baker [--format rgb8|rgba8|bc1|bc3] [--flip] <input image> <output{}>",
+      evie::BakedTextureExtension);
+    return 1;
+  }
+
+  evie::Result<evie::DecodedImage> image = evie::DecodeImage(options->input, options->flip);
+  if (image.Bad()) {
+    APP_ERROR("Failed to read {}: {}", options->input, image.Error().Message());
+    return 1;
+  }
+  const evie::BakedTextureFormat format =
+    options->format.value_or(HasAlpha(*image) ? evie::BakedTextureFormat::BC3 : evie::BakedTextureFormat::BC1);
+
+  evie::Result<std::vector<unsigned char>> baked =
+    evie::BakeTexture(image->info, image->pixels.get(), format, options->flip);
+  if (baked.Bad()) {
+    APP_ERROR("Failed to bake {}: {}", options->input, baked.Error().Message());
+    return 1;
+  }
+
+  std::ofstream file(options->output, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(baked->data()), static_cast<std::streamsize>(baked->size()));// NOLINT
+  if (!file) {
+    APP_ERROR("Failed to write {}", options->output);
+    return 1;
+  }
+  APP_INFO("Baked {} ({}x{}) to {}, {} bytes",
+    options->input,
+    image->info.width,
+    image->info.height,
+    options->output,
+    baked->size());
+  return 0;
+}